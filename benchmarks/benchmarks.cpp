@@ -0,0 +1,434 @@
+#include <bso/spatial_design/ms_building.hpp>
+#include <bso/spatial_design/cf_building.hpp>
+#include <bso/structural_design/sd_model.hpp>
+#include <bso/building_physics/bp_model.hpp>
+#include <bso/grammar/grammar.hpp>
+#include <bso/utilities/clustering.hpp>
+#include <bso/utilities/non_dominated_search.hpp>
+#include <bso/utilities/instrumentation.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Reproducible benchmark suite of the hot paths of the toolbox. Every case is
+// timed for a series of problem sizes, the results (and the scaling exponents
+// between consecutive sizes) are written to a JSON file.
+//
+// usage: ./benchmarks [--quick] [--data <directory>] [output file]
+// the data directory holds settings/sd_settings.txt, settings/bp_settings.txt
+// and the weather files referred to by the latter
+
+namespace benchmarks {
+
+namespace sd = bso::structural_design;
+namespace spt = bso::spatial_design;
+namespace geom = bso::utilities::geometry;
+
+const unsigned long SEED = 1;
+
+struct measurement
+{
+	unsigned int mSize;
+	std::vector<double> mTimes;
+	double mMin = 0.0;
+	double mMedian = 0.0;
+	double mMean = 0.0;
+	double mScalingExponent = 0.0; // w.r.t. the previous size: t ~ size^exponent
+	bool mHasScalingExponent = false;
+};
+
+struct benchmark_case
+{
+	std::string mName;
+	std::string mSizeMeasure;
+	std::vector<measurement> mMeasurements;
+	std::string mErrorMessage;
+};
+
+// a benchmark prepares its (untimed) input for a size and returns the timed part
+typedef std::function<std::function<void()>(const unsigned int&)> benchmark;
+
+benchmark_case run(const std::string& name, const std::string& sizeMeasure,
+	const std::vector<unsigned int>& sizes, const unsigned int& repetitions,
+	const benchmark& prepare)
+{
+	benchmark_case result;
+	result.mName = name;
+	result.mSizeMeasure = sizeMeasure;
+	std::cout << name << std::flush;
+	try
+	{
+		for (const auto& size : sizes)
+		{
+			measurement m;
+			m.mSize = size;
+			for (unsigned int i = 0; i < repetitions; ++i)
+			{
+				std::function<void()> timed = prepare(size);
+				double start = bso::utilities::wall_time();
+				timed();
+				m.mTimes.push_back(bso::utilities::wall_time() - start);
+			}
+			std::vector<double> sorted = m.mTimes;
+			std::sort(sorted.begin(), sorted.end());
+			m.mMin = sorted.front();
+			m.mMedian = (sorted.size() % 2 == 1)? sorted[sorted.size()/2] :
+				0.5*(sorted[sorted.size()/2 - 1] + sorted[sorted.size()/2]);
+			for (const auto& t : sorted) m.mMean += t/sorted.size();
+			if (!result.mMeasurements.empty())
+			{
+				const measurement& previous = result.mMeasurements.back();
+				if (previous.mMedian > 0.0 && m.mMedian > 0.0 && previous.mSize != size)
+				{
+					m.mScalingExponent = std::log(m.mMedian/previous.mMedian) /
+						std::log((double)size/previous.mSize);
+					m.mHasScalingExponent = true;
+				}
+			}
+			result.mMeasurements.push_back(m);
+			std::cout << " " << size << ":" << m.mMedian << "s" << std::flush;
+		}
+	}
+	catch (std::exception& e)
+	{ // a failing case is recorded and does not stop the suite
+		result.mErrorMessage = e.what();
+		std::cout << " failed" << std::flush;
+	}
+	std::cout << std::endl;
+	return result;
+} // run()
+
+std::string escapeJSON(const std::string& s)
+{
+	std::stringstream out;
+	for (const auto& c : s)
+	{
+		if (c == '"') out << "\\\"";
+		else if (c == '\\') out << "\\\\";
+		else if (c == '\n') out << "\\n";
+		else if (c == '\t') out << "\\t";
+		else if ((unsigned char)c < 0x20) out << ' ';
+		else out << c;
+	}
+	return out.str();
+} // escapeJSON()
+
+void writeJSON(std::ostream& out, const std::vector<benchmark_case>& cases,
+	const bool& quick, const unsigned int& repetitions)
+{
+	out << std::setprecision(6);
+	out << "{\n\t\"seed\": " << SEED << ",\n\t\"quick\": " << (quick? "true" : "false")
+			<< ",\n\t\"repetitions\": " << repetitions << ",\n\t\"benchmarks\": [";
+	for (unsigned int i = 0; i < cases.size(); ++i)
+	{
+		const benchmark_case& c = cases[i];
+		out << (i == 0? "\n" : ",\n") << "\t\t{\n\t\t\t\"name\": \"" << c.mName
+				<< "\",\n\t\t\t\"size_measure\": \"" << c.mSizeMeasure << "\",\n\t\t\t\"error\": ";
+		if (c.mErrorMessage.empty()) out << "null";
+		else out << "\"" << escapeJSON(c.mErrorMessage) << "\"";
+		out << ",\n\t\t\t\"measurements\": [";
+		for (unsigned int j = 0; j < c.mMeasurements.size(); ++j)
+		{
+			const measurement& m = c.mMeasurements[j];
+			out << (j == 0? "\n" : ",\n") << "\t\t\t\t{\"size\": " << m.mSize
+					<< ", \"min\": " << m.mMin << ", \"median\": " << m.mMedian
+					<< ", \"mean\": " << m.mMean << ", \"scaling_exponent\": ";
+			if (m.mHasScalingExponent) out << m.mScalingExponent;
+			else out << "null";
+			out << ", \"times\": [";
+			for (unsigned int k = 0; k < m.mTimes.size(); ++k)
+			{
+				out << (k == 0? "" : ", ") << m.mTimes[k];
+			}
+			out << "]}";
+		}
+		if (!c.mMeasurements.empty()) out << "\n\t\t\t";
+		out << "]\n\t\t}";
+	}
+	out << "\n\t]";
+#ifdef BSO_INSTRUMENTATION
+	out << ",\n\t\"instrumentation\": ";
+	bso::utilities::instrumentation::write_json(out);
+#endif
+	out << "\n}" << std::endl;
+} // writeJSON()
+
+spt::ms_building gridDesign(const unsigned int& n)
+{ // n spaces of 3x3x3 m, placed on a square grid on the ground floor
+	unsigned int columns = std::ceil(std::sqrt((double)n));
+	std::vector<spt::ms_space> spaces;
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		spaces.push_back(spt::ms_space(i+1, {3000.0*(i%columns), 3000.0*(i/columns), 0},
+			{3000, 3000, 3000}));
+	}
+	return spt::ms_building(spaces);
+} // gridDesign()
+
+spt::ms_building stackedDesign(const unsigned int& n, const unsigned long& seed)
+{ // n spaces stacked in randomly chosen columns of a grid, with random heights
+	std::mt19937 rng(seed);
+	unsigned int columns = std::max(1u, (unsigned int)std::ceil(std::sqrt(n/2.0)));
+	std::uniform_int_distribution<unsigned int> columnDistribution(0, columns*columns - 1);
+	std::uniform_int_distribution<unsigned int> heightDistribution(25, 40);
+	std::vector<double> columnHeights(columns*columns, 0.0);
+	std::vector<spt::ms_space> spaces;
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		unsigned int column = columnDistribution(rng);
+		double height = 100.0*heightDistribution(rng);
+		spaces.push_back(spt::ms_space(i+1, {3000.0*(column%columns), 3000.0*(column/columns),
+			columnHeights[column]}, {3000, 3000, height}));
+		columnHeights[column] += height;
+	}
+	return spt::ms_building(spaces);
+} // stackedDesign()
+
+std::shared_ptr<sd::sd_model> mbbBeam(const unsigned int& meshSize)
+{ // the MBB beam of the topopt_SIMP unit test, meshed with meshSize divisions per component
+	// (built in place, copying an sd_model does not copy the loads and constraints of its points)
+	auto sdPtr = std::make_shared<sd::sd_model>();
+	sd::sd_model& sd = *sdPtr;
+	sd::component::constraint c0(0), c1(1), c2(2), c3(3), c4(4);
+	sd::component::load_case lc1("vertical load");
+	sd::component::load l1(lc1, 1,1);
+	sd::component::structure str1("flat_shell",{{"E",1},{"thickness",1},{"poisson",0.3}});
+
+	auto p1 = sd.addPoint({0,20,0});
+	auto p2 = sd.addPoint({60,0,0});
+	p2->addConstraint(c1);
+	p1->addLoad(l1);
+	auto line1 = sd.addGeometry(geom::line_segment({{0,0,0},{0,20,0}}));
+	line1->addConstraint(c0);
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		auto quad = sd.addGeometry(geom::quadrilateral({{20.0*i,0,0},{20.0*i,20,0},
+			{20.0*(i+1),20,0},{20.0*(i+1),0,0}}));
+		quad->addStructure(str1);
+		quad->addConstraint(c2); quad->addConstraint(c3); quad->addConstraint(c4);
+	}
+	sd.setMeshSize(meshSize);
+	return sdPtr;
+} // mbbBeam()
+
+std::vector<bso::utilities::data_point> randomData(const unsigned int& n,
+	const unsigned int& dimensions, const unsigned long& seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	std::vector<bso::utilities::data_point> data;
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		bso::utilities::data_point p(dimensions);
+		for (unsigned int j = 0; j < dimensions; ++j) p(j) = distribution(rng);
+		data.push_back(p);
+	}
+	return data;
+} // randomData()
+
+} // namespace benchmarks
+
+int main(int argc, char* argv[])
+{
+	using namespace benchmarks;
+	bool quick = false;
+	std::string dataDirectory = "../example";
+	std::string outputFile = "benchmark_results.json";
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--quick") quick = true;
+		else if (arg == "--data" && i+1 < argc) dataDirectory = argv[++i];
+		else outputFile = arg;
+	}
+	unsigned int repetitions = quick? 1 : 3;
+	auto sizes = [quick](const std::vector<unsigned int>& s)
+	{ // quick runs only use the two smallest sizes
+		return quick? std::vector<unsigned int>(s.begin(), s.begin() + std::min<size_t>(2, s.size())) : s;
+	};
+
+	std::ofstream output(outputFile.c_str());
+	if (!output)
+	{
+		std::cerr << "Could not open output file: " << outputFile << std::endl;
+		return 1;
+	}
+	if (chdir(dataDirectory.c_str()) != 0)
+	{
+		std::cerr << "Could not enter data directory: " << dataDirectory << std::endl;
+		return 1;
+	}
+	std::stringstream devNull; // absorbs the progress output of the topology optimizations
+	std::vector<benchmark_case> cases;
+
+	// spatial design
+	cases.push_back(run("ms_parse", "spaces", sizes({8, 16, 32, 64}), repetitions,
+		[](const unsigned int& n)
+		{
+			auto input = std::make_shared<std::string>();
+			std::stringstream designStream;
+			designStream << stackedDesign(n, SEED);
+			*input = designStream.str();
+			return [input]()
+			{
+				std::stringstream in(*input);
+				spt::ms_building ms(in);
+			};
+		}));
+	cases.push_back(run("cf_building_grid", "spaces", sizes({4, 9, 16, 25}), repetitions,
+		[](const unsigned int& n)
+		{
+			auto ms = std::make_shared<spt::ms_building>(gridDesign(n));
+			return [ms]() {spt::cf_building cf(*ms);};
+		}));
+	cases.push_back(run("cf_building_stacked", "spaces", sizes({4, 8, 16, 32}), repetitions,
+		[](const unsigned int& n)
+		{
+			auto ms = std::make_shared<spt::ms_building>(stackedDesign(n, SEED));
+			return [ms]() {spt::cf_building cf(*ms);};
+		}));
+
+	// structural design
+	cases.push_back(run("grammar_sd", "spaces", sizes({4, 8, 16, 32}), repetitions,
+		[](const unsigned int& n)
+		{
+			auto cf = std::make_shared<spt::cf_building>(stackedDesign(n, SEED));
+			return [cf]()
+			{
+				bso::grammar::grammar gram(*cf);
+				sd::sd_model sd = gram.sd_grammar<>(std::string("settings/sd_settings.txt"));
+			};
+		}));
+	cases.push_back(run("sd_mesh", "mesh_size", sizes({5, 10, 20, 40}), repetitions,
+		[](const unsigned int& n)
+		{
+			auto sd = mbbBeam(n);
+			return [sd, n]() {sd->mesh(n);};
+		}));
+	cases.push_back(run("fea_generate_gsm", "mesh_size", sizes({5, 10, 20, 40}), repetitions,
+		[](const unsigned int& n)
+		{
+			auto sd = mbbBeam(n);
+			sd->mesh(n);
+			return [sd]() {sd->getFEA()->generateGSM();};
+		}));
+	for (const std::string solver : {"SimplicialLLT", "SimplicialLDLT", "Supernodal", "BiCGSTAB", "scaledBiCGSTAB", "PCG"})
+	{
+		cases.push_back(run("fea_solve_" + solver, "mesh_size", sizes({5, 10, 20, 40}), repetitions,
+			[solver](const unsigned int& n)
+			{
+				auto sd = mbbBeam(n);
+				sd->mesh(n);
+				return [sd, solver]() {sd->getFEA()->solve(solver);};
+			}));
+	}
+	cases.push_back(run("fea_solve_Reanalysis", "mesh_size", sizes({5, 10, 20, 40}), repetitions,
+		[](const unsigned int& n)
+		{ // one element of the factored reference system is softened
+			auto sd = mbbBeam(n);
+			sd->mesh(n);
+			sd->getFEA()->solve("Reanalysis");
+			sd->getFEA()->getElements()[0]->updateDensity(0.5, 3.0);
+			sd->getFEA()->generateGSM();
+			return [sd]() {sd->getFEA()->solve("Reanalysis");};
+		}));
+	cases.push_back(run("fea_solve_PCG_Multigrid", "mesh_size", sizes({4, 8, 16, 32}), repetitions,
+		[](const unsigned int& n)
+		{ // even mesh sizes, so that the coarse grids exist
+			auto sd = mbbBeam(n);
+			sd->mesh(n);
+			sd::pcg_settings settings;
+			settings.mPreconditioner = "Multigrid";
+			sd->getFEA()->setPCGSettings(settings);
+			return [sd]() {sd->getFEA()->solve("PCG");};
+		}));
+	cases.push_back(run("fea_solve_PCG_MatrixFree", "mesh_size", sizes({5, 10, 20, 40}), repetitions,
+		[](const unsigned int& n)
+		{
+			auto sd = mbbBeam(n);
+			sd->setMatrixFree(true);
+			sd->mesh(n);
+			sd::pcg_settings settings;
+			settings.mPreconditioner = "BlockJacobi";
+			sd->getFEA()->setPCGSettings(settings);
+			return [sd]() {sd->getFEA()->solve("PCG");};
+		}));
+
+	// topology optimizations, each for a fixed number of iterations
+	const unsigned int topOptIterations = 5;
+	auto topOpt = [&devNull, topOptIterations](const std::function<void(sd::sd_model&)>& optimize)
+	{
+		return [&devNull, topOptIterations, optimize](const unsigned int& n)
+		{
+			auto sd = mbbBeam(n);
+			sd->mesh(n);
+			sd->setTopOptOutputStream(devNull);
+			sd->setTopOptMaxIterations(topOptIterations);
+			return [sd, optimize]() {optimize(*sd);};
+		};
+	};
+	namespace to = sd::topology_optimization;
+	cases.push_back(run("topopt_SIMP", "mesh_size", sizes({5, 10, 20}), repetitions,
+		topOpt([](sd::sd_model& sd) {sd.topologyOptimization<to::SIMP>(0.5,1.5,3.0,0.2,1e-2);})));
+	cases.push_back(run("topopt_ROBUST", "mesh_size", sizes({5, 10, 20}), repetitions,
+		topOpt([](sd::sd_model& sd) {sd.topologyOptimization<to::ROBUST>(0.5,1.5,3.0,0.2,1e-2);})));
+	cases.push_back(run("topopt_ELE_SIMP", "mesh_size", sizes({5, 10, 20}), repetitions,
+		topOpt([](sd::sd_model& sd) {sd.topologyOptimization<to::ELE_SIMP>(0.5,1.5,3.0,0.2,1e-2);})));
+	cases.push_back(run("topopt_COMP_SIMP", "mesh_size", sizes({5, 10, 20}), repetitions,
+		topOpt([](sd::sd_model& sd) {sd.topologyOptimization<to::COMP_SIMP>(0.5,3.0,0.2,1e-2);})));
+	cases.push_back(run("topopt_STRESS_BASED", "mesh_size", sizes({4, 8, 12}), repetitions,
+		topOpt([](sd::sd_model& sd)
+		{
+			sd.topologyOptimization<to::STRESS_BASED>(0.5,1.5,3.0,1e-3,1.0,1.0,1e-2,0.2);
+		})));
+
+	// building physics
+	cases.push_back(run("bp_simulate_periods", "spaces", sizes({2, 4, 8}), repetitions,
+		[](const unsigned int& n)
+		{
+			spt::cf_building cf(gridDesign(n));
+			bso::grammar::grammar gram(cf);
+			auto bp = std::make_shared<bso::building_physics::bp_model>(
+				gram.bp_grammar<>(std::string("settings/bp_settings.txt")));
+			return [bp]() {bp->simulatePeriods("runge_kutta_dopri5",1e-3,1e-3);};
+		}));
+
+	// utilities
+	cases.push_back(run("clustering", "data_points", sizes({50, 100, 200, 400}), repetitions,
+		[quick](const unsigned int& n)
+		{
+			auto data = std::make_shared<std::vector<bso::utilities::data_point> >(
+				randomData(n, 2, SEED));
+			unsigned int runs = quick? 2 : 10;
+			return [data, runs]() {bso::utilities::clustering c(SEED, *data, 2, 10, runs);};
+		}));
+	cases.push_back(run("non_dominated_search", "data_points", sizes({1000, 4000, 16000}),
+		repetitions, [](const unsigned int& n)
+		{
+			auto data = std::make_shared<const std::vector<bso::utilities::data_point> >(
+				randomData(n, 2, SEED));
+			return [data]() {bso::utilities::non_dominated_search(*data);};
+		}));
+	cases.push_back(run("non_dominated_sort", "data_points", sizes({1000, 4000, 16000}),
+		repetitions, [](const unsigned int& n)
+		{
+			auto objectives = std::make_shared<const bso::utilities::objective_matrix>(
+				bso::utilities::toObjectiveMatrix(randomData(n, 3, SEED)));
+			return [objectives]() {bso::utilities::non_dominated_sort(*objectives);};
+		}));
+
+	writeJSON(output, cases, quick, repetitions);
+	std::cout << "Results written to: " << outputFile << std::endl;
+	return 0;
+} // main()
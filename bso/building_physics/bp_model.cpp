@@ -81,23 +81,26 @@ void bp_model::mSimulate(const boost::posix_time::time_period& period, std::ostr
 	for (auto& i : mDependentStates) mSystem.getx()(i->getIndex()) = mInitialStateTemperatures;
 	for (auto& i : mStates) i->initSystem(mSystem);
 
-	while(simulationTime > period.begin())
 	{
-		simulationTime -= mTimeStepSize;
-		mSystem.updateTime(simulationTime);
-		for (auto& j : mIndependentStates) j->updateSystem(mSystem);
-		for (auto& j : mDependentStates) j->updateSystem(mSystem);
-		if (absError == 0 && relError == 0)
+		BSO_SCOPED_TIMER("bp_warm_up");
+		while(simulationTime > period.begin())
 		{
-			stepper.do_step(mSystem,mSystem.getx(),
-				(double)(simulationTime - warmUpEnd).total_seconds(),
-				-(double)(mTimeStepSize.total_seconds()));
-		}
-		else
-		{
-			odeint::integrate_const(odeint::make_controlled(absError,relError,stepper),
-				std::ref(mSystem), mSystem.getx(),0.0,
-				-(double)(mTimeStepSize).total_seconds(),-(double)(mTimeStepSize).total_seconds());
+			simulationTime -= mTimeStepSize;
+			mSystem.updateTime(simulationTime);
+			for (auto& j : mIndependentStates) j->updateSystem(mSystem);
+			for (auto& j : mDependentStates) j->updateSystem(mSystem);
+			if (absError == 0 && relError == 0)
+			{
+				stepper.do_step(mSystem,mSystem.getx(),
+					(double)(simulationTime - warmUpEnd).total_seconds(),
+					-(double)(mTimeStepSize.total_seconds()));
+			}
+			else
+			{
+				odeint::integrate_const(odeint::make_controlled(absError,relError,stepper),
+					std::ref(mSystem), mSystem.getx(),0.0,
+					-(double)(mTimeStepSize).total_seconds(),-(double)(mTimeStepSize).total_seconds());
+			}
 		}
 	}
 	for (auto& i : mSpaces) i->resetCumulativeEnergies();
@@ -114,29 +117,32 @@ void bp_model::mSimulate(const boost::posix_time::time_period& period, std::ostr
 	simulationTime = period.begin();
 	mSystem.setStartTime(simulationTime);
 	for (auto& i : mSpaces) i->resetCumulativeEnergies();
-	while (simulationTime < period.last())
 	{
-		simulationTime += mTimeStepSize;
-		mSystem.updateTime(simulationTime);
-		for (auto& j : mIndependentStates) j->updateSystem(mSystem);
-		for (auto& j : mDependentStates) j->updateSystem(mSystem);
-		if (absError == 0 && relError == 0)
-		{
-			stepper.do_step(mSystem,mSystem.getx(),
-				(double)(simulationTime-period.begin()).total_seconds(),
-				(double)(mTimeStepSize.total_seconds()));
-			// odeint::integrate_const(stepper, std::ref(mSystem), mSystem.getx(),0.0,
-				// (double)(mTimeStepSize).total_seconds(),(double)(mTimeStepSize).total_seconds());
-		}
-		else
-		{
-			odeint::integrate_const(odeint::make_controlled(absError,relError,stepper),
-				std::ref(mSystem), mSystem.getx(),0.0,
-				(double)(mTimeStepSize).total_seconds(),(double)(mTimeStepSize).total_seconds());
-		}
-		if (mObserveSimulation)
+		BSO_SCOPED_TIMER("bp_stepping");
+		while (simulationTime < period.last())
 		{
-			this->mPrintSystemState(out);
+			simulationTime += mTimeStepSize;
+			mSystem.updateTime(simulationTime);
+			for (auto& j : mIndependentStates) j->updateSystem(mSystem);
+			for (auto& j : mDependentStates) j->updateSystem(mSystem);
+			if (absError == 0 && relError == 0)
+			{
+				stepper.do_step(mSystem,mSystem.getx(),
+					(double)(simulationTime-period.begin()).total_seconds(),
+					(double)(mTimeStepSize.total_seconds()));
+				// odeint::integrate_const(stepper, std::ref(mSystem), mSystem.getx(),0.0,
+					// (double)(mTimeStepSize).total_seconds(),(double)(mTimeStepSize).total_seconds());
+			}
+			else
+			{
+				odeint::integrate_const(odeint::make_controlled(absError,relError,stepper),
+					std::ref(mSystem), mSystem.getx(),0.0,
+					(double)(mTimeStepSize).total_seconds(),(double)(mTimeStepSize).total_seconds());
+			}
+			if (mObserveSimulation)
+			{
+				this->mPrintSystemState(out);
+			}
 		}
 	}
 
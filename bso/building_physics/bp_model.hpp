@@ -3,6 +3,7 @@
 
 #include <bso/building_physics/state_space_system.hpp>
 #include <bso/building_physics/state/states.hpp>
+#include <bso/utilities/instrumentation.hpp>
 
 #include <vector>
 #include <string>
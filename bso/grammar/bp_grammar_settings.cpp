@@ -1,9 +1,11 @@
-#ifndef BSO_GRAMMAR_BP_SPECIFICS_CPP
-#define BSO_GRAMMAR_BP_SPECIFICS_CPP
+#ifndef BSO_GRAMMAR_BP_GRAMMAR_SETTINGS_CPP
+#define BSO_GRAMMAR_BP_GRAMMAR_SETTINGS_CPP
 
 #include <bso/utilities/trim_and_cast.hpp>
+#include <bso/grammar/settings_cache.hpp>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/tokenizer.hpp>
 
 #include <fstream>
 #include <stdexcept>
@@ -11,25 +13,40 @@
 
 namespace bso { namespace grammar {
 
-void grammar::mReadBPSettings(const std::string& fileName)
+bp_grammar_settings::bp_grammar_settings(const std::string& fileName)
+:	mFileName(fileName)
 {
 	std::fstream input(fileName.c_str());
 	if (!input.is_open())
 	{
 		std::stringstream errorMessage;
-		errorMessage << "\nCould not read SD grammar settings, failed to open file:"
-								 << fileName << "\n(bso/grammar/grammar_sd_specifics.cpp)" << std::endl;
+		errorMessage << "\nCould not read BP grammar settings, failed to open file:"
+								 << fileName << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
+	this->mReadSettings(input);
+	input.close();
+} // ctor()
+
+bp_grammar_settings::bp_grammar_settings(std::istream& input)
+{
+	this->mReadSettings(input);
+} // ctor()
+
+bp_grammar_settings::~bp_grammar_settings()
+{
 
-	mBPSimulationPeriods.clear();
-	mBPSpaceSettings.clear();
-	mBPWallConstructions.clear();
-	mBPFloorConstructions.clear();
-	mBPWallGlazings.clear();
-	mBPFloorGlazings.clear();
-	mBPWarmUpDuration = boost::posix_time::time_duration(0,0,0,0);
-	mBPTimeStepSize = boost::posix_time::time_duration(0,0,0,0);
+} // dtor()
+
+std::shared_ptr<const bp_grammar_settings> bp_grammar_settings::read(const std::string& fileName)
+{
+	return read_settings<bp_grammar_settings>(fileName);
+} // read()
+
+void bp_grammar_settings::mReadSettings(std::istream& input)
+{
+	mWarmUpDuration = boost::posix_time::time_duration(0,0,0,0);
+	mTimeStepSize = boost::posix_time::time_duration(0,0,0,0);
 	
 	std::map<std::string,std::string> spaceTypeSettingIDs;
 	std::map<std::string,bso::building_physics::properties::space_settings> spaceSettings;
@@ -105,7 +122,7 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				unsigned int minutes = bso::utilities::trim_and_cast_uint(*token); ++token;
 				unsigned int seconds = bso::utilities::trim_and_cast_uint(*token); ++token;
 				
-				mBPWarmUpDuration = boost::posix_time::time_duration(hours,minutes,seconds,0);
+				mWarmUpDuration = boost::posix_time::time_duration(hours,minutes,seconds,0);
 				break;
 			}
 			case 'D':
@@ -114,7 +131,7 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				unsigned int minutes = bso::utilities::trim_and_cast_uint(*token); ++token;
 				unsigned int seconds = bso::utilities::trim_and_cast_uint(*token); ++token;
 				
-				mBPTimeStepSize = boost::posix_time::time_duration(hours,minutes,seconds,0);
+				mTimeStepSize = boost::posix_time::time_duration(hours,minutes,seconds,0);
 				break;
 			}
 			case 'E':
@@ -147,12 +164,12 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				hour = bso::utilities::trim_and_cast_uint(*token); ++token;
 				boost::posix_time::ptime end(boost::gregorian::date(year,month,day),boost::posix_time::hours(hour));
 				
-				mBPSimulationPeriods.emplace(fileName,boost::posix_time::time_period(start, end));
+				mSimulationPeriods.emplace(fileName,boost::posix_time::time_period(start, end));
 				break;
 			}
 			case 'G':
 			{ // ground profile
-				mBPGroundTemperature = bso::utilities::trim_and_cast_double(*token); ++token;
+				mGroundTemperature = bso::utilities::trim_and_cast_double(*token); ++token;
 				break;
 			}
 			case 'H':
@@ -192,7 +209,7 @@ void grammar::mReadBPSettings(const std::string& fileName)
 					std::stringstream errorMessage;
 					errorMessage << "\nError, while reading layers of a construction.\n"
 											 << "received the following exception:\n" << e.what()
-											 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+											 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 					throw std::invalid_argument(errorMessage.str());
 				}
 				constructionLayers.emplace(constructionPropIDs,layers);
@@ -235,11 +252,10 @@ void grammar::mReadBPSettings(const std::string& fileName)
 			errorMessage << "\nError, while reading BP grammar settings.\n"
 									 << "could not parse the following line: " << line
 									 << "\nreceived the following exception:\n" << e.what()
-									 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+									 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
 	} // end of file
-	input.close();
 
 	for (const auto& i : spaceTypeSettingIDs)
 	{
@@ -250,12 +266,12 @@ void grammar::mReadBPSettings(const std::string& fileName)
 			errorMessage << "\nError, after reading BP grammar settings.\n"
 									 << "could not find the space settings for the following space type: \n"
 									 << i.first
-									 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+									 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
 		else
 		{
-			mBPSpaceSettings.emplace(i.first, settingSearch->second);
+			mSpaceSettings.emplace(i.first, settingSearch->second);
 		}
 	}
 
@@ -276,7 +292,7 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				errorMessage << "\nError, after reading BP grammar settings.\n"
 										 << "could not find the material with the following ID:\n"
 										 << j.first
-										 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+										 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 				throw std::invalid_argument(errorMessage.str());
 			}
 			else
@@ -293,7 +309,7 @@ void grammar::mReadBPSettings(const std::string& fileName)
 									 << "could not find the visualization settings for\n"
 									 << "the following construction ID: \n"
 									 << i.first.first
-									 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+									 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
 		else 
@@ -317,7 +333,7 @@ void grammar::mReadBPSettings(const std::string& fileName)
 									 << "could not find the visualization settings for\n"
 									 << "the following glazing ID: \n"
 									 << i.first.first
-									 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+									 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
 		else 
@@ -339,12 +355,12 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				errorMessage << "\nError, after reading BP grammar settings.\n"
 										 << "could not find the construction for a wall with ID:\n"
 										 << i.second.second
-										 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+										 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 				throw std::invalid_argument(errorMessage.str());
 			}
 			else
 			{
-				mBPWallConstructions.emplace(i.first,constructSearch->second);
+				mWallConstructions.emplace(i.first,constructSearch->second);
 			}
 		}
 		else if (i.second.first == "glazing")
@@ -356,12 +372,12 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				errorMessage << "\nError, after reading BP grammar settings.\n"
 										 << "could not find the glazing for a wall with ID:\n"
 										 << i.second.second
-										 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+										 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 				throw std::invalid_argument(errorMessage.str());
 			}
 			else
 			{
-				mBPWallGlazings.emplace(i.first,glazingSearch->second);
+				mWallGlazings.emplace(i.first,glazingSearch->second);
 			}
 		}
 		else
@@ -370,7 +386,7 @@ void grammar::mReadBPSettings(const std::string& fileName)
 			errorMessage << "\nError, after reading BP grammar settings.\n"
 									 << "did not recognize the type assigned to a wall:\n"
 									 << i.second.first
-									 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+									 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
 	}
@@ -386,12 +402,12 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				errorMessage << "\nError, after reading BP grammar settings.\n"
 										 << "could not find the construction for a floor with ID:\n"
 										 << i.second.second
-										 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+										 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 				throw std::invalid_argument(errorMessage.str());
 			}
 			else
 			{
-				mBPFloorConstructions.emplace(i.first,constructSearch->second);
+				mFloorConstructions.emplace(i.first,constructSearch->second);
 			}
 		}
 		else if (i.second.first == "glazing")
@@ -403,12 +419,12 @@ void grammar::mReadBPSettings(const std::string& fileName)
 				errorMessage << "\nError, after reading BP grammar settings.\n"
 										 << "could not find the glazing for a floor with ID:\n"
 										 << i.second.second
-										 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+										 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 				throw std::invalid_argument(errorMessage.str());
 			}
 			else
 			{
-				mBPFloorGlazings.emplace(i.first,glazingSearch->second);
+				mFloorGlazings.emplace(i.first,glazingSearch->second);
 			}
 		}
 		else
@@ -417,14 +433,14 @@ void grammar::mReadBPSettings(const std::string& fileName)
 			errorMessage << "\nError, after reading BP grammar settings.\n"
 									 << "did not recognize the type assigned to a wall:\n"
 									 << i.second.first
-									 << "\n(bso/grammar/grammar_bp_specifics.cpp)" << std::endl;
+									 << "\n(bso/grammar/bp_grammar_settings.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
 	}
 
-} // mReadBPSettings()
+} // mReadSettings()
 	
 } // namespace grammar
 } // namespace bso
 
-#endif // BSO_GRAMMAR_BP_SPECIFICS_CPP
\ No newline at end of file
+#endif // BSO_GRAMMAR_BP_GRAMMAR_SETTINGS_CPP
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef BSO_GRAMMAR_BP_GRAMMAR_SETTINGS_HPP
+#define BSO_GRAMMAR_BP_GRAMMAR_SETTINGS_HPP
+
+#include <bso/building_physics/bp_model.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <istream>
+
+namespace bso { namespace grammar {
+
+class bp_grammar_settings
+{ // parsed BP grammar settings, not modified after construction so one instance can be shared by many grammars
+private:
+	std::string mFileName;
+	boost::posix_time::time_duration mWarmUpDuration;
+	boost::posix_time::time_duration mTimeStepSize;
+	double mGroundTemperature = 0;
+	std::map<std::string,boost::posix_time::time_period> mSimulationPeriods;
+	std::map<std::string,building_physics::properties::space_settings> mSpaceSettings;
+	std::map<std::pair<std::string,std::string>,building_physics::properties::construction> mWallConstructions;
+	std::map<std::pair<std::string,std::string>,building_physics::properties::construction> mFloorConstructions;
+	std::map<std::pair<std::string,std::string>,building_physics::properties::glazing> mWallGlazings;
+	std::map<std::pair<std::string,std::string>,building_physics::properties::glazing> mFloorGlazings;
+
+	void mReadSettings(std::istream& input);
+public:
+	bp_grammar_settings(const std::string& fileName);
+	bp_grammar_settings(std::istream& input);
+	~bp_grammar_settings();
+
+	static std::shared_ptr<const bp_grammar_settings> read(const std::string& fileName); // cached by path and modification time
+
+	const std::string& getFileName() const {return mFileName;} // empty if read from a stream
+	const boost::posix_time::time_duration& getWarmUpDuration() const {return mWarmUpDuration;}
+	const boost::posix_time::time_duration& getTimeStepSize() const {return mTimeStepSize;}
+	double getGroundTemperature() const {return mGroundTemperature;}
+	const std::map<std::string,boost::posix_time::time_period>& getSimulationPeriods() const
+		{return mSimulationPeriods;}
+	const std::map<std::string,building_physics::properties::space_settings>& getSpaceSettings() const
+		{return mSpaceSettings;}
+	const std::map<std::pair<std::string,std::string>,building_physics::properties::construction>&
+		getWallConstructions() const {return mWallConstructions;}
+	const std::map<std::pair<std::string,std::string>,building_physics::properties::construction>&
+		getFloorConstructions() const {return mFloorConstructions;}
+	const std::map<std::pair<std::string,std::string>,building_physics::properties::glazing>&
+		getWallGlazings() const {return mWallGlazings;}
+	const std::map<std::pair<std::string,std::string>,building_physics::properties::glazing>&
+		getFloorGlazings() const {return mFloorGlazings;}
+};
+
+} // namespace grammar
+} // namespace bso
+
+#include <bso/grammar/bp_grammar_settings.cpp>
+
+#endif // BSO_GRAMMAR_BP_GRAMMAR_SETTINGS_HPP
@@ -9,13 +9,14 @@ namespace bso { namespace grammar {
 
 	
 template <>
-bso::building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const std::string& fileName,
+bso::building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const bp_grammar_settings& settings,
 	const bool& useSurfaceTypeInsteadOfSpaceType)
 {
+	BSO_SCOPED_TIMER("grammar_bp");
 	// initialize a new BP model
 	bso::building_physics::bp_model mBPModel;
-	// read the building physics settings
-	this->mReadBPSettings(fileName);
+	// the rules of this call, deleted when it returns
+	bp_context context(mCFBuilding);
 
 	// create weather profile state
 	auto weatherProfile = new bso::building_physics::state::weather_profile(
@@ -24,20 +25,20 @@ bso::building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const st
 
 	// create ground profile state
 	auto groundProfile = new bso::building_physics::state::ground_profile(
-		mBPModel.getNextIndependentIndex(), mBPGroundTemperature);
+		mBPModel.getNextIndependentIndex(), settings.getGroundTemperature());
 	mBPModel.addState(groundProfile);
 
 	// add simulation periods
-	for (const auto& i : mBPSimulationPeriods)
+	for (const auto& i : settings.getSimulationPeriods())
 	{
 		mBPModel.addSimulationPeriod(i.first,i.second);
 	}
 
 	// set time step size
-	mBPModel.setTimeStepSize(mBPTimeStepSize);
+	mBPModel.setTimeStepSize(settings.getTimeStepSize());
 
 	// set warm up duration
-	mBPModel.setWarmUpDuration(mBPWarmUpDuration);
+	mBPModel.setWarmUpDuration(settings.getWarmUpDuration());
 
 	// set initial state temperature
 	mBPModel.setInitialStateTemperatures(20);
@@ -48,22 +49,22 @@ bso::building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const st
 	for (const auto& i : mSpaceProperties)
 	{
 		// get space type
-		std::string usedType = i.second->getSpaceType();
+		std::string usedType = i.getSpaceType();
 		
 		// find the space settings
-		auto spaceSettingSearch = mBPSpaceSettings.find(usedType);
-		if (spaceSettingSearch == mBPSpaceSettings.end())
+		auto spaceSettingSearch = settings.getSpaceSettings().find(usedType);
+		if (spaceSettingSearch == settings.getSpaceSettings().end())
 		{
 			std::stringstream errorMessage;
 			errorMessage << "\nError, in default bp grammar could not find the specified\n"
 									 << "space setting for type: \"" << usedType << "\"\n"
 									 << "Has this type set been specified in the inputfile?: \""
-									 << fileName << "\"\n(bso/grammar/bp_grammars/default_bp_grammar.cpp)" 
+									 << settings.getFileName() << "\"\n(bso/grammar/bp_grammars/default_bp_grammar.cpp)" 
 									 << std::endl;
 			throw std::runtime_error(errorMessage.str());
 		}
 
-		auto spaceRuleSet = new rule_set::bp_space_rule(i.second);
+		auto spaceRuleSet = new rule_set::bp_space_rule(&i);
 		// assign space settings
 		spaceRuleSet->assignSettings(spaceSettingSearch->second);
 		
@@ -73,43 +74,43 @@ bso::building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const st
 		// assign space ptr map
 		spaceRuleSet->assignSpaceStatesMap(&spaceStates);
 		
-		mBPSpaceRules[i.first] = spaceRuleSet;
+		context.mBPSpaceRules[i.getSpacePtr()->index()] = spaceRuleSet;
 	}
 
 	// create rectangle rules
 	for (const auto& i : mRectangleProperties)
 	{
-		if (i.second->isSpaceSeparating())
+		if (i.isSpaceSeparating())
 		{
 			// get the space or surface types, depending on the settings
-			std::pair<std::string, std::string> usedTypes = i.second->getSpaceTypes();
-			if (useSurfaceTypeInsteadOfSpaceType) usedTypes = i.second->getSurfaceTypes();
+			std::pair<std::string, std::string> usedTypes = i.getSpaceTypes();
+			if (useSurfaceTypeInsteadOfSpaceType) usedTypes = i.getSurfaceTypes();
 
 			// determine the structural type and properties of the rectangle
 			bool constructionFound = false;
-			auto constuctionSearch = mBPFloorConstructions.find(usedTypes);
+			auto constuctionSearch = settings.getFloorConstructions().find(usedTypes);
 			bool glazingFound = false;
-			auto glazingSearch = mBPFloorGlazings.find(usedTypes);
-			if (i.second->isFloor())
+			auto glazingSearch = settings.getFloorGlazings().find(usedTypes);
+			if (i.isFloor())
 			{
-				if (constuctionSearch != mBPFloorConstructions.end())
+				if (constuctionSearch != settings.getFloorConstructions().end())
 				{
 					constructionFound = true;
 				}
-				if (glazingSearch != mBPFloorGlazings.end())
+				if (glazingSearch != settings.getFloorGlazings().end())
 				{
 					glazingFound = true;
 				}
 			}
-			else if (i.second->isWall())
+			else if (i.isWall())
 			{
-				constuctionSearch = mBPWallConstructions.find(usedTypes);
-				glazingSearch = mBPWallGlazings.find(usedTypes);
-				if (constuctionSearch != mBPWallConstructions.end())
+				constuctionSearch = settings.getWallConstructions().find(usedTypes);
+				glazingSearch = settings.getWallGlazings().find(usedTypes);
+				if (constuctionSearch != settings.getWallConstructions().end())
 				{
 					constructionFound = true;
 				}
-				if (glazingSearch != mBPWallGlazings.end())
+				if (glazingSearch != settings.getWallGlazings().end())
 				{
 					glazingFound = true;
 				}
@@ -120,15 +121,15 @@ bso::building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const st
 				errorMessage << "\nError, in default bp grammar could not find the specified\n"
 										 << "type settings: \"" << usedTypes.first << "\" - \"" 
 										 << usedTypes.second << "\" ("
-										 << ((i.second->isFloor())? "floor" : "wall") << ")\n"
+										 << ((i.isFloor())? "floor" : "wall") << ")\n"
 										 << "Has this type set been specified in the inputfile?: \""
-										 << fileName << "\"\n(bso/grammar/bp_grammars/default_bp_grammar.cpp)" 
+										 << settings.getFileName() << "\"\n(bso/grammar/bp_grammars/default_bp_grammar.cpp)" 
 										 << std::endl;
 				throw std::runtime_error(errorMessage.str());
 			}
 
 			// create a rectangle rule set
-			auto rectangleRuleSet = new rule_set::bp_rectangle_rule(i.second);
+			auto rectangleRuleSet = new rule_set::bp_rectangle_rule(&i);
 			if (constructionFound)
 			{
 				rectangleRuleSet->assignConstruction(constuctionSearch->second);
@@ -145,21 +146,31 @@ bso::building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const st
 
 			// assign weather profile
 			rectangleRuleSet->assignWeatherProfile(weatherProfile);
-			mBPRectangleRules[i.first] = rectangleRuleSet;
+			context.mBPRectangleRules[i.getRectanglePtr()->index()] = rectangleRuleSet;
 		}
 	}
 
 	// apply rules
-	for (const auto& i : mBPSpaceRules) i.second->apply(mBPModel);
-	for (const auto& i : mBPRectangleRules) i.second->apply(mBPModel);
-
-	// delete the rules
-	for (auto& i : mBPSpaceRules) delete i.second;
-	for (auto& i : mBPRectangleRules) delete i.second;
+	for (const auto& i : context.mBPSpaceRules) if (i != nullptr) i->apply(mBPModel);
+	for (const auto& i : context.mBPRectangleRules) if (i != nullptr) i->apply(mBPModel);
 
 	return mBPModel;
 } // default_bp_grammar
 
+template <>
+building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const bp_grammar_settings& settings)
+{
+	return this->bp_grammar<DEFAULT_BP_GRAMMAR>(settings,false);
+}
+
+template <>
+building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const std::string& fileName,
+	const bool& useSurfaceTypeInsteadOfSpaceType)
+{ // the settings file is only parsed again when it has been modified
+	return this->bp_grammar<DEFAULT_BP_GRAMMAR>(*bp_grammar_settings::read(fileName),
+		useSurfaceTypeInsteadOfSpaceType);
+}
+
 template <>
 building_physics::bp_model grammar::bp_grammar<DEFAULT_BP_GRAMMAR>(const std::string& fileName)
 {
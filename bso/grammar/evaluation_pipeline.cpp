@@ -0,0 +1,168 @@
+#ifndef BSO_GRAMMAR_EVALUATION_PIPELINE_CPP
+#define BSO_GRAMMAR_EVALUATION_PIPELINE_CPP
+
+#include <stdexcept>
+#include <utility>
+
+namespace bso { namespace grammar {
+
+evaluation_pipeline::evaluation_pipeline(const unsigned int& threads /*= 0*/,
+	const std::size_t& queueCapacity /*= 0*/)
+:	mPool(threads, queueCapacity)
+{ // 0 uses the thread_pool defaults
+
+} // ctor()
+
+evaluation_pipeline::~evaluation_pipeline()
+{ // the pool is destroyed first, it finishes all submitted designs
+
+} // dtor()
+
+#ifdef SD_MODEL_HPP
+void evaluation_pipeline::setSDGrammar(std::function<structural_design::sd_model(grammar&)> sdGrammar,
+	const std::string& solver /*= "SimplicialLDLT"*/)
+{
+	mSDGrammar = sdGrammar;
+	mSDSolver = solver;
+} // setSDGrammar()
+#endif
+
+#ifdef BSO_BP_MODEL_HPP
+void evaluation_pipeline::setBPGrammar(std::function<building_physics::bp_model(grammar&)> bpGrammar)
+{
+	mBPGrammar = bpGrammar;
+} // setBPGrammar()
+#endif
+
+void evaluation_pipeline::setCallback(std::function<void(const design_evaluation&)> callback,
+	const bool& inOrder /*= true*/)
+{ // called from the workers, in the order of submission if inOrder is set
+	std::lock_guard<std::mutex> submitLock(mSubmitMutex);
+	std::lock_guard<std::mutex> callbackLock(mCallbackMutex);
+	mCallback = callback;
+	mCallbackInOrder = inOrder;
+	mPendingCallbacks.clear();
+	mNextCallback = mSubmitted; // designs that were submitted before are not reported
+} // setCallback()
+
+design_evaluation evaluation_pipeline::mEvaluate(const spatial_design::ms_building& ms,
+	const unsigned long& index)
+{ // an exception thrown by a stage is stored in the evaluation, the other stages are still evaluated
+	design_evaluation evaluation;
+	evaluation.mIndex = index;
+	try
+	{
+		spatial_design::cf_building cf(ms);
+		grammar gram(cf);
+
+		#ifdef BSO_BP_MODEL_HPP
+		std::future<building_physics::bp_results> bpResults;
+		if (mBPGrammar)
+		{ // runs on another worker if one is idle, otherwise after the SD stage on this one
+			bpResults = mPool.submit([this, &gram]()
+			{
+				building_physics::bp_model bp = mBPGrammar(gram);
+				bp.simulatePeriods();
+				return bp.getTotalResults();
+			});
+		}
+		#endif
+
+		#ifdef SD_MODEL_HPP
+		if (mSDGrammar)
+		{
+			try
+			{
+				structural_design::sd_model sd = mSDGrammar(gram);
+				sd.analyze(mSDSolver);
+				evaluation.mSDResults = sd.getTotalResults();
+				evaluation.mSDEvaluated = true;
+			}
+			catch (std::exception& e)
+			{
+				evaluation.mErrorMessage = e.what();
+			}
+		}
+		#endif
+
+		#ifdef BSO_BP_MODEL_HPP
+		if (bpResults.valid())
+		{ // the grammar must outlive the BP stage, so it is awaited even if the SD stage failed
+			mPool.wait(bpResults);
+			try
+			{
+				evaluation.mBPResults = bpResults.get();
+				evaluation.mBPEvaluated = true;
+			}
+			catch (std::exception& e)
+			{
+				if (evaluation.mErrorMessage.empty()) evaluation.mErrorMessage = e.what();
+			}
+		}
+		#endif
+
+		evaluation.mSucceeded = evaluation.mErrorMessage.empty();
+	}
+	catch (std::exception& e)
+	{
+		evaluation.mErrorMessage = e.what();
+	}
+	return evaluation;
+} // mEvaluate()
+
+void evaluation_pipeline::mReport(const design_evaluation& evaluation)
+{ // the callback is never called by two workers at the same time
+	std::lock_guard<std::mutex> lock(mCallbackMutex);
+	if (!mCallback || evaluation.mIndex < mNextCallback) return;
+	if (!mCallbackInOrder)
+	{
+		mCallback(evaluation);
+		return;
+	}
+
+	mPendingCallbacks[evaluation.mIndex] = evaluation;
+	auto nextSearch = mPendingCallbacks.begin();
+	while (nextSearch != mPendingCallbacks.end() && nextSearch->first == mNextCallback)
+	{
+		mCallback(nextSearch->second);
+		nextSearch = mPendingCallbacks.erase(nextSearch);
+		++mNextCallback;
+	}
+} // mReport()
+
+std::future<design_evaluation> evaluation_pipeline::submit(const spatial_design::ms_building& ms)
+{ // blocks while the queue is full
+	unsigned long index;
+	{
+		std::lock_guard<std::mutex> lock(mSubmitMutex);
+		index = mSubmitted++;
+	}
+	return mPool.submit([this, ms, index]()
+	{
+		design_evaluation evaluation = this->mEvaluate(ms, index);
+		this->mReport(evaluation);
+		return evaluation;
+	});
+} // submit()
+
+std::vector<design_evaluation> evaluation_pipeline::evaluate(
+	const std::vector<spatial_design::ms_building>& designs)
+{ // results in the order of the designs
+	std::vector<std::future<design_evaluation> > futures;
+	futures.reserve(designs.size());
+	for (const auto& i : designs) futures.push_back(this->submit(i));
+
+	std::vector<design_evaluation> evaluations;
+	evaluations.reserve(designs.size());
+	for (auto& i : futures)
+	{
+		mPool.wait(i);
+		evaluations.push_back(i.get());
+	}
+	return evaluations;
+} // evaluate()
+
+} // namespace grammar
+} // namespace bso
+
+#endif // BSO_GRAMMAR_EVALUATION_PIPELINE_CPP
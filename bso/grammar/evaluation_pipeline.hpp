@@ -0,0 +1,81 @@
+#ifndef BSO_GRAMMAR_EVALUATION_PIPELINE_HPP
+#define BSO_GRAMMAR_EVALUATION_PIPELINE_HPP
+
+#include <bso/spatial_design/ms_building.hpp>
+#include <bso/spatial_design/cf_building.hpp>
+#include <bso/grammar/grammar.hpp>
+#include <bso/utilities/thread_pool.hpp>
+
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bso { namespace grammar {
+
+struct design_evaluation
+{
+	unsigned long mIndex = 0; // position of the design in the order of submission
+	bool mSucceeded = false;
+	std::string mErrorMessage; // of the exception that was thrown by one of the stages
+	#ifdef SD_MODEL_HPP
+	bool mSDEvaluated = false;
+	structural_design::sd_results mSDResults;
+	#endif
+	#ifdef BSO_BP_MODEL_HPP
+	bool mBPEvaluated = false;
+	building_physics::bp_results mBPResults;
+	#endif
+};
+
+class evaluation_pipeline
+{ // evaluates designs in parallel: MS -> CF -> grammar -> SD analysis and BP simulation,
+	// the SD and BP stages of one design run concurrently on a single grammar
+private:
+	#ifdef SD_MODEL_HPP
+	std::function<structural_design::sd_model(grammar&)> mSDGrammar; // no SD stage if empty
+	std::string mSDSolver = "SimplicialLDLT";
+	#endif
+	#ifdef BSO_BP_MODEL_HPP
+	std::function<building_physics::bp_model(grammar&)> mBPGrammar; // no BP stage if empty
+	#endif
+
+	std::function<void(const design_evaluation&)> mCallback;
+	bool mCallbackInOrder = true;
+	std::map<unsigned long, design_evaluation> mPendingCallbacks; // finished out of order
+	unsigned long mNextCallback = 0;
+	std::mutex mCallbackMutex;
+
+	unsigned long mSubmitted = 0;
+	std::mutex mSubmitMutex;
+
+	utilities::thread_pool mPool; // declared last, so that its workers finish before the members above are destroyed
+
+	design_evaluation mEvaluate(const spatial_design::ms_building& ms, const unsigned long& index);
+	void mReport(const design_evaluation& evaluation);
+public:
+	evaluation_pipeline(const unsigned int& threads = 0, const std::size_t& queueCapacity = 0); // 0 uses the thread_pool defaults
+	~evaluation_pipeline(); // finishes all submitted designs
+
+	#ifdef SD_MODEL_HPP
+	void setSDGrammar(std::function<structural_design::sd_model(grammar&)> sdGrammar,
+		const std::string& solver = "SimplicialLDLT"); // e.g. [&](grammar& g){return g.sd_grammar<>(settings);}
+	#endif
+	#ifdef BSO_BP_MODEL_HPP
+	void setBPGrammar(std::function<building_physics::bp_model(grammar&)> bpGrammar);
+	#endif
+	void setCallback(std::function<void(const design_evaluation&)> callback,
+		const bool& inOrder = true); // called from the workers, in the order of submission if inOrder is set
+
+	std::future<design_evaluation> submit(const spatial_design::ms_building& ms); // blocks while the queue is full
+	std::vector<design_evaluation> evaluate(const std::vector<spatial_design::ms_building>& designs); // results in the order of the designs
+};
+
+} // namespace grammar
+} // namespace bso
+
+#include <bso/grammar/evaluation_pipeline.cpp>
+
+#endif // BSO_GRAMMAR_EVALUATION_PIPELINE_HPP
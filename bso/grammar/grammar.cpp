@@ -4,57 +4,66 @@
 namespace bso { namespace grammar {
 
 grammar::grammar(const spatial_design::cf_building& cf)
-:	mCFBuilding(cf),
-	mLoadPanel(structural_design::component::structure())
-{
-	for (const auto& i : mCFBuilding.cfVertices())
-	{
-		mVertexProperties[i] = new rule_set::vertex_property(i);
-	}
-	for (const auto& i : mCFBuilding.cfLines())
-	{
-		mLineProperties[i] = new rule_set::line_property(i);
-	}
-	for (const auto& i : mCFBuilding.cfRectangles())
-	{
-		mRectangleProperties[i] = new rule_set::rectangle_property(i);
-	}
-	for (const auto& i : mCFBuilding.cfCuboids())
-	{
-		mCuboidProperties[i] = new rule_set::cuboid_property(i);
-	}
-	for (const auto& i : mCFBuilding.cfPoints())
-	{
-		mPointProperties[i] = new rule_set::point_property(i);
-	}
-	for (const auto& i : mCFBuilding.cfEdges())
-	{
-		mEdgeProperties[i] = new rule_set::edge_property(i);
-	}
-	for (const auto& i : mCFBuilding.cfSurfaces())
-	{
-		mSurfaceProperties[i] = new rule_set::surface_property(i);
-	}
-	for (const auto& i : mCFBuilding.cfSpaces())
-	{
-		mSpaceProperties[i] = new rule_set::space_property(i);
-	}
-	
+:	mCFBuilding(cf)
+{ // the properties are stored in the order of the entities, so that an entity's index() is its position
+	mVertexProperties.reserve(mCFBuilding.cfVertices().size());
+	for (const auto& i : mCFBuilding.cfVertices()) mVertexProperties.emplace_back(i);
+	mLineProperties.reserve(mCFBuilding.cfLines().size());
+	for (const auto& i : mCFBuilding.cfLines()) mLineProperties.emplace_back(i);
+	mRectangleProperties.reserve(mCFBuilding.cfRectangles().size());
+	for (const auto& i : mCFBuilding.cfRectangles()) mRectangleProperties.emplace_back(i);
+	mCuboidProperties.reserve(mCFBuilding.cfCuboids().size());
+	for (const auto& i : mCFBuilding.cfCuboids()) mCuboidProperties.emplace_back(i);
+	mPointProperties.reserve(mCFBuilding.cfPoints().size());
+	for (const auto& i : mCFBuilding.cfPoints()) mPointProperties.emplace_back(i);
+	mEdgeProperties.reserve(mCFBuilding.cfEdges().size());
+	for (const auto& i : mCFBuilding.cfEdges()) mEdgeProperties.emplace_back(i);
+	mSurfaceProperties.reserve(mCFBuilding.cfSurfaces().size());
+	for (const auto& i : mCFBuilding.cfSurfaces()) mSurfaceProperties.emplace_back(i);
+	mSpaceProperties.reserve(mCFBuilding.cfSpaces().size());
+	for (const auto& i : mCFBuilding.cfSpaces()) mSpaceProperties.emplace_back(i);
 } // ctor()
 
 grammar::~grammar()
 {
-	for (auto& i : mVertexProperties) delete i.second;
-	for (auto& i : mLineProperties) delete i.second;
-	for (auto& i : mRectangleProperties) delete i.second;
-	for (auto& i : mCuboidProperties) delete i.second;
-	for (auto& i : mPointProperties) delete i.second;
-	for (auto& i : mEdgeProperties) delete i.second;
-	for (auto& i : mSurfaceProperties) delete i.second;
-	for (auto& i : mSpaceProperties) delete i.second;
+
+} // dtor()
+
+#ifdef SD_MODEL_HPP
+grammar::sd_context::sd_context(const spatial_design::cf_building& cf)
+:	mSDVertexRules(cf.cfVertices().size(), nullptr),
+	mSDLineRules(cf.cfLines().size(), nullptr),
+	mSDRectangleRules(cf.cfRectangles().size(), nullptr),
+	mSDCuboidRules(cf.cfCuboids().size(), nullptr)
+{ // leaves an empty entry for each entity
+
+} // ctor()
+
+grammar::sd_context::~sd_context()
+{
+	for (auto& i : mSDVertexRules) delete i;
+	for (auto& i : mSDLineRules) delete i;
+	for (auto& i : mSDRectangleRules) delete i;
+	for (auto& i : mSDCuboidRules) delete i;
+} // dtor()
+#endif
+
+#ifdef BSO_BP_MODEL_HPP
+grammar::bp_context::bp_context(const spatial_design::cf_building& cf)
+:	mBPSpaceRules(cf.cfSpaces().size(), nullptr),
+	mBPRectangleRules(cf.cfRectangles().size(), nullptr)
+{ // leaves an empty entry for each entity
+
+} // ctor()
+
+grammar::bp_context::~bp_context()
+{
+	for (auto& i : mBPSpaceRules) delete i;
+	for (auto& i : mBPRectangleRules) delete i;
 } // dtor()
+#endif
 	
 } // namespace grammar
 } // namespace bso
 
-#endif // BSO_GRAMMAR_CPP
\ No newline at end of file
+#endif // BSO_GRAMMAR_CPP
@@ -3,6 +3,18 @@
 
 #include <bso/spatial_design/cf_building.hpp>
 #include <bso/grammar/rule_set/rule_sets.hpp>
+#include <bso/utilities/instrumentation.hpp>
+
+#include <memory>
+#include <mutex>
+
+#ifdef SD_MODEL_HPP
+#include <bso/grammar/sd_grammar_settings.hpp>
+#endif
+
+#ifdef BSO_BP_MODEL_HPP
+#include <bso/grammar/bp_grammar_settings.hpp>
+#endif
 
 namespace bso { namespace grammar {
 
@@ -18,72 +30,85 @@ class DEFAULT_BP_GRAMMAR;
 class grammar
 {
 private:
+	// the conformal model and the properties are only read by the grammars, so
+	// multiple sd and bp grammars may run concurrently on one grammar instance
 	spatial_design::cf_building mCFBuilding;
 
-	// rule sets
-	std::map<spatial_design::conformal::cf_vertex*, rule_set::vertex_property*> mVertexProperties;
-	std::map<spatial_design::conformal::cf_line*, rule_set::line_property*> mLineProperties;
-	std::map<spatial_design::conformal::cf_rectangle*, rule_set::rectangle_property*> mRectangleProperties;
-	std::map<spatial_design::conformal::cf_cuboid*, rule_set::cuboid_property*> mCuboidProperties;
+	// properties, each list is indexed by the index() of the conformal entities
+	std::vector<rule_set::vertex_property> mVertexProperties;
+	std::vector<rule_set::line_property> mLineProperties;
+	std::vector<rule_set::rectangle_property> mRectangleProperties;
+	std::vector<rule_set::cuboid_property> mCuboidProperties;
 
-	std::map<spatial_design::conformal::cf_point*, rule_set::point_property*> mPointProperties;
-	std::map<spatial_design::conformal::cf_edge*, rule_set::edge_property*> mEdgeProperties;
-	std::map<spatial_design::conformal::cf_surface*, rule_set::surface_property*> mSurfaceProperties;
-	std::map<spatial_design::conformal::cf_space*, rule_set::space_property*> mSpaceProperties;
+	std::vector<rule_set::point_property> mPointProperties;
+	std::vector<rule_set::edge_property> mEdgeProperties;
+	std::vector<rule_set::surface_property> mSurfaceProperties;
+	std::vector<rule_set::space_property> mSpaceProperties;
 
 	#ifdef SD_MODEL_HPP
-	std::map<spatial_design::conformal::cf_vertex*, rule_set::sd_vertex_rule*> mSDVertexRules;
-	std::map<spatial_design::conformal::cf_line*, rule_set::sd_line_rule*> mSDLineRules;
-	std::map<spatial_design::conformal::cf_rectangle*, rule_set::sd_rectangle_rule*> mSDRectangleRules;
-	std::map<spatial_design::conformal::cf_cuboid*, rule_set::sd_cuboid_rule*> mSDCuboidRules;
+	struct sd_context
+	{ // state of a single sd_grammar call, rules are indexed like the properties,
+		// an entry is nullptr if no rule applies to that entity
+		std::vector<rule_set::sd_vertex_rule*> mSDVertexRules;
+		std::vector<rule_set::sd_line_rule*> mSDLineRules;
+		std::vector<rule_set::sd_rectangle_rule*> mSDRectangleRules;
+		std::vector<rule_set::sd_cuboid_rule*> mSDCuboidRules;
+
+		std::vector<structural_design::sd_model> mIntermediateSDModels;
+		std::vector<std::map<spatial_design::conformal::cf_rectangle*,
+			structural_design::component::structure> > mIntermediateSDAssignments;
+
+		sd_context(const spatial_design::cf_building& cf);
+		~sd_context();
+		sd_context(const sd_context&) = delete;
+		sd_context& operator=(const sd_context&) = delete;
+	};
 
-	structural_design::sd_model mSDModel;
 	std::vector<structural_design::sd_model> mIntermediateSDModels;
-	std::map<std::pair<std::string,std::string>,
-		structural_design::component::structure> mSDWallProperties;
-	std::map<std::pair<std::string,std::string>,
-		structural_design::component::structure> mSDFloorProperties;
-    std::map<std::string, structural_design::component::structure> mSDSpaceProperties;
-	structural_design::component::structure mLoadPanel;
-	std::multimap<std::string, structural_design::component::load> mLoads;
-	unsigned int mMeshSize = 1;
-
-	void mReadSDSettings(const std::string& fileName);
+	std::vector<std::map<spatial_design::conformal::cf_rectangle*,
+		structural_design::component::structure> > mIntermediateSDAssignments;
+	bool mStoreIntermediateSDModels = false;
+	std::unique_ptr<sd_context> mAssignmentContext; // rules kept between optimizer assignments, only structures are reassigned
+	std::shared_ptr<structural_design::low_rank_reanalysis> mReanalysis; // shared by the models of the optimizer assignments
 	#endif
 
 	#ifdef BSO_BP_MODEL_HPP
-	std::map<spatial_design::conformal::cf_space*, rule_set::bp_space_rule*> mBPSpaceRules;
-	std::map<spatial_design::conformal::cf_rectangle*, rule_set::bp_rectangle_rule*> mBPRectangleRules;
-
-	boost::posix_time::time_duration mBPWarmUpDuration;
-	boost::posix_time::time_duration mBPTimeStepSize;
-	double mBPGroundTemperature = 0;
-	std::map<std::string,boost::posix_time::time_period> mBPSimulationPeriods;
-	std::map<std::string,bso::building_physics::properties::space_settings> mBPSpaceSettings;
-	std::map<std::pair<std::string,std::string>,bso::building_physics::properties::construction> mBPWallConstructions;
-	std::map<std::pair<std::string,std::string>,bso::building_physics::properties::construction> mBPFloorConstructions;
-	std::map<std::pair<std::string,std::string>,bso::building_physics::properties::glazing> mBPWallGlazings;
-	std::map<std::pair<std::string,std::string>,bso::building_physics::properties::glazing> mBPFloorGlazings;
-
-	building_physics::bp_model mBPModel;
+	struct bp_context
+	{ // state of a single bp_grammar call, indexed like the properties
+		std::vector<rule_set::bp_space_rule*> mBPSpaceRules;
+		std::vector<rule_set::bp_rectangle_rule*> mBPRectangleRules;
+
+		bp_context(const spatial_design::cf_building& cf);
+		~bp_context();
+		bp_context(const bp_context&) = delete;
+		bp_context& operator=(const bp_context&) = delete;
+	};
+
 	std::vector<building_physics::bp_model> mIntermediateBPModels;
-	void mReadBPSettings(const std::string& fileName);
 	#endif
 
+	std::mutex mMutex; // guards the members above that are written by a grammar call
+
 public:
 	grammar(const spatial_design::cf_building& cf);
+	grammar(const grammar&) = delete;
+	grammar& operator=(const grammar&) = delete;
 	~grammar();
 
 	#ifdef SD_MODEL_HPP
 	template <typename T = DEFAULT_SD_GRAMMAR, typename...ARGS>
-	bso::structural_design::sd_model sd_grammar(const ARGS&...);
+	bso::structural_design::sd_model sd_grammar(const ARGS&...); // first argument is a settings file name or an sd_grammar_settings object
 	const std::vector<structural_design::sd_model>& getIntermediateSDModels() const
-		{return mIntermediateSDModels;}
+		{return mIntermediateSDModels;} // only stored if storeIntermediateSDModels() is set, of the last finished call
+	const std::vector<std::map<spatial_design::conformal::cf_rectangle*,
+		structural_design::component::structure> >& getIntermediateSDAssignments() const
+		{return mIntermediateSDAssignments;} // structure assigned to each rectangle rule, of the last finished call
+	bool& storeIntermediateSDModels() {return mStoreIntermediateSDModels;}
 	#endif
 
 	#ifdef BSO_BP_MODEL_HPP
 	template <typename T = DEFAULT_BP_GRAMMAR, typename...ARGS>
-	bso::building_physics::bp_model bp_grammar(const ARGS&...);
+	bso::building_physics::bp_model bp_grammar(const ARGS&...); // first argument is a settings file name or a bp_grammar_settings object
 	const std::vector<building_physics::bp_model> getIntermediateBPModels() const
 		{return mIntermediateBPModels;}
 	#endif
@@ -95,14 +120,12 @@ public:
 #include <bso/grammar/grammar.cpp>
 
 #ifdef SD_MODEL_HPP
-#include <bso/grammar/grammar_sd_specifics.cpp>
-#include <bso/grammar/sd_grammars/default_sd_grammar.cpp>
+#include <bso/grammar/sd_grammars/default_sd_grammar.cpp>
 #include <bso/grammar/sd_grammars/volume_sd_grammar.cpp>
 #endif
 
 #ifdef BSO_BP_MODEL_HPP
-#include <bso/grammar/grammar_bp_specifics.cpp>
 #include <bso/grammar/bp_grammars/default_bp_grammar.cpp>
 #endif
 
-#endif // BSO_GRAMMAR_HPP
+#endif // BSO_GRAMMAR_HPP
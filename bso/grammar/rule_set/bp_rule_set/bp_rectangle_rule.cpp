@@ -3,7 +3,7 @@
 
 namespace bso { namespace grammar { namespace rule_set { namespace bp_rule_set {
 
-bp_rectangle_rule::bp_rectangle_rule(rectangle_property* rectangleProperty)
+bp_rectangle_rule::bp_rectangle_rule(const rectangle_property* rectangleProperty)
 :	mConstruction(bso::building_physics::properties::construction("",{})),
 	mGlazing(bso::building_physics::properties::glazing("",1,1))
 {
@@ -9,7 +9,7 @@ namespace bso { namespace grammar { namespace rule_set { namespace bp_rule_set {
 class bp_rectangle_rule : public bp_rule_set
 {
 private:
-	rectangle_property* mRectangleProperty;
+	const rectangle_property* mRectangleProperty;
 	
 	bso::building_physics::properties::glazing mGlazing;
 	bso::building_physics::properties::construction mConstruction;
@@ -22,7 +22,7 @@ private:
 	bso::building_physics::state::ground_profile* mGroundProfile = nullptr;
 	bso::building_physics::state::weather_profile* mWeatherProfile = nullptr;
 public:
-	bp_rectangle_rule(rectangle_property* rectangleProperty);
+	bp_rectangle_rule(const rectangle_property* rectangleProperty);
 	~bp_rectangle_rule();
 	
 	void assignConstruction(const bso::building_physics::properties::construction& constr);
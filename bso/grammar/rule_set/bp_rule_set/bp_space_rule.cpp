@@ -3,7 +3,7 @@
 
 namespace bso { namespace grammar { namespace rule_set { namespace bp_rule_set {
 
-bp_space_rule::bp_space_rule(space_property* spaceProperty)
+bp_space_rule::bp_space_rule(const space_property* spaceProperty)
 :	mSpaceSettings(bso::building_physics::properties::space_settings("",0,0,0,1,0))
 {
 	mSpaceProperty = spaceProperty;
@@ -9,14 +9,14 @@ namespace bso { namespace grammar { namespace rule_set { namespace bp_rule_set {
 class bp_space_rule : public bp_rule_set
 {
 private:
-	space_property* mSpaceProperty;
+	const space_property* mSpaceProperty;
 	bool mSpaceSettingsAssigned = false;
 	bso::building_physics::properties::space_settings mSpaceSettings;
 	std::map<bso::spatial_design::conformal::cf_space*,
 		bso::building_physics::state::space*>* mSpaceStates = nullptr;
 	bso::building_physics::state::weather_profile* mWeatherProfile = nullptr;
 public:
-	bp_space_rule(space_property* spaceProperty);
+	bp_space_rule(const space_property* spaceProperty);
 	~bp_space_rule();
 	
 	void assignSettings(const bso::building_physics::properties::space_settings& settings);
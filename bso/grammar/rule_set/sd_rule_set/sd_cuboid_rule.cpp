@@ -3,7 +3,7 @@
 
 namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 
-sd_cuboid_rule::sd_cuboid_rule(cuboid_property* cuboidProperty)
+sd_cuboid_rule::sd_cuboid_rule(const cuboid_property* cuboidProperty)
 :   mCuboidProperty(cuboidProperty), mStructure(structural_design::component::structure())
 {
 
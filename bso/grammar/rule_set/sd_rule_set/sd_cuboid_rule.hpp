@@ -10,12 +10,12 @@ namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 class sd_cuboid_rule : public sd_rule_set
 {
 private:
-	cuboid_property* mCuboidProperty;
+	const cuboid_property* mCuboidProperty;
 
 	structural_design::component::structure mStructure;
 
 public:
-	sd_cuboid_rule(cuboid_property* cuboidProperty);
+	sd_cuboid_rule(const cuboid_property* cuboidProperty);
 	~sd_cuboid_rule();
 
 	void apply(bso::structural_design::sd_model& sd) const;
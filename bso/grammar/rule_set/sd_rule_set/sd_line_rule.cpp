@@ -3,7 +3,7 @@
 
 namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 
-sd_line_rule::sd_line_rule(line_property* lineProperty)
+sd_line_rule::sd_line_rule(const line_property* lineProperty)
 : mLineProperty(lineProperty), mStructure(structural_design::component::structure("none",{}))
 {
 	
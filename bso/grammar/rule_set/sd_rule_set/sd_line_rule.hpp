@@ -9,11 +9,11 @@ namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 class sd_line_rule : public sd_rule_set
 {
 private:
-	line_property* mLineProperty;
+	const line_property* mLineProperty;
 
 	structural_design::component::structure mStructure;
 public:
-	sd_line_rule(line_property* lineProperty);
+	sd_line_rule(const line_property* lineProperty);
 	~sd_line_rule();
 
 	void apply(bso::structural_design::sd_model& sd) const;
@@ -3,7 +3,7 @@
 
 namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 
-sd_rectangle_rule::sd_rectangle_rule(rectangle_property* rectangleProperty)
+sd_rectangle_rule::sd_rectangle_rule(const rectangle_property* rectangleProperty)
 :	mRectangleProperty(rectangleProperty), mStructure(structural_design::component::structure()),
 	mLoadPanel(structural_design::component::structure())
 {
@@ -229,7 +229,7 @@ void sd_rectangle_rule::assignLoadPanel(structural_design::component::structure
 	mLoadPanel.isVisible() = false;
 }
 
-void sd_rectangle_rule::addLoads(std::multimap<std::string, structural_design::component::load>* loads)
+void sd_rectangle_rule::addLoads(const std::multimap<std::string, structural_design::component::load>* loads)
 {
 	mLoads = loads;
 } // addLoads()
@@ -9,13 +9,13 @@ namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 class sd_rectangle_rule : public sd_rule_set
 {
 private:
-	rectangle_property* mRectangleProperty;
+	const rectangle_property* mRectangleProperty;
 	
-	std::multimap<std::string, structural_design::component::load>* mLoads = nullptr;
+	const std::multimap<std::string, structural_design::component::load>* mLoads = nullptr;
 	structural_design::component::structure mStructure;
 	structural_design::component::structure mLoadPanel;
 public:
-	sd_rectangle_rule(rectangle_property* rectangleProperty);
+	sd_rectangle_rule(const rectangle_property* rectangleProperty);
 	~sd_rectangle_rule();
 
 	void apply(bso::structural_design::sd_model& sd) const;
@@ -23,7 +23,7 @@ public:
 	void assignStructure(const std::vector<structural_design::component::structure>&
 				potentialStructure);
 	void assignLoadPanel(structural_design::component::structure loadPanel);
-	void addLoads(std::multimap<std::string, structural_design::component::load>* loads);
+	void addLoads(const std::multimap<std::string, structural_design::component::load>* loads);
 	const structural_design::component::structure& getStructure() const {return mStructure;}
 };
 	
@@ -3,7 +3,7 @@
 
 namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 
-sd_vertex_rule::sd_vertex_rule(vertex_property* vertexProperty)
+sd_vertex_rule::sd_vertex_rule(const vertex_property* vertexProperty)
 : mVertexProperty(vertexProperty)
 {
 	
@@ -9,10 +9,10 @@ namespace bso { namespace grammar { namespace rule_set { namespace sd_rule_set {
 class sd_vertex_rule : public sd_rule_set
 {
 private:
-	vertex_property* mVertexProperty;
+	const vertex_property* mVertexProperty;
 
 public:
-	sd_vertex_rule(vertex_property* vertexProperty);
+	sd_vertex_rule(const vertex_property* vertexProperty);
 	~sd_vertex_rule();
 
 	void apply(bso::structural_design::sd_model& sd) const;
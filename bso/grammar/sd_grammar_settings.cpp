@@ -1,9 +1,11 @@
-#ifndef BSO_GRAMMAR_SD_SPECIFICS_CPP
-#define BSO_GRAMMAR_SD_SPECIFICS_CPP
+#ifndef BSO_GRAMMAR_SD_GRAMMAR_SETTINGS_CPP
+#define BSO_GRAMMAR_SD_GRAMMAR_SETTINGS_CPP
 
 #include <bso/utilities/trim_and_cast.hpp>
+#include <bso/grammar/settings_cache.hpp>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/tokenizer.hpp>
 
 #include <fstream>
 #include <stdexcept>
@@ -11,27 +13,44 @@
 
 namespace bso { namespace grammar {
 
-void grammar::mReadSDSettings(const std::string& fileName)
+sd_grammar_settings::sd_grammar_settings(const std::string& fileName)
+:	mFileName(fileName)
 {
 	std::fstream input(fileName.c_str());
 	if (!input.is_open())
 	{
 		std::stringstream errorMessage;
 		errorMessage << "\nCould not read SD grammar settings, failed to open file:"
-								 << fileName << "\n(bso/grammar/grammar_sd_specifics.cpp)" << std::endl;
+								 << fileName << "\n(bso/grammar/sd_grammar_settings.cpp)" << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
+	this->mReadSettings(input);
+	input.close();
+} // ctor()
+
+sd_grammar_settings::sd_grammar_settings(std::istream& input)
+{
+	this->mReadSettings(input);
+} // ctor()
 
-	mSDWallProperties.clear();
-	mSDFloorProperties.clear();
-	mLoadPanel = structural_design::component::structure();
-	mLoads.clear();
+sd_grammar_settings::~sd_grammar_settings()
+{
+
+} // dtor()
+
+std::shared_ptr<const sd_grammar_settings> sd_grammar_settings::read(const std::string& fileName)
+{
+	return read_settings<sd_grammar_settings>(fileName);
+} // read()
+
+void sd_grammar_settings::mReadSettings(std::istream& input)
+{
 	std::map<std::pair<std::string,std::string>,std::pair<std::string,std::string> > wallStructureIDs;
-	std::map<std::pair<std::string,std::string>,std::pair<std::string,std::string> > floorStructureIDs;
+	std::map<std::pair<std::string,std::string>,std::pair<std::string,std::string> > floorStructureIDs;
 	std::map<std::string,std::pair<std::string,std::string> > spaceStructureIDs;
 	std::map<std::string,structural_design::component::structure> flatShellStructures;
 	std::map<std::string,structural_design::component::structure> beamStructures;
-	std::map<std::string,structural_design::component::structure> trussStructures;
+	std::map<std::string,structural_design::component::structure> trussStructures;
 	std::map<std::string,structural_design::component::structure> quadhexStructures;
 
 	std::string line;
@@ -193,7 +212,7 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			auto flatShellSearch = flatShellStructures.find(i.second.second);
 			if (flatShellSearch != flatShellStructures.end())
 			{
-				mSDWallProperties[i.first] = flatShellSearch->second;
+				mWallProperties[i.first] = flatShellSearch->second;
 				foundMatch = true;
 			}
 		}
@@ -202,7 +221,7 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			auto beamSearch = beamStructures.find(i.second.second);
 			if (beamSearch != beamStructures.end())
 			{
-				mSDWallProperties[i.first] = beamSearch->second;
+				mWallProperties[i.first] = beamSearch->second;
 				foundMatch = true;
 			}
 		}
@@ -211,14 +230,14 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			auto trussSearch = trussStructures.find(i.second.second);
 			if (trussSearch != trussStructures.end())
 			{
-				mSDWallProperties[i.first] = trussSearch->second;
+				mWallProperties[i.first] = trussSearch->second;
 				foundMatch = true;
 			}
 		}
 		else if (i.second.first == "none")
 		{ // do nothing
 			foundMatch = true;
-			mSDWallProperties[i.first] = structural_design::component::structure();
+			mWallProperties[i.first] = structural_design::component::structure();
 		}
 		if (!foundMatch)
 		{
@@ -226,7 +245,7 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			errorMessage << "\nError, when reading SD grammar settings, could not find\n"
 									 << "the wall properties for the following structural type and type ID:\n"
 									 << "\"" << i.second.first << "\" - \"" << i.second.second << "\"\n"
-									 << "(bso/grammar/grammar_sd_specifics.cpp)" << std::endl;
+									 << "(bso/grammar/sd_grammar_settings.cpp)" << std::endl;
 			throw std::runtime_error(errorMessage.str());
 		}
 	}
@@ -239,7 +258,7 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			auto flatShellSearch = flatShellStructures.find(i.second.second);
 			if (flatShellSearch != flatShellStructures.end())
 			{
-				mSDFloorProperties[i.first] = flatShellSearch->second;
+				mFloorProperties[i.first] = flatShellSearch->second;
 				foundMatch = true;
 			}
 		}
@@ -248,7 +267,7 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			auto beamSearch = beamStructures.find(i.second.second);
 			if (beamSearch != beamStructures.end())
 			{
-				mSDFloorProperties[i.first] = beamSearch->second;
+				mFloorProperties[i.first] = beamSearch->second;
 				foundMatch = true;
 			}
 		}
@@ -257,14 +276,14 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			auto trussSearch = trussStructures.find(i.second.second);
 			if (trussSearch != trussStructures.end())
 			{
-				mSDFloorProperties[i.first] = trussSearch->second;
+				mFloorProperties[i.first] = trussSearch->second;
 				foundMatch = true;
 			}
 		}
 		else if (i.second.first == "none")
 		{ // do nothing
 			foundMatch = true;
-			mSDFloorProperties[i.first] = structural_design::component::structure();
+			mFloorProperties[i.first] = structural_design::component::structure();
 		}
 		if (!foundMatch)
 		{
@@ -272,11 +291,11 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			errorMessage << "\nError, when reading SD grammar settings, could not find\n"
 									 << "the floor properties for the following structural type and type ID:\n"
 									 << "\"" << i.second.first << "\" - \"" << i.second.second << "\"\n"
-									 << "(bso/grammar/grammar_sd_specifics.cpp)" << std::endl;
+									 << "(bso/grammar/sd_grammar_settings.cpp)" << std::endl;
 			throw std::runtime_error(errorMessage.str());
 		}
-	}
-
+	}
+
 	for (const auto& i : spaceStructureIDs)
 	{
 		bool foundMatch = false;
@@ -285,7 +304,7 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			auto quadhexSearch = quadhexStructures.find(i.second.second);
 			if (quadhexSearch != quadhexStructures.end())
 			{
-				mSDSpaceProperties[i.first] = quadhexSearch->second;
+				mSpaceProperties[i.first] = quadhexSearch->second;
 				foundMatch = true;
 			}
 		}
@@ -295,15 +314,13 @@ void grammar::mReadSDSettings(const std::string& fileName)
 			errorMessage << "\nError, when reading SD grammar settings, could not find\n"
 									 << "the space properties for the following structural type and type ID:\n"
 									 << "\"" << i.second.first << "\" - \"" << i.second.second << "\"\n"
-									 << "(bso/grammar/grammar_sd_specifics.cpp)" << std::endl;
+									 << "(bso/grammar/sd_grammar_settings.cpp)" << std::endl;
 			throw std::runtime_error(errorMessage.str());
 		}
 	}
-
-	input.close();
-} // mReadSDSettings()
+} // mReadSettings()
 
 } // namespace grammar
 } // namespace bso
 
-#endif // BSO_GRAMMAR_SD_SPECIFICS_CPP
+#endif // BSO_GRAMMAR_SD_GRAMMAR_SETTINGS_CPP
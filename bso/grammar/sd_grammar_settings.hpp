@@ -0,0 +1,51 @@
+#ifndef BSO_GRAMMAR_SD_GRAMMAR_SETTINGS_HPP
+#define BSO_GRAMMAR_SD_GRAMMAR_SETTINGS_HPP
+
+#include <bso/structural_design/sd_model.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <istream>
+
+namespace bso { namespace grammar {
+
+class sd_grammar_settings
+{ // parsed SD grammar settings, not modified after construction so one instance can be shared by many grammars
+private:
+	std::string mFileName;
+	std::map<std::pair<std::string,std::string>,
+		structural_design::component::structure> mWallProperties;
+	std::map<std::pair<std::string,std::string>,
+		structural_design::component::structure> mFloorProperties;
+	std::map<std::string, structural_design::component::structure> mSpaceProperties;
+	structural_design::component::structure mLoadPanel;
+	std::multimap<std::string, structural_design::component::load> mLoads;
+	unsigned int mMeshSize = 1;
+
+	void mReadSettings(std::istream& input);
+public:
+	sd_grammar_settings(const std::string& fileName);
+	sd_grammar_settings(std::istream& input);
+	~sd_grammar_settings();
+
+	static std::shared_ptr<const sd_grammar_settings> read(const std::string& fileName); // cached by path and modification time
+
+	const std::string& getFileName() const {return mFileName;} // empty if read from a stream
+	const std::map<std::pair<std::string,std::string>,
+		structural_design::component::structure>& getWallProperties() const {return mWallProperties;}
+	const std::map<std::pair<std::string,std::string>,
+		structural_design::component::structure>& getFloorProperties() const {return mFloorProperties;}
+	const std::map<std::string, structural_design::component::structure>& getSpaceProperties() const
+		{return mSpaceProperties;}
+	const structural_design::component::structure& getLoadPanel() const {return mLoadPanel;}
+	const std::multimap<std::string, structural_design::component::load>& getLoads() const {return mLoads;}
+	unsigned int getMeshSize() const {return mMeshSize;}
+};
+
+} // namespace grammar
+} // namespace bso
+
+#include <bso/grammar/sd_grammar_settings.cpp>
+
+#endif // BSO_GRAMMAR_SD_GRAMMAR_SETTINGS_HPP
@@ -7,36 +7,37 @@
 namespace bso { namespace grammar {
 	
 template <>
-bso::structural_design::sd_model grammar::sd_grammar<DEFAULT_SD_GRAMMAR>(const std::string& fileName,
+bso::structural_design::sd_model grammar::sd_grammar<DEFAULT_SD_GRAMMAR>(const sd_grammar_settings& settings,
 	const bool& useSurfaceTypeInsteadOfSpaceType)
 {
+	BSO_SCOPED_TIMER("grammar_sd");
 	// initialize a new SD model
-	mSDModel = bso::structural_design::sd_model();
-	// read the structural design settings
-	this->mReadSDSettings(fileName);
+	bso::structural_design::sd_model mSDModel;
+	// the rules of this call, deleted when it returns
+	sd_context context(mCFBuilding);
 
 	for (const auto& i : mRectangleProperties)
 	{
-		if (i.second->isSpaceSeparating())
+		if (i.isSpaceSeparating())
 		{
 			// get the space or surface types, depending on the settings
-			std::pair<std::string, std::string> usedTypes = i.second->getSpaceTypes();
-			if (useSurfaceTypeInsteadOfSpaceType) usedTypes = i.second->getSurfaceTypes();
+			std::pair<std::string, std::string> usedTypes = i.getSpaceTypes();
+			if (useSurfaceTypeInsteadOfSpaceType) usedTypes = i.getSurfaceTypes();
 			
 			// determine the structural type and properties of the rectangle
 			bool structureFound = false;
-			auto structureSearch = mSDFloorProperties.find(usedTypes);
-			if (i.second->isFloor())
+			auto structureSearch = settings.getFloorProperties().find(usedTypes);
+			if (i.isFloor())
 			{
-				if (structureSearch != mSDFloorProperties.end())
+				if (structureSearch != settings.getFloorProperties().end())
 				{
 					structureFound = true;
 				}
 			}
-			else if (i.second->isWall())
+			else if (i.isWall())
 			{
-				structureSearch = mSDWallProperties.find(usedTypes);
-				if (structureSearch != mSDWallProperties.end())
+				structureSearch = settings.getWallProperties().find(usedTypes);
+				if (structureSearch != settings.getWallProperties().end())
 				{
 					structureFound = true;
 				}
@@ -47,74 +48,85 @@ bso::structural_design::sd_model grammar::sd_grammar<DEFAULT_SD_GRAMMAR>(const s
 				errorMessage << "\nError, in default grammar could not find the specified\n"
 										 << "type settings: \"" << usedTypes.first << "\" - \"" 
 										 << usedTypes.second << "\" ("
-										 << ((i.second->isFloor())? "floor" : "wall") << ")\n"
+										 << ((i.isFloor())? "floor" : "wall") << ")\n"
 										 << "Has this type set been specified in the inputfile?: \""
-										 << fileName << "\"\n(bso/grammar/sd_grammars/default_sd_grammar.cpp)" 
+										 << settings.getFileName() << "\"\n(bso/grammar/sd_grammars/default_sd_grammar.cpp)" 
 										 << std::endl;
 				throw std::runtime_error(errorMessage.str());
 			}
 
 			// create a rectangle rule set
-			auto sdRectangleRuleSet = new rule_set::sd_rectangle_rule(i.second);
-			mSDRectangleRules[i.first] = sdRectangleRuleSet;
+			auto sdRectangleRuleSet = new rule_set::sd_rectangle_rule(&i);
+			context.mSDRectangleRules[i.getRectanglePtr()->index()] = sdRectangleRuleSet;
 			if (structureSearch->second.type() != "none")
 			{
 				sdRectangleRuleSet->assignStructure(structureSearch->second);
 			}
-			sdRectangleRuleSet->assignLoadPanel(mLoadPanel);
-			sdRectangleRuleSet->addLoads(&mLoads);
+			sdRectangleRuleSet->assignLoadPanel(settings.getLoadPanel());
+			sdRectangleRuleSet->addLoads(&settings.getLoads());
 		}
 	}
 	// find each line that is associated to a rectangle that has a rectangle rule set
-	for (const auto& i : mSDRectangleRules)
+	for (const auto& i : mCFBuilding.cfRectangles())
 	{ // for each sd rectangle rule
-		for (const auto& j : i.first->cfLines())
+		if (context.mSDRectangleRules[i->index()] == nullptr) continue;
+		for (const auto& j : i->cfLines())
 		{ // for each line associated to the rectangle associated to the rectangle rule
-			if (mSDLineRules.find(j) == mSDLineRules.end());
+			if (context.mSDLineRules[j->index()] == nullptr)
 			{ // if it has not yet been added to the vector, add it
-				mSDLineRules[j] = new rule_set::sd_line_rule(mLineProperties[j]);
+				context.mSDLineRules[j->index()] = new rule_set::sd_line_rule(&mLineProperties[j->index()]);
 			}
 		}
 	}
 
-	for (auto& i : mSDLineRules)
+	for (const auto& i : mCFBuilding.cfLines())
 	{ // for each sd line rule
+		if (context.mSDLineRules[i->index()] == nullptr) continue;
 		// find the potential structural types from all the possible sd rectangle rules this
 		// line rule may be associated with
 		std::vector<structural_design::component::structure> potentialStructures;
-		for (const auto& j : i.first->cfRectangles())
+		for (const auto& j : i->cfRectangles())
 		{ // for each rectangle that this line is associated with
-			auto SDRectangleRuleSearch = mSDRectangleRules.find(j);
-			if (SDRectangleRuleSearch != mSDRectangleRules.end())
+			if (context.mSDRectangleRules[j->index()] != nullptr)
 			{ // if that rectangle is accociated with an sd rectangle rule, store its structural type
-				potentialStructures.push_back(SDRectangleRuleSearch->second->getStructure());
+				potentialStructures.push_back(context.mSDRectangleRules[j->index()]->getStructure());
 			}
 		}
 
 		// pass the potential structural types to the sd line rule
-		i.second->assignStructure(potentialStructures);
+		context.mSDLineRules[i->index()]->assignStructure(potentialStructures);
 	}
 	for (const auto& i : mVertexProperties)
 	{
-		if (i.second->isSpaceCorner())
+		if (i.isSpaceCorner())
 		{
-			mSDVertexRules[i.first] = new rule_set::sd_vertex_rule(i.second);
+			context.mSDVertexRules[i.getVertexPtr()->index()] = new rule_set::sd_vertex_rule(&i);
 		}
 	}
 	
-	for (const auto& i : mSDVertexRules) i.second->apply(mSDModel);
-	for (const auto& i : mSDLineRules) i.second->apply(mSDModel);
-	for (const auto& i : mSDRectangleRules) i.second->apply(mSDModel);
-	mSDModel.setMeshSize(mMeshSize);
+	for (const auto& i : context.mSDVertexRules) if (i != nullptr) i->apply(mSDModel);
+	for (const auto& i : context.mSDLineRules) if (i != nullptr) i->apply(mSDModel);
+	for (const auto& i : context.mSDRectangleRules) if (i != nullptr) i->apply(mSDModel);
+	mSDModel.setMeshSize(settings.getMeshSize());
 	
-	// delete the rules
-	for (auto& i : mSDVertexRules) delete i.second;
-	for (auto& i : mSDLineRules) delete i.second;
-	for (auto& i : mSDRectangleRules) delete i.second;
 	
 	return mSDModel;
 } // default_sd_grammar
 
+template <>
+structural_design::sd_model grammar::sd_grammar<DEFAULT_SD_GRAMMAR>(const sd_grammar_settings& settings)
+{
+	return this->sd_grammar<DEFAULT_SD_GRAMMAR>(settings,false);
+}
+
+template <>
+structural_design::sd_model grammar::sd_grammar<DEFAULT_SD_GRAMMAR>(const std::string& fileName,
+	const bool& useSurfaceTypeInsteadOfSpaceType)
+{ // the settings file is only parsed again when it has been modified
+	return this->sd_grammar<DEFAULT_SD_GRAMMAR>(*sd_grammar_settings::read(fileName),
+		useSurfaceTypeInsteadOfSpaceType);
+}
+
 template <>
 structural_design::sd_model grammar::sd_grammar<DEFAULT_SD_GRAMMAR>(const std::string& fileName)
 {
@@ -4,13 +4,14 @@
 #include <bso/utilities/clustering.hpp>
 #include <stdexcept>
 #include <sstream>
+#include <set>
 
 namespace bso { namespace grammar {
 class DESIGN_RESPONSE;
 
 template <>
 bso::structural_design::sd_model grammar::sd_grammar<DESIGN_RESPONSE>(
-	const std::string& fileName,
+	const sd_grammar_settings& settings,
 	const double& etaBend,
 	const double& etaAx,
 	const double& etaShear,
@@ -22,39 +23,46 @@ bso::structural_design::sd_model grammar::sd_grammar<DESIGN_RESPONSE>(
 	const bso::structural_design::component::structure& flatShellStructure,
 	const bso::structural_design::component::structure& substituteStructure)
 {
+	BSO_SCOPED_TIMER("grammar_sd");
 	// initialize a new SD model
-	mSDModel = bso::structural_design::sd_model();
+	bso::structural_design::sd_model mSDModel;
+	// consecutive models only differ in the rectangles that were substituted, so they are solved
+	// by low rank updates of the system that was factored last
+	auto reanalysis = std::make_shared<bso::structural_design::low_rank_reanalysis>();
+	mSDModel.setReanalysis(reanalysis);
+	// the rules of this call, deleted when it returns
+	sd_context context(mCFBuilding);
+	bool storeIntermediateSDModels = mStoreIntermediateSDModels;
 	
 	//variable to store initial mean of the total design response
-	double initMeanTot;
+	double initMeanTot = 0.0;
 
-	// read the structural design settings
-	this->mReadSDSettings(fileName);
 
 	// assign substitute type to rectangles
+	std::map<bso::spatial_design::conformal::cf_rectangle*, rule_set::sd_rectangle_rule*> subRectangles;
 	for (const auto& i : mRectangleProperties)
 	{
-		if (i.second->isSpaceSeparating())
+		if (i.isSpaceSeparating())
 		{
 			// create a rectangle rule set
-			auto sdRectangleRuleSet = new rule_set::sd_rectangle_rule(i.second);
-			mSDRectangleRules[i.first] = sdRectangleRuleSet;
+			auto sdRectangleRuleSet = new rule_set::sd_rectangle_rule(&i);
+			context.mSDRectangleRules[i.getRectanglePtr()->index()] = sdRectangleRuleSet;
+			subRectangles[i.getRectanglePtr()] = sdRectangleRuleSet;
 			sdRectangleRuleSet->assignStructure(substituteStructure);
-			sdRectangleRuleSet->assignLoadPanel(mLoadPanel);
-			sdRectangleRuleSet->addLoads(&mLoads);
+			sdRectangleRuleSet->assignLoadPanel(settings.getLoadPanel());
+			sdRectangleRuleSet->addLoads(&settings.getLoads());
 		}
 	}
-	auto subRectangles = mSDRectangleRules;
 	int initSubNumber = subRectangles.size();
 	
 	// find each line that is associated to a rectangle that has a rectangle rule set
-	for (const auto& i : mSDRectangleRules)
+	for (const auto& i : subRectangles)
 	{ // for each sd rectangle rule
 		for (const auto& j : i.first->cfLines())
 		{ // for each line associated to the rectangle associated to the rectangle rule
-			if (mSDLineRules.find(j) == mSDLineRules.end());
+			if (context.mSDLineRules[j->index()] == nullptr)
 			{ // if it has not yet been added to the vector, add it
-				mSDLineRules[j] = new rule_set::sd_line_rule(mLineProperties[j]);
+				context.mSDLineRules[j->index()] = new rule_set::sd_line_rule(&mLineProperties[j->index()]);
 			}
 		}
 	}
@@ -62,25 +70,42 @@ bso::structural_design::sd_model grammar::sd_grammar<DESIGN_RESPONSE>(
 	// initialize vertex rules
 	for (const auto& i : mVertexProperties)
 	{
-		if (i.second->isSpaceCorner())
+		if (i.isSpaceCorner())
 		{
-			mSDVertexRules[i.first] = new rule_set::sd_vertex_rule(i.second);
+			context.mSDVertexRules[i.getVertexPtr()->index()] = new rule_set::sd_vertex_rule(&i);
 		}
 	}
 
+	bool lineStructuresAssigned = false;
+	bool modelIsCurrent = false; // true if no rectangle changed since the last analysis
 	for (int i = 0; i < etaConverge + 1; ++i)
 	{
-		// execute rectangle and line rules
-		for (const auto& j : mSDVertexRules) j.second->apply(mSDModel);
-		for (const auto& j : mSDLineRules) j.second->apply(mSDModel);
-		for (const auto& j : mSDRectangleRules) j.second->apply(mSDModel);
-		mSDModel.setMeshSize(mMeshSize);
+		if (!modelIsCurrent)
+		{
+			// execute rectangle and line rules
+			for (const auto& j : context.mSDVertexRules) if (j != nullptr) j->apply(mSDModel);
+			for (const auto& j : context.mSDLineRules) if (j != nullptr) j->apply(mSDModel);
+			for (const auto& j : context.mSDRectangleRules) if (j != nullptr) j->apply(mSDModel);
+			mSDModel.setMeshSize(settings.getMeshSize());
+		}
 		
 		// check if the grammar has finished, if so, further evaluation is not needed
 		if (i == etaConverge) break;
 		
-		// evaluate SD model
-		mSDModel.analyze();
+		// evaluate SD model, unless it has already been analyzed in its current state
+		if (!modelIsCurrent) mSDModel.analyze("Reanalysis");
+		
+		// store the assignment of this iteration, which is much smaller than the model itself
+		std::map<spatial_design::conformal::cf_rectangle*,
+			structural_design::component::structure> assignment;
+		for (const auto& j : mCFBuilding.cfRectangles())
+		{
+			if (context.mSDRectangleRules[j->index()] != nullptr)
+			{
+				assignment[j] = context.mSDRectangleRules[j->index()]->getStructure();
+			}
+		}
+		context.mIntermediateSDAssignments.push_back(assignment);
 		
 		std::map<bso::spatial_design::conformal::cf_rectangle*, bso::structural_design::sd_results> subResults;
 		std::vector<bso::utilities::data_point> resultData;
@@ -127,6 +152,7 @@ bso::structural_design::sd_model grammar::sd_grammar<DESIGN_RESPONSE>(
 		}
 		
 		// substitute the substitute rectangles
+		std::vector<bso::spatial_design::conformal::cf_rectangle*> substitutedRectangles;
 		while (targetSubNumber < subRectangles.size())
 		{
 			// inventory the rectangles that must be substituted
@@ -244,6 +270,7 @@ bso::structural_design::sd_model grammar::sd_grammar<DESIGN_RESPONSE>(
 			// remove the rectangles that have been substituted from subRectangles and subResults
 			for (const auto& j : mustSubstitute)
 			{
+				substitutedRectangles.push_back(j);
 				subRectangles.erase(j);
 				subResults.erase(j);
 			}
@@ -251,41 +278,74 @@ bso::structural_design::sd_model grammar::sd_grammar<DESIGN_RESPONSE>(
 
 		}
 		
-		// check consequences of substitution for line rules
-		for (auto& i : mSDLineRules)
+		// check consequences of substitution for line rules, after the first assignment
+		// only the lines of rectangles that have been substituted can change
+		std::set<spatial_design::conformal::cf_line*> changedLines;
+		for (const auto& j : substitutedRectangles)
+		{
+			for (const auto& k : j->cfLines()) changedLines.insert(k);
+		}
+		for (const auto& i : mCFBuilding.cfLines())
 		{ // for each sd line rule
+			if (context.mSDLineRules[i->index()] == nullptr) continue;
+			if (lineStructuresAssigned && changedLines.find(i) == changedLines.end()) continue;
 			// find the potential structural types from all the possible sd rectangle rules this
 			// line rule may be associated with
 			std::vector<structural_design::component::structure> potentialStructures;
-			for (const auto& j : i.first->cfRectangles())
+			for (const auto& j : i->cfRectangles())
 			{ // for each rectangle that this line is associated with
-				auto SDRectangleRuleSearch = mSDRectangleRules.find(j);
-				if (SDRectangleRuleSearch != mSDRectangleRules.end())
+				if (context.mSDRectangleRules[j->index()] != nullptr)
 				{ // if that rectangle is associated with an sd rectangle rule, store its structural type
-					potentialStructures.push_back(SDRectangleRuleSearch->second->getStructure());
+					potentialStructures.push_back(context.mSDRectangleRules[j->index()]->getStructure());
 				}
 			}
 
 			// pass the potential structural types to the sd line rule
-			i.second->assignStructure(potentialStructures);
+			context.mSDLineRules[i->index()]->assignStructure(potentialStructures);
 		}
+		lineStructuresAssigned = true;
 		
 		// check convergence
 		if (i != etaConverge) 
 		{ // if there is still an iteration coming, store the model as intermediate
-			mIntermediateSDModels.push_back(mSDModel);
-			mSDModel = bso::structural_design::sd_model();
+			if (storeIntermediateSDModels) context.mIntermediateSDModels.push_back(mSDModel);
+			modelIsCurrent = substitutedRectangles.empty();
+			if (!modelIsCurrent)
+			{
+				mSDModel = bso::structural_design::sd_model();
+				mSDModel.setReanalysis(reanalysis);
+			}
 		}
 	}
 	
-	// delete the rules
-	for (auto& i : mSDVertexRules) delete i.second;
-	for (auto& i : mSDLineRules) delete i.second;
-	for (auto& i : mSDRectangleRules) delete i.second;
+	{ // the intermediate results of this call replace those of the previous call
+		std::lock_guard<std::mutex> lock(mMutex);
+		mIntermediateSDModels = std::move(context.mIntermediateSDModels);
+		mIntermediateSDAssignments = std::move(context.mIntermediateSDAssignments);
+	}
 	
 	return mSDModel;
 } // default_sd_grammar
 
+template <>
+bso::structural_design::sd_model grammar::sd_grammar<DESIGN_RESPONSE>(
+	const std::string& fileName,
+	const double& etaBend,
+	const double& etaAx,
+	const double& etaShear,
+	const double& etaNoise,
+	const int& etaConverge,
+	const std::string& checkingOrder,
+	const bso::structural_design::component::structure& trussStructure,
+	const bso::structural_design::component::structure& beamStructure,
+	const bso::structural_design::component::structure& flatShellStructure,
+	const bso::structural_design::component::structure& substituteStructure)
+{ // the settings file is only parsed again when it has been modified
+	return this->sd_grammar<DESIGN_RESPONSE>(*sd_grammar_settings::read(fileName),
+		etaBend, etaAx, etaShear, etaNoise, etaConverge, checkingOrder,
+		trussStructure, beamStructure, flatShellStructure, substituteStructure);
+}
+
 } // namespace grammar
 } // namespace bso
 
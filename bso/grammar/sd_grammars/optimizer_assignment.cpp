@@ -10,67 +10,109 @@ class OPTIMIZER_ASSIGNMENT;
 
 template <>
 bso::structural_design::sd_model grammar::sd_grammar<OPTIMIZER_ASSIGNMENT>(
-	const std::string& fileName,
+	const sd_grammar_settings& settings,
 	const std::string& gaDesign,
 	const bso::structural_design::component::structure& trussStructure,
 	const bso::structural_design::component::structure& beamStructure,
 	const bso::structural_design::component::structure& flatShellStructure)
 {
+	BSO_SCOPED_TIMER("grammar_sd");
 	// initialize a new SD model
-	mSDModel = bso::structural_design::sd_model();
+	bso::structural_design::sd_model mSDModel;
 	
-	// read the structural design settings
-	this->mReadSDSettings(fileName);
-
-	// initialize rectangle rules
-	for (const auto& i : mRectangleProperties)
+	// the rules only depend on the conformal building, they are created once and then
+	// reused by every following assignment on this grammar. A call takes the kept rules,
+	// so that concurrent assignments each work on their own rules
+	std::unique_ptr<sd_context> contextPtr;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		contextPtr = std::move(mAssignmentContext);
+	}
+	
+	if (contextPtr == nullptr)
 	{
-		if (i.second->isSpaceSeparating())
+		contextPtr.reset(new sd_context(mCFBuilding));
+		sd_context& context = *contextPtr;
+		
+		// initialize rectangle rules
+		for (const auto& i : mRectangleProperties)
 		{
-			// create a rectangle rule set
-			auto sdRectangleRuleSet = new rule_set::sd_rectangle_rule(i.second);
-			mSDRectangleRules[i.first] = sdRectangleRuleSet;
-			sdRectangleRuleSet->assignLoadPanel(mLoadPanel);
-			sdRectangleRuleSet->addLoads(&mLoads);
+			if (i.isSpaceSeparating())
+			{
+				context.mSDRectangleRules[i.getRectanglePtr()->index()] = new rule_set::sd_rectangle_rule(&i);
+			}
+		}
+		
+		// find each line that is associated to a rectangle that has a rectangle rule set
+		for (const auto& i : mCFBuilding.cfRectangles())
+		{ // for each sd rectangle rule
+			if (context.mSDRectangleRules[i->index()] == nullptr) continue;
+			for (const auto& j : i->cfLines())
+			{ // for each line associated to the rectangle associated to the rectangle rule
+				if (context.mSDLineRules[j->index()] == nullptr)
+				{ // if it has not yet been added to the vector, add it
+					context.mSDLineRules[j->index()] = new rule_set::sd_line_rule(&mLineProperties[j->index()]);
+				}
+			}
+		}
+		
+		// initialize vertex rules
+		for (const auto& i : mVertexProperties)
+		{
+			if (i.isSpaceCorner())
+			{
+				context.mSDVertexRules[i.getVertexPtr()->index()] = new rule_set::sd_vertex_rule(&i);
+			}
 		}
 	}
+	sd_context& context = *contextPtr;
+	
+	// the settings may differ per call, so loads are passed to the rules every time
+	std::vector<rule_set::sd_rectangle_rule*> assignedRules;
+	for (auto& i : context.mSDRectangleRules)
+	{
+		if (i == nullptr) continue;
+		i->assignLoadPanel(settings.getLoadPanel());
+		i->addLoads(&settings.getLoads());
+		assignedRules.push_back(i);
+	}
 	
 	// check if the number of passed arguments is correct
-	if (gaDesign.size() != mSDRectangleRules.size())
+	if (gaDesign.size() != assignedRules.size())
 	{
 		std::stringstream errorMessage;
 		errorMessage << "\nError, when running the design via optimizer assignment.\n"
 								 << "Number of input variables: << " << gaDesign.size()
 								 << "\ndoes not match number of eligible rectangles in conformal model: "
-								 << mSDRectangleRules.size() << "\n"
+								 << assignedRules.size() << "\n"
 								 << "(bso/grammar/sd_grammar/optimizer_assignment.cpp)" << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
 	
 	// assign each rectangle rule the assigned type
 	auto variableIterator = gaDesign.begin();
-	for (auto& i : mSDRectangleRules)
+	for (auto& i : assignedRules)
 	{
 		switch(*variableIterator)
 		{
 			case '1':
 			{ // no structure
-				i.second->assignStructure(bso::structural_design::component::structure());
+				i->assignStructure(bso::structural_design::component::structure());
 				break;
 			}
 			case '2':
 			{ // trusses
-				i.second->assignStructure(trussStructure);
+				i->assignStructure(trussStructure);
 				break;
 			}
 			case '3':
 			{ // beams
-				i.second->assignStructure(beamStructure);
+				i->assignStructure(beamStructure);
 				break;
 			}
 			case '4':
 			{ // flat shells
-				i.second->assignStructure(flatShellStructure);
+				i->assignStructure(flatShellStructure);
 				break;
 			}
 			default:
@@ -86,60 +128,55 @@ bso::structural_design::sd_model grammar::sd_grammar<OPTIMIZER_ASSIGNMENT>(
 		++variableIterator;
 	}
 	
-	// find each line that is associated to a rectangle that has a rectangle rule set
-	for (const auto& i : mSDRectangleRules)
-	{ // for each sd rectangle rule
-		for (const auto& j : i.first->cfLines())
-		{ // for each line associated to the rectangle associated to the rectangle rule
-			if (mSDLineRules.find(j) == mSDLineRules.end());
-			{ // if it has not yet been added to the vector, add it
-				mSDLineRules[j] = new rule_set::sd_line_rule(mLineProperties[j]);
-			}
-		}
-	}
-	
 	// find the structural type for each line segment
-	for (auto& i : mSDLineRules)
+	for (const auto& i : mCFBuilding.cfLines())
 	{ // for each sd line rule
+		if (context.mSDLineRules[i->index()] == nullptr) continue;
 		// find the potential structural types from all the possible sd rectangle rules this
 		// line rule may be associated with
 		std::vector<structural_design::component::structure> potentialStructures;
-		for (const auto& j : i.first->cfRectangles())
+		for (const auto& j : i->cfRectangles())
 		{ // for each rectangle that this line is associated with
-			auto SDRectangleRuleSearch = mSDRectangleRules.find(j);
-			if (SDRectangleRuleSearch != mSDRectangleRules.end())
+			if (context.mSDRectangleRules[j->index()] != nullptr)
 			{ // if that rectangle is associated with an sd rectangle rule, store its structural type
-				potentialStructures.push_back(SDRectangleRuleSearch->second->getStructure());
+				potentialStructures.push_back(context.mSDRectangleRules[j->index()]->getStructure());
 			}
 		}
 
 		// pass the potential structural types to the sd line rule
-		i.second->assignStructure(potentialStructures);
-	}
-	
-	// initialize vertex rules
-	for (const auto& i : mVertexProperties)
-	{
-		if (i.second->isSpaceCorner())
-		{
-			mSDVertexRules[i.first] = new rule_set::sd_vertex_rule(i.second);
-		}
+		context.mSDLineRules[i->index()]->assignStructure(potentialStructures);
 	}
 	
 	// apply the rules
-	for (const auto& j : mSDVertexRules) j.second->apply(mSDModel);
-	for (const auto& j : mSDLineRules) j.second->apply(mSDModel);
-	for (const auto& j : mSDRectangleRules) j.second->apply(mSDModel);
-	mSDModel.setMeshSize(mMeshSize);
+	for (const auto& j : context.mSDVertexRules) if (j != nullptr) j->apply(mSDModel);
+	for (const auto& j : context.mSDLineRules) if (j != nullptr) j->apply(mSDModel);
+	for (const auto& j : context.mSDRectangleRules) if (j != nullptr) j->apply(mSDModel);
+	mSDModel.setMeshSize(settings.getMeshSize());
 	
-	// delete the rules
-	for (auto& i : mSDVertexRules) delete i.second;
-	for (auto& i : mSDLineRules) delete i.second;
-	for (auto& i : mSDRectangleRules) delete i.second;
+	{ // keep the rules for the next assignment
+		std::lock_guard<std::mutex> lock(mMutex);
+		mAssignmentContext = std::move(contextPtr);
+		
+		// assignments differ in a few rectangles, analyzing them with Reanalysis only updates the reference
+		if (mReanalysis == nullptr) mReanalysis = std::make_shared<structural_design::low_rank_reanalysis>();
+		mSDModel.setReanalysis(mReanalysis);
+	}
 	
 	return mSDModel;
 } // default_sd_grammar
 
+template <>
+bso::structural_design::sd_model grammar::sd_grammar<OPTIMIZER_ASSIGNMENT>(
+	const std::string& fileName,
+	const std::string& gaDesign,
+	const bso::structural_design::component::structure& trussStructure,
+	const bso::structural_design::component::structure& beamStructure,
+	const bso::structural_design::component::structure& flatShellStructure)
+{ // the settings file is only parsed again when it has been modified
+	return this->sd_grammar<OPTIMIZER_ASSIGNMENT>(*sd_grammar_settings::read(fileName),
+		gaDesign, trussStructure, beamStructure, flatShellStructure);
+}
+
 } // namespace grammar
 } // namespace bso
 
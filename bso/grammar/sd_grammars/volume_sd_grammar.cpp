@@ -8,26 +8,26 @@ namespace bso { namespace grammar {
 class VOLUME_SD_GRAMMAR;
 
 template <>
-bso::structural_design::sd_model grammar::sd_grammar<VOLUME_SD_GRAMMAR>(const std::string& fileName)
+bso::structural_design::sd_model grammar::sd_grammar<VOLUME_SD_GRAMMAR>(const sd_grammar_settings& settings)
 {
+	BSO_SCOPED_TIMER("grammar_sd");
 	// initialize a new SD model
-	mSDModel = bso::structural_design::sd_model();
-	// read the structural design settings
-	this->mReadSDSettings(fileName);
+	bso::structural_design::sd_model mSDModel;
+	// the rules of this call, deleted when it returns
+	sd_context context(mCFBuilding);
+
+	std::vector<structural_design::component::structure> cuboidStructures(mCuboidProperties.size()); // type "none" if not assigned
+	for (const auto& i : mCuboidProperties)
+	{
+		// get the space type depending on the settings
+		std::string usedType = i.getSpaceType();
 
-	std::map<spatial_design::conformal::cf_cuboid*, 
-					 structural_design::component::structure> cuboidStructures;
-	for (const auto& i : mCuboidProperties)
-	{
-		// get the space type depending on the settings
-		std::string usedType = i.second->getSpaceType();
-
-		// determine the structural type and properties of the cuboid
+		// determine the structural type and properties of the cuboid
 		bool structureFound = false;
-		auto structureSearch = mSDSpaceProperties.find(usedType);
-		if (i.second->isInSpace())
+		auto structureSearch = settings.getSpaceProperties().find(usedType);
+		if (i.isInSpace())
 		{
-			if (structureSearch != mSDSpaceProperties.end())
+			if (structureSearch != settings.getSpaceProperties().end())
 			{
 				structureFound = true;
 			}
@@ -39,38 +39,37 @@ bso::structural_design::sd_model grammar::sd_grammar<VOLUME_SD_GRAMMAR>(const st
 			errorMessage << "\nError, in volume grammar could not find the specified\n"
 									 << "type settings: \"" << usedType << "\""
 									 << "Has this type set been specified in the inputfile?: \""
-									 << fileName << "\"\n(bso/grammar/sd_grammars/volume_sd_grammar.cpp)"
+									 << settings.getFileName() << "\"\n(bso/grammar/sd_grammars/volume_sd_grammar.cpp)"
 									 << std::endl;
 			throw std::runtime_error(errorMessage.str());
-		}
-
-		// create a cuboid rule set
-		auto sdCuboidRuleSet = new rule_set::sd_cuboid_rule(i.second);
-		mSDCuboidRules[i.first] = sdCuboidRuleSet;
+		}
+
+		// create a cuboid rule set
+		auto sdCuboidRuleSet = new rule_set::sd_cuboid_rule(&i);
+		context.mSDCuboidRules[i.getCuboidPtr()->index()] = sdCuboidRuleSet;
 		if (structureSearch->second.type() != "none")
 		{
 			sdCuboidRuleSet->assignStructure(structureSearch->second);
-			cuboidStructures.emplace(i.first,structureSearch->second);
-		}
+			cuboidStructures[i.getCuboidPtr()->index()] = structureSearch->second;
+		}
 	}
 	
 	for (const auto& i : mRectangleProperties)
 	{
-		if (i.second->isSpaceSeparating())
+		if (i.isSpaceSeparating())
 		{
 			// create a rectangle rule set
-			auto sdRectangleRuleSet = new rule_set::sd_rectangle_rule(i.second);
-			mSDRectangleRules[i.first] = sdRectangleRuleSet;
-			sdRectangleRuleSet->assignLoadPanel(mLoadPanel); // add a load panel, in case a load is assigned but no structure can carry it
-			sdRectangleRuleSet->addLoads(&mLoads); // add the loads
+			auto sdRectangleRuleSet = new rule_set::sd_rectangle_rule(&i);
+			context.mSDRectangleRules[i.getRectanglePtr()->index()] = sdRectangleRuleSet;
+			sdRectangleRuleSet->assignLoadPanel(settings.getLoadPanel()); // add a load panel, in case a load is assigned but no structure can carry it
+			sdRectangleRuleSet->addLoads(&settings.getLoads()); // add the loads
 			
 			std::vector<structural_design::component::structure> potentialStructures;
-			for (const auto& j : i.second->getRectanglePtr()->cfCuboids())
+			for (const auto& j : i.getRectanglePtr()->cfCuboids())
 			{
-				auto structureSearch = cuboidStructures.find(j);
-				if (structureSearch != cuboidStructures.end())
+				if (cuboidStructures[j->index()].type() != "none")
 				{
-					potentialStructures.push_back(structureSearch->second);
+					potentialStructures.push_back(cuboidStructures[j->index()]);
 				}
 			}
 			sdRectangleRuleSet->assignStructure(potentialStructures);
@@ -78,42 +77,44 @@ bso::structural_design::sd_model grammar::sd_grammar<VOLUME_SD_GRAMMAR>(const st
 	}
 	
 	// find each line that is associated to a rectangle that has a rectangle rule set
-	for (const auto& i : mSDRectangleRules)
+	for (const auto& i : mCFBuilding.cfRectangles())
 	{ // for each sd rectangle rule
-		for (const auto& j : i.first->cfLines())
+		if (context.mSDRectangleRules[i->index()] == nullptr) continue;
+		for (const auto& j : i->cfLines())
 		{ // for each line associated to the rectangle associated to the rectangle rule
-			if (mSDLineRules.find(j) == mSDLineRules.end());
+			if (context.mSDLineRules[j->index()] == nullptr)
 			{ // if it has not yet been added to the vector, add it
-				mSDLineRules[j] = new rule_set::sd_line_rule(mLineProperties[j]); // create line rules, in this case only to generate boundary conditions
+				context.mSDLineRules[j->index()] = new rule_set::sd_line_rule(&mLineProperties[j->index()]); // create line rules, in this case only to generate boundary conditions
 			}
 		}
 	}
 
 	for (const auto& i : mVertexProperties)
 	{
-		if (i.second->isSpaceCorner())
+		if (i.isSpaceCorner())
 		{
-			mSDVertexRules[i.first] = new rule_set::sd_vertex_rule(i.second); // create nodes at space corners
+			context.mSDVertexRules[i.getVertexPtr()->index()] = new rule_set::sd_vertex_rule(&i); // create nodes at space corners
 		}
 	}
 
 	// apply the rules
-	for (const auto& i : mSDVertexRules) i.second->apply(mSDModel);
-	for (const auto& i : mSDLineRules) i.second->apply(mSDModel);
-	for (const auto& i : mSDRectangleRules) i.second->apply(mSDModel);
-	for (const auto& i : mSDCuboidRules) i.second->apply(mSDModel);
-	mSDModel.setMeshSize(mMeshSize);
+	for (const auto& i : context.mSDVertexRules) if (i != nullptr) i->apply(mSDModel);
+	for (const auto& i : context.mSDLineRules) if (i != nullptr) i->apply(mSDModel);
+	for (const auto& i : context.mSDRectangleRules) if (i != nullptr) i->apply(mSDModel);
+	for (const auto& i : context.mSDCuboidRules) if (i != nullptr) i->apply(mSDModel);
+	mSDModel.setMeshSize(settings.getMeshSize());
 
-	// delete the rules
-	for (auto& i : mSDVertexRules) delete i.second;
-	for (auto& i : mSDLineRules) delete i.second;
-	for (auto& i : mSDRectangleRules) delete i.second;
-	for (auto& i : mSDCuboidRules) delete i.second;
 
 	return mSDModel;
 } // volume_sd_grammar
 
+template <>
+bso::structural_design::sd_model grammar::sd_grammar<VOLUME_SD_GRAMMAR>(const std::string& fileName)
+{ // the settings file is only parsed again when it has been modified
+	return this->sd_grammar<VOLUME_SD_GRAMMAR>(*sd_grammar_settings::read(fileName));
+}
+
 } // namespace grammar
 } // namespace bso
 
-#endif // BSO_GRAMMAR_VOLUME_SD_GRAMMAR_CPP
+#endif // BSO_GRAMMAR_VOLUME_SD_GRAMMAR_CPP
@@ -0,0 +1,51 @@
+#ifndef BSO_GRAMMAR_SETTINGS_CACHE_CPP
+#define BSO_GRAMMAR_SETTINGS_CACHE_CPP
+
+#include <sys/stat.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace bso { namespace grammar {
+
+template <class SETTINGS>
+std::shared_ptr<const SETTINGS> read_settings(const std::string& fileName)
+{ // settings are cached by path, an entry is reused as long as the modification time and size of the file are unchanged
+	struct cache_entry
+	{
+		time_t modificationTime;
+		off_t size;
+		std::shared_ptr<const SETTINGS> settings;
+	};
+	static std::map<std::string, cache_entry> cache;
+	static std::mutex cacheMutex;
+
+	struct stat fileStatus;
+	if (stat(fileName.c_str(), &fileStatus) != 0)
+	{
+		std::stringstream errorMessage;
+		errorMessage << "\nCould not read grammar settings, failed to open file: "
+								 << fileName << "\n(bso/grammar/settings_cache.cpp)" << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto cacheSearch = cache.find(fileName);
+	if (cacheSearch != cache.end() &&
+			cacheSearch->second.modificationTime == fileStatus.st_mtime &&
+			cacheSearch->second.size == fileStatus.st_size)
+	{
+		return cacheSearch->second.settings;
+	}
+
+	std::shared_ptr<const SETTINGS> settings = std::make_shared<const SETTINGS>(fileName);
+	cache[fileName] = {fileStatus.st_mtime, fileStatus.st_size, settings};
+	return settings;
+} // read_settings()
+
+} // namespace grammar
+} // namespace bso
+
+#endif // BSO_GRAMMAR_SETTINGS_CACHE_CPP
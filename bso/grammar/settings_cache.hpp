@@ -0,0 +1,17 @@
+#ifndef BSO_GRAMMAR_SETTINGS_CACHE_HPP
+#define BSO_GRAMMAR_SETTINGS_CACHE_HPP
+
+#include <memory>
+#include <string>
+
+namespace bso { namespace grammar {
+
+template <class SETTINGS>
+std::shared_ptr<const SETTINGS> read_settings(const std::string& fileName); // parses a settings file once, and again only after it has been modified
+
+} // namespace grammar
+} // namespace bso
+
+#include <bso/grammar/settings_cache.cpp>
+
+#endif // BSO_GRAMMAR_SETTINGS_CACHE_HPP
@@ -96,6 +96,18 @@ namespace bso { namespace spatial_design { namespace conformal {
 			
 	} //  makeConformal()
 	
+	void cf_building_model::indexEntities()
+	{ // dense indices allow other modules to store data per entity in contiguous lists
+		for (unsigned long i = 0; i < mCFVertices.size(); ++i) mCFVertices[i]->index() = i;
+		for (unsigned long i = 0; i < mCFLines.size(); ++i) mCFLines[i]->index() = i;
+		for (unsigned long i = 0; i < mCFRectangles.size(); ++i) mCFRectangles[i]->index() = i;
+		for (unsigned long i = 0; i < mCFCuboids.size(); ++i) mCFCuboids[i]->index() = i;
+		for (unsigned long i = 0; i < mCFPoints.size(); ++i) mCFPoints[i]->index() = i;
+		for (unsigned long i = 0; i < mCFEdges.size(); ++i) mCFEdges[i]->index() = i;
+		for (unsigned long i = 0; i < mCFSurfaces.size(); ++i) mCFSurfaces[i]->index() = i;
+		for (unsigned long i = 0; i < mCFSpaces.size(); ++i) mCFSpaces[i]->index() = i;
+	} // indexEntities()
+
 	cf_building_model::cf_building_model(const cf_building_model& rhs)
 	{
 		auto newPtr = new cf_building_model(rhs.mMSModel, rhs.mTol);
@@ -105,11 +117,13 @@ namespace bso { namespace spatial_design { namespace conformal {
 	cf_building_model::cf_building_model(const ms_building& msModel, const double& tol /*= 1e-3*/)
 	:	cf_geometry_model(tol), mMSModel(msModel), mTol(tol)
 	{ // 
+		BSO_SCOPED_TIMER("conformal");
 		for (const auto& i : mMSModel)
 		{
 			addSpace(*i);
 		}
 		this->makeConformal();
+		this->indexEntities();
 	} // 
 	
 	cf_building_model::~cf_building_model()
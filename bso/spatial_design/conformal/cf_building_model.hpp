@@ -2,6 +2,7 @@
 #define CF_BUILDING_MODEL_HPP
 
 #include <bso/spatial_design/ms_building.hpp>
+#include <bso/utilities/instrumentation.hpp>
 
 namespace bso { namespace spatial_design { namespace conformal {
 	
@@ -17,6 +18,7 @@ namespace bso { namespace spatial_design { namespace conformal {
 		
 		void addSpace(const ms_space& msSpace);
 		void makeConformal();
+		void indexEntities();
 		
 		cf_building_model& operator = (cf_building_model& rhs) = default;
 		friend class cf_geometry_entity;
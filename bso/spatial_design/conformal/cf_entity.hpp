@@ -15,7 +15,12 @@ namespace bso { namespace spatial_design { namespace conformal {
 		std::vector<cf_edge*> mCFEdges;
 		std::vector<cf_surface*> mCFSurfaces;
 		std::vector<cf_space*> mCFSpaces;
+		
+		unsigned long mIndex = 0; // position in the list of its type in the conformal model
 	public:
+		unsigned long& index() {return mIndex;}
+		const unsigned long& index() const {return mIndex;}
+		
 		void addLine					(cf_line* 			lPtr	);
 		void addRectangle			(cf_rectangle* 	recPtr);
 		void addCuboid				(cf_cuboid* 		cubPtr);
@@ -10,6 +10,7 @@
 #include <exception>
 #include <boost/algorithm/string.hpp>
 #include <bitset>
+#include <deque>
 
 namespace bso { namespace spatial_design {
 
@@ -21,38 +22,81 @@ ms_building::ms_building()
 ms_building::ms_building(std::string fileName)
 :	insertFileName(fileName)
 { // initilization by string or text file
-	//std::cout << "In ms file is the insertedFileName: " << insertFileName << std::endl;
-	//std::cout << "In ms file is the insertedFileName: " << getInsertFileName() << std::endl;
 	mLastSpaceID = 0;
-	std::ifstream input;
-	if (!fileName.empty()) input.open(fileName.c_str());
-	
-	if (fileName.empty() || !input.is_open())
+
+	// an input that holds more than one line, or that starts with a space definition,
+	// is parsed directly instead of being interpreted as a file name
+	std::string prefix = fileName.substr(0,2);
+	bool isDefinition = (fileName.find('\n') != std::string::npos ||
+		prefix == "R," || prefix == "r," || prefix == "N," || prefix == "n,");
+	if (isDefinition)
 	{
-		std::stringstream errorMessage;
-		errorMessage << "Could not initialize an MS building spatial design with the following input file:" << std::endl
-								 << ((fileName.empty())? "no input file given" : fileName) << std::endl
-								 << "(bso/spatial_design/ms_building.cpp). " << std::endl;
-		throw std::invalid_argument(errorMessage.str());
+		insertFileName = "";
+		std::stringstream input(fileName);
+		this->readSpaces(input);
 	}
-	
-	std::string line;
-	
+	else
+	{
+		std::ifstream input;
+		if (!fileName.empty()) input.open(fileName.c_str());
+		
+		if (fileName.empty() || !input.is_open())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Could not initialize an MS building spatial design with the following input file:" << std::endl
+									 << ((fileName.empty())? "no input file given" : fileName) << std::endl
+									 << "(bso/spatial_design/ms_building.cpp). " << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		this->readSpaces(input);
+	}
+		
+	mLastSpaceID = this->getLastSpaceID();
+	this->updateFingerprint();
+	this->checkValidity();
+} // ms_building() (constructor using input file)
 
-	while (!input.eof()) // Parse the input file line by line
+ms_building::ms_building(std::istream& input)
+{ // initialization by input stream
+	mLastSpaceID = 0;
+	this->readSpaces(input);
+	mLastSpaceID = this->getLastSpaceID();
+	this->updateFingerprint();
+	this->checkValidity();
+} // ms_building() (constructor using input stream)
+
+ms_building::ms_building(const std::vector<ms_space>& spaces)
+{ // initialization by a list of spaces
+	mLastSpaceID = 0;
+	mSpaces.reserve(spaces.size());
+	for (const auto& i : spaces)
+	{
+		mSpaces.push_back(new ms_space(i));
+	}
+	mLastSpaceID = this->getLastSpaceID();
+	this->updateFingerprint();
+	this->checkValidity();
+} // ms_building() (constructor using a list of spaces)
+
+bool ms_building::readSpaces(std::istream& input, const bool stopAtEmptyLine /*= false*/)
+{ // parses space definitions from input, returns true if any space was read
+	std::string line;
+	bool spacesRead = false;
+	while (getline(input,line)) // Parse the input line by line
 	{
-		getline(input,line); // get next line from the file
 		try
 		{
 			boost::algorithm::trim(line); // remove white space from start and end of line (to see if it is an empty line, removes any incidental white space)
 			if (line == "") //skip empty lines (tokenizer does not like it)
 			{
+				if (stopAtEmptyLine && spacesRead) break; // an empty line ends a design in a multi-design input
 				continue; // continue to next line
 			}
 			else if (line.substr(0,2) == "R," || line.substr(0,2) == "r," || line.substr(0,2) == "N," || line.substr(0,2) == "n,")
 			{
 				//line.erase(0,2); // line.erase now happens in ms_space for sDefmethod definition (space definitiond method)
 				mSpaces.push_back(new ms_space(line));
+				spacesRead = true;
 			}
 			else
 			{
@@ -69,10 +113,8 @@ ms_building::ms_building(std::string fileName)
 			throw std::invalid_argument(errorMessage.str());
 		}
 	}
-		
-	mLastSpaceID = this->getLastSpaceID();
-	this->checkValidity();
-} // ms_building() (constructor using input file)
+	return spacesRead;
+} // readSpaces()
 
 ms_building::ms_building(const ms_building& rhs)
 { // copy constructor
@@ -83,6 +125,7 @@ ms_building::ms_building(const ms_building& rhs)
 	}
 	
 	insertFileName = rhs.getInsertFileName();
+	mFingerprint = rhs.mFingerprint;
 	
 	this->checkValidity();
 } // ms_building() (copy constructor)
@@ -93,68 +136,72 @@ ms_building::ms_building(const sc_building& sc)
 	{
 		// initialize variables and variable size
 		mLastSpaceID = 0;
-		std::vector<unsigned int> originIndices = {sc.getWSize(), sc.getDSize(), sc.getHSize()};
-		std::vector<std::vector<double> > globalCoords(3);
-		std::vector<std::vector<double> > dimensions(3);
-		for (unsigned int i = 0; i < 3; i++)
-		{
-			globalCoords[i] = std::vector<double>(originIndices[i]+1);
-			dimensions[i] = std::vector<double>(originIndices[i]);
-		}
-		for (unsigned int i = 0; i < originIndices[0]; i++) dimensions[0][i] = sc.getWValue(i);
-		for (unsigned int i = 0; i < originIndices[1]; i++) dimensions[1][i] = sc.getDValue(i);
-		for (unsigned int i = 0; i < originIndices[2]; i++) dimensions[2][i] = sc.getHValue(i);
+		unsigned int nD = sc.getDSize(), nH = sc.getHSize();
+		unsigned int nWords = sc.mBWordCount;
+		auto cellIndices = [nD, nH](const unsigned int& cell)
+		{ // returns the indices (w,d,h) of a zero based cell index
+			return std::vector<unsigned int>({cell/(nD*nH), (cell/nH)%nD, cell%nH});
+		};
 
 		// find the lowest cell indices (w,d,h) that index an active cell (i.e. they will represent the origin)
-		for (unsigned int i = 1; i < sc.getBRowSize(); i++)
-		{ // for each cell
-			std::vector<unsigned int> indices = {sc.getWIndex(i), sc.getDIndex(i), sc.getHIndex(i)}; // temporarily store the indices (w,d,h)
-			for (unsigned int j = 0; j < sc.getBSize(); j++)
-			{ // for each space
-				if (sc.getBValue(j,i) == 1)
-				{ // if the cell i is active for space j
-					for (unsigned int k = 0; k < 3; k++) 
-					{ // check for each index
-						if (indices[k] < originIndices[k])
-						{ // if it is lower than the lowest found so far to index an active cell
-							originIndices[k] = indices[k]; // if it is, set the lowest found to it.
-						}
-					}
-				}
-			}
+		std::vector<unsigned int> originIndices = {sc.getWSize(), sc.getDSize(), sc.getHSize()};
+		std::vector<uint64_t> occupied(nWords, 0);
+		for (unsigned int i = 0; i < sc.getBSize(); i++)
+		{ // for each space, collect its active cells
+			const uint64_t* words = sc.getBWords(i);
+			for (unsigned int j = 0; j < nWords; j++) occupied[j] |= words[j];
 		}
-
-		for (unsigned int i = 0; i < 3; i++)
-		{ // for each index
-			globalCoords[i][originIndices[i]] = 0.0; // set the origins coordinate value to zero
-			for (unsigned int j = originIndices[i] + 1; j < globalCoords[i].size(); j++)
-			{ // for each consequent index value increment with the width of the dimensions described by the supercube
-				globalCoords[i][j] = globalCoords[i][j-1] + dimensions[i][j-1];
+		for (unsigned int j = 0; j < nWords; j++)
+		{ // for each active cell
+			for (uint64_t word = occupied[j]; word != 0; word &= word - 1)
+			{
+				std::vector<unsigned int> indices = cellIndices(j*64 + __builtin_ctzll(word));
+				for (unsigned int k = 0; k < 3; k++) 
+				{ // check for each index if it is lower than the lowest found so far to index an active cell
+					if (indices[k] < originIndices[k]) originIndices[k] = indices[k];
+				}
 			}
 		}
 		
 		for (unsigned int i = 0; i < sc.getBSize(); i++)
 		{ // for each space
-			// find the indices of the minium and maximum cell index that is active for space i
-			unsigned int max = 0, min = 0;
-			for (unsigned int j = 1; j <= sc.getBRowSize(); j++)
+			// find the first and the last active cell of space i
+			const uint64_t* words = sc.getBWords(i);
+			unsigned int min = 0, max = 0;
+			bool active = false;
+			for (unsigned int j = 0; j < nWords; j++)
 			{
-				if (min == 0 && sc.getBValue(i,j) == 1) min = j;
-				if (sc.getBValue(i,j) == 1) max = j;
+				if (words[j] == 0) continue;
+				if (!active) min = j*64 + __builtin_ctzll(words[j]);
+				max = j*64 + 63 - __builtin_clzll(words[j]);
+				active = true;
 			}
+			if (!active)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "Space " << sc.getBValue(i,0) << " has no active cells." << std::endl;
+				throw std::invalid_argument(errorMessage.str());
+			}
+			std::vector<unsigned int> minIndices = cellIndices(min);
+			std::vector<unsigned int> maxIndices = cellIndices(max);
 
 			//get the locations and dimensions from these indices
+			utilities::geometry::vertex origin;
+			origin << sc.getWCoordinate(originIndices[0]),
+								sc.getDCoordinate(originIndices[1]),
+								sc.getHCoordinate(originIndices[2]);
 			utilities::geometry::vertex location;
-			location << globalCoords[0][sc.getWIndex(min)],
-									globalCoords[1][sc.getDIndex(min)],
-									globalCoords[2][sc.getHIndex(min)];
+			location << sc.getWCoordinate(minIndices[0]),
+									sc.getDCoordinate(minIndices[1]),
+									sc.getHCoordinate(minIndices[2]);
+			location -= origin;
 			location.round(0);
 			
 			utilities::geometry::vector dimensions;
-			dimensions << globalCoords[0][sc.getWIndex(max)+1],
-										globalCoords[1][sc.getDIndex(max)+1],
-										globalCoords[2][sc.getHIndex(max)+1];
-			dimensions -= location;
+			dimensions << sc.getWCoordinate(maxIndices[0]+1),
+										sc.getDCoordinate(maxIndices[1]+1),
+										sc.getHCoordinate(maxIndices[2]+1);
+			dimensions -= origin + location;
 			dimensions.round(0);
 			
 			//initialize a new space with the found location and dimensions
@@ -165,6 +212,7 @@ ms_building::ms_building(const sc_building& sc)
 				mLastSpaceID = mSpaces.back()->getID();
 			}
 		}
+		this->updateFingerprint();
 	}
 	catch (std::exception& e)
 	{
@@ -184,11 +232,85 @@ ms_building::~ms_building()
 	for (auto i : mSpaces) delete i;
 } // ~ms_building()
 
+ms_building& ms_building::operator = (const ms_building& rhs)
+{ // copy assignment
+	if (this == &rhs) return *this;
+	this->clearSpaces();
+	mLastSpaceID = rhs.mLastSpaceID;
+	mSpaces.reserve(rhs.mSpaces.size());
+	for (auto i : rhs.mSpaces)
+	{
+		mSpaces.push_back(new ms_space(*i));
+	}
+	insertFileName = rhs.insertFileName;
+	mFingerprint = rhs.mFingerprint;
+	return *this;
+} // operator = ()
+
+void ms_building::clearSpaces()
+{ // deletes all spaces
+	for (auto i : mSpaces) delete i;
+	mSpaces.clear();
+	mLastSpaceID = 0;
+	mFingerprint = utilities::fingerprint();
+} // clearSpaces()
+
+void ms_building::updateFingerprint()
+{ // recomputes the fingerprint from all spaces
+	mFingerprint = utilities::fingerprint();
+	for (const auto& i : mSpaces) mFingerprint.add(i->getFingerprint());
+} // updateFingerprint()
+
 void ms_building::checkValidity() const
 {
 	
 } // checkValidity()
 
+std::vector<std::pair<unsigned int, unsigned int> > ms_building::findTouchingSpaces(
+	const std::vector<bso::utilities::geometry::quad_hexahedron>& spaceGeoms,
+	const double& tol) const
+{ // sweep and prune over the axis aligned bounding boxes of the spaces
+	unsigned int nSpaces = spaceGeoms.size();
+	std::vector<Eigen::Vector3d> boxMin(nSpaces), boxMax(nSpaces);
+	double maxDiagonal = 0;
+	for (unsigned int i = 0; i < nSpaces; ++i)
+	{
+		boxMin[i] = spaceGeoms[i].getVertices().front();
+		boxMax[i] = boxMin[i];
+		for (const auto& j : spaceGeoms[i])
+		{
+			boxMin[i] = boxMin[i].cwiseMin(j);
+			boxMax[i] = boxMax[i].cwiseMax(j);
+		}
+		maxDiagonal = std::max(maxDiagonal, (boxMax[i] - boxMin[i]).norm());
+	}
+
+	// the exact geometric checks use tolerances that are partly relative (e.g. parallel
+	// checks), therefore the boxes are inflated with a margin that scales with the geometry
+	double margin = std::abs(tol) * (1.0 + maxDiagonal);
+
+	std::vector<unsigned int> sweepOrder(nSpaces);
+	for (unsigned int i = 0; i < nSpaces; ++i) sweepOrder[i] = i;
+	std::sort(sweepOrder.begin(), sweepOrder.end(), [&](const unsigned int& a, const unsigned int& b)
+		{ return boxMin[a](0) < boxMin[b](0); });
+
+	std::vector<std::pair<unsigned int, unsigned int> > touchingSpaces;
+	for (unsigned int i = 0; i < nSpaces; ++i)
+	{
+		unsigned int a = sweepOrder[i];
+		for (unsigned int j = i + 1; j < nSpaces; ++j)
+		{
+			unsigned int b = sweepOrder[j];
+			if (boxMin[b](0) > boxMax[a](0) + margin) break; // all following boxes start further along the sweep axis
+			if (boxMin[b](1) > boxMax[a](1) + margin || boxMin[a](1) > boxMax[b](1) + margin) continue;
+			if (boxMin[b](2) > boxMax[a](2) + margin || boxMin[a](2) > boxMax[b](2) + margin) continue;
+			touchingSpaces.push_back(std::minmax(a,b));
+		}
+	}
+
+	return touchingSpaces;
+} // findTouchingSpaces()
+
 void ms_building::writeToFile(std::string fileName) const
 {
 	std::ofstream output;
@@ -297,7 +419,12 @@ void ms_building::setZZero()
 	utilities::geometry::vector coordDifference;
 	coordDifference << 0, 0, -min;
 	
-	for (auto i : mSpaces) i->setCoordinates(i->getCoordinates() + coordDifference);
+	for (auto i : mSpaces)
+	{
+		mFingerprint.remove(i->getFingerprint());
+		i->setCoordinates(i->getCoordinates() + coordDifference);
+		mFingerprint.add(i->getFingerprint());
+	}
 } // setZZero()
 
 void ms_building::addSpace(const ms_space& space)
@@ -305,6 +432,7 @@ void ms_building::addSpace(const ms_space& space)
 	try
 	{
 		mSpaces.push_back(new ms_space(space));
+		mFingerprint.add(mSpaces.back()->getFingerprint());
 		checkValidity();
 	}
 	catch(std::exception& e)
@@ -323,7 +451,9 @@ void ms_building::deleteSpace(ms_space* spacePtr)
 	if (std::find(mSpaces.begin(), mSpaces.end(), spacePtr) == mSpaces.end()) spacePtr = getSpacePtr(spacePtr);
 	try
 	{
-		mSpaces.erase(std::remove(mSpaces.begin(), mSpaces.end(), spacePtr), mSpaces.end());
+		auto newEnd = std::remove(mSpaces.begin(), mSpaces.end(), spacePtr);
+		if (newEnd != mSpaces.end()) mFingerprint.remove(spacePtr->getFingerprint());
+		mSpaces.erase(newEnd, mSpaces.end());
 	}
 	catch(std::exception& e)
 	{
@@ -376,6 +506,7 @@ void ms_building::cutOff(const bso::utilities::geometry::vertex& location,
 	selection = this->selectSpacesGeometrically(location,n,true);
 	for (auto& i : selection)
 	{// cut each space at the cutting plane
+		mFingerprint.remove(i->getFingerprint());
 		bso::utilities::geometry::vertex coords = i->getCoordinates();
 		bso::utilities::geometry::vector tempSum = coords + i->getDimensions();
 		bso::utilities::geometry::vector vec1 = coords - location;
@@ -394,6 +525,7 @@ void ms_building::cutOff(const bso::utilities::geometry::vertex& location,
 		
 		i->setCoordinates(coords);
 		i->setDimensions(tempSum - coords);
+		mFingerprint.add(i->getFingerprint());
 	}
 }
 
@@ -433,6 +565,7 @@ void ms_building::sweep(const bso::utilities::geometry::vertex& location,
 	
 	for (auto i : mSpaces)
 	{
+		mFingerprint.remove(i->getFingerprint());
 		coords = i->getCoordinates();
 		tempSum = coords + i->getDimensions();
 
@@ -455,6 +588,7 @@ void ms_building::sweep(const bso::utilities::geometry::vertex& location,
 
 		i->setCoordinates(coords);
 		i->setDimensions(tempSum - coords);
+		mFingerprint.add(i->getFingerprint());
 	}
 } // sweep()
 
@@ -492,6 +626,7 @@ void ms_building::scale(const std::vector<std::pair<unsigned int, double> >& sca
 	
 	for (auto i : mSpaces)
 	{
+		mFingerprint.remove(i->getFingerprint());
 		coords = i->getCoordinates();
 		tempSum = coords + i->getDimensions();
 
@@ -506,6 +641,7 @@ void ms_building::scale(const std::vector<std::pair<unsigned int, double> >& sca
 
 		i->setCoordinates(coords);
 		i->setDimensions(tempSum - coords);
+		mFingerprint.add(i->getFingerprint());
 	}
 } // scale()
 
@@ -580,6 +716,7 @@ void ms_building::splitSpace(ms_space* spacePtr, const std::vector<std::pair<uns
 				tempSum << splitValues[0][i+1], splitValues[1][j+1], splitValues[2][k+1];
 				temp->setDimensions(tempSum - coords);
 				mSpaces.push_back(temp);
+				mFingerprint.add(temp->getFingerprint());
 			}
 		}
 	}
@@ -624,6 +761,7 @@ void ms_building::snapOn(const std::vector<std::pair<unsigned int, double> >& sn
 	
 	for (auto i : mSpaces)
 	{
+		mFingerprint.remove(i->getFingerprint());
 		coords = i->getCoordinates();
 		tempSum = coords + i->getDimensions();
 		
@@ -638,6 +776,7 @@ void ms_building::snapOn(const std::vector<std::pair<unsigned int, double> >& sn
 		
 		i->setCoordinates(coords);
 		i->setDimensions(tempSum - coords);
+		mFingerprint.add(i->getFingerprint());
 	}
 } // snapOn()
 
@@ -645,46 +784,46 @@ bool ms_building::hasOverlappingSpaces(std::multimap<ms_space*,ms_space*>& overl
 	const double tol /*= 1e-3*/) const
 {
 	std::vector<bso::utilities::geometry::quad_hexahedron> spaceGeoms;
+	spaceGeoms.reserve(mSpaces.size());
 	for (const auto& i : mSpaces)
 	{
 		spaceGeoms.push_back(i->getGeometry());
 	}
 	
-	for (unsigned int i = 0; i < spaceGeoms.size(); ++i)
+	// checks if space i overlaps space j, if so, the pair is stored as (j,i)
+	auto checkOverlap = [&](const unsigned int& i, const unsigned int& j)
 	{
-		for (unsigned int j = 0; j < spaceGeoms.size(); ++j)
+		for (const auto& k : spaceGeoms[i])
 		{
-			if (i == j) continue;
-			bool foundOverlap = false;
-			for (const auto& k : spaceGeoms[i])
+			if (spaceGeoms[j].isInside(k,tol))
 			{
-				if (spaceGeoms[j].isInside(k,tol))
-				{
-					overlappingSpaces.emplace(mSpaces[j], mSpaces[i]);
-					foundOverlap = true;
-					break;
-				}
+				overlappingSpaces.emplace(mSpaces[j], mSpaces[i]);
+				return;
 			}
-			if (foundOverlap) break;
-			unsigned int linePolygonIntersections = 0;
-			for (const auto& k : spaceGeoms[j].getLines())
+		}
+		unsigned int linePolygonIntersections = 0;
+		for (const auto& k : spaceGeoms[j].getLines())
+		{
+			for (const auto& l : spaceGeoms[i].getPolygons())
 			{
-				for (const auto& l : spaceGeoms[i].getPolygons())
+				if (l->intersectsWith(k,tol))
 				{
-					if (l->intersectsWith(k,tol))
+					++linePolygonIntersections;
+					if (linePolygonIntersections == 2)
 					{
-						++linePolygonIntersections;
-						if (linePolygonIntersections == 2)
-						{
-							overlappingSpaces.emplace(mSpaces[j], mSpaces[i]);
-							foundOverlap = true;
-							break;
-						}
+						overlappingSpaces.emplace(mSpaces[j], mSpaces[i]);
+						return;
 					}
 				}
-				if (foundOverlap) break;
 			}
 		}
+	};
+	
+	// only spaces with touching bounding boxes can overlap
+	for (const auto& i : this->findTouchingSpaces(spaceGeoms, tol))
+	{
+		checkOverlap(i.first, i.second);
+		checkOverlap(i.second, i.first);
 	}
 	
 	return (overlappingSpaces.size() != 0);
@@ -693,98 +832,97 @@ bool ms_building::hasOverlappingSpaces(std::multimap<ms_space*,ms_space*>& overl
 bool ms_building::hasFloatingSpaces(std::vector<ms_space*>& floatingSpaces, 
 	const double tol /*= 1e-3*/) const
 {
-	std::vector<bso::utilities::geometry::quad_hexahedron> groundedSpaceGeoms;
-	floatingSpaces = mSpaces;
-	bool hasFloatingSpaces = false;
-	bool addedSpaceToGroundedSpaceGeoms = true; // initial
-	while (addedSpaceToGroundedSpaceGeoms)
+	std::vector<bso::utilities::geometry::quad_hexahedron> spaceGeoms;
+	spaceGeoms.reserve(mSpaces.size());
+	for (const auto& i : mSpaces)
 	{
-		addedSpaceToGroundedSpaceGeoms = false;
-		auto spaceIt = floatingSpaces.begin();
-		while (spaceIt != floatingSpaces.end())
+		spaceGeoms.push_back(i->getGeometry());
+	}
+	
+	// checks if space i is connected to (i.e. may be supported by) space j
+	auto isConnectedTo = [&](const unsigned int& i, const unsigned int& j)
+	{
+		const auto& spaceGeom = spaceGeoms[i];
+		const auto& groundedGeom = spaceGeoms[j];
+		for (const auto& k : spaceGeom)
 		{
-			auto spaceGeom = (*spaceIt)->getGeometry();
-
-			// check if this space has any vertex with a z-coordinate at or below zero
-			bool isGrounded = false;
-			for (const auto& j : spaceGeom)
+			if (groundedGeom.isInside(k,tol))
+			{ // if any vertex k of the space is inside the other space
+				return true;
+			}
+			for (const auto& l : groundedGeom.getPolygons())
 			{
-				if (j(2) < abs(tol))
-				{
-					isGrounded = true;
-					break;
+				if (l->isInside(k,tol))
+				{ // if any vertex k of the space is inside a surface of the other space
+					return true;
 				}
 			}
-			if (isGrounded)
+			for (const auto& l : groundedGeom.getLines())
 			{
-				groundedSpaceGeoms.push_back(spaceGeom);
-				addedSpaceToGroundedSpaceGeoms = true;
-				floatingSpaces.erase(spaceIt);
-				continue;
+				if (l.isOnLine(k,tol))
+				{ // if any vertex k of the space is on a line segment of the other space
+					return true;
+				}
 			}
-			
-			// check if this space is connected to any of the grounded spaces
-			bool isConnectedToGroundedSpace = false;
-			for (const auto& i : groundedSpaceGeoms)
+			for (const auto& l : groundedGeom)
 			{
-				for (const auto& j : spaceGeom)
-				{
-					if (i.isInside(j,tol))
-					{ // if any vertex j of the space is inside a grounded space
-						isConnectedToGroundedSpace = true;
-						break;
-					}
-					for (const auto& k : i.getPolygons())
-					{
-						if (k->isInside(j,tol))
-						{ // if any vertex j of the space is inside the surface of a grounded space
-							isConnectedToGroundedSpace = true;
-							break;
-						}
-					}
-					if (isConnectedToGroundedSpace) break;
-					for (const auto& k : i.getLines())
-					{
-						if (k.isOnLine(j,tol))
-						{ // if any vertex j of the space is on a line segment of a grounded space
-							isConnectedToGroundedSpace = true;
-							break;
-						}
-					}
-					if (isConnectedToGroundedSpace) break;
-					for (const auto& k : i)
-					{
-						if (k.isSameAs(j,tol))
-						{ // if any vertex j of the space is collocated with a vertex of a grounded space
-							isConnectedToGroundedSpace = true;
-							break;
-						}
-					}
-					if (isConnectedToGroundedSpace) break;
+				if (l.isSameAs(k,tol))
+				{ // if any vertex k of the space is collocated with a vertex of the other space
+					return true;
 				}
-				for (const auto& j : i)
-				{
-					if (spaceGeom.isInside(j,tol))
-					{ // if any vertex j of a grounded space i is inside the space
-						isConnectedToGroundedSpace = true;
-						break;
-					}
-				}
-				if (isConnectedToGroundedSpace) break;
 			}
-			
-			if (isConnectedToGroundedSpace)
+		}
+		for (const auto& k : groundedGeom)
+		{
+			if (spaceGeom.isInside(k,tol))
+			{ // if any vertex k of the other space is inside the space
+				return true;
+			}
+		}
+		return false;
+	};
+	
+	// build the contact graph, only spaces with touching bounding boxes can be connected
+	// contactGraph[j] holds the spaces i that are connected to space j
+	std::vector<std::vector<unsigned int> > contactGraph(mSpaces.size());
+	for (const auto& i : this->findTouchingSpaces(spaceGeoms, tol))
+	{
+		if (isConnectedTo(i.first, i.second)) contactGraph[i.second].push_back(i.first);
+		if (isConnectedTo(i.second, i.first)) contactGraph[i.first].push_back(i.second);
+	}
+	
+	// breadth first search starting from the spaces that have any vertex at or below zero
+	std::vector<bool> isGrounded(mSpaces.size(), false);
+	std::deque<unsigned int> queue;
+	for (unsigned int i = 0; i < spaceGeoms.size(); ++i)
+	{
+		for (const auto& j : spaceGeoms[i])
+		{
+			if (j(2) < std::abs(tol))
 			{
-				groundedSpaceGeoms.push_back(spaceGeom);
-				addedSpaceToGroundedSpaceGeoms = true;
-				floatingSpaces.erase(spaceIt);
-				continue;
+				isGrounded[i] = true;
+				queue.push_back(i);
+				break;
 			}
-			
-			++spaceIt;
+		}
+	}
+	while (!queue.empty())
+	{
+		unsigned int j = queue.front();
+		queue.pop_front();
+		for (const auto& i : contactGraph[j])
+		{
+			if (isGrounded[i]) continue;
+			isGrounded[i] = true;
+			queue.push_back(i);
 		}
 	}
 	
+	floatingSpaces.clear();
+	for (unsigned int i = 0; i < mSpaces.size(); ++i)
+	{
+		if (!isGrounded[i]) floatingSpaces.push_back(mSpaces[i]);
+	}
 	
 	return (floatingSpaces.size() != 0);
 } // hasFloatingSpaces()
@@ -792,24 +930,17 @@ bool ms_building::hasFloatingSpaces(std::vector<ms_space*>& floatingSpaces,
 bool ms_building::operator == (const ms_building& rhs)
 {
 	if (mSpaces.size() != rhs.mSpaces.size()) return false;
+	// equal buildings have equal fingerprints, so a different fingerprint rules out equality
+	if (mFingerprint != rhs.mFingerprint) return false;
 	
 	// check if rhs contains the same spaces, assuming they may be in different order
-	std::vector<ms_space*> cmp = rhs.mSpaces; // copy the vector containing the spaces to safe computation time, matches can be removed from this
-	std::reverse(cmp.begin(), cmp.end()); // reverse the vector, since items will be removed we want to iterate from the back, however if vectors are same order we want to benefit from that to safe computation time
-
-	for (auto i : mSpaces)
+	auto spaceLess = [](const ms_space* lhs, const ms_space* rhs) {return *lhs < *rhs;};
+	std::vector<ms_space*> lhsSpaces = mSpaces, rhsSpaces = rhs.mSpaces;
+	std::sort(lhsSpaces.begin(), lhsSpaces.end(), spaceLess);
+	std::sort(rhsSpaces.begin(), rhsSpaces.end(), spaceLess);
+	for (unsigned int i = 0; i < lhsSpaces.size(); i++)
 	{
-		bool found = false;
-		for (unsigned int j = cmp.size(); j > 0; j--)
-		{
-			if (*i == *(cmp[j - 1]))
-			{
-				found = true;
-				cmp.erase(cmp.begin() + j - 1);
-				break;
-			}
-		}
-		if (!found) return false;
+		if (*lhsSpaces[i] != *rhsSpaces[i]) return false;
 	}
 	return true;
 }
@@ -824,7 +955,6 @@ ms_building::operator sc_building() const
 	try
 	{
 		sc_building sc;
-		bso::utilities::geometry::vertex minMSPoint = {0,0,0};
 		std::vector<std::vector<double> > coordValues(3); // {xValues,yValues,Zvalues}
 		
 		// store all coordinate values in this MS building model in the three std::vectors
@@ -834,7 +964,6 @@ ms_building::operator sc_building() const
 			utilities::geometry::vertex p2 = i->getDimensions() + p1;
 			for (unsigned int j = 0; j < 3; j++)
 			{
-				if (p1[j] < minMSPoint[j]) minMSPoint[j] = p1[j];
 				coordValues[j].push_back(p1(j));
 				coordValues[j].push_back(p2(j));
 			}
@@ -852,7 +981,7 @@ ms_building::operator sc_building() const
 		for (unsigned int i = 0; i < coordValues.size(); i++)
 		{
 			std::vector<double> tempDimensions;
-			for (unsigned int j = 0; j < coordValues[i].size()-1; j++)
+			for (unsigned int j = 0; j + 1 < coordValues[i].size(); j++)
 			{
 				tempDimensions.push_back(coordValues[i][j+1] - coordValues[i][j]);
 			}
@@ -862,33 +991,42 @@ ms_building::operator sc_building() const
 			else if (i == 1) sc.mDValues = tempDimensions;
 			else if (i == 2) sc.mHValues = tempDimensions;
 		}
+		sc.updateCoordinates();
 		
-		// for each space, create an emtpy bit mask, and subsequently find out which cells in that mask belong to the space, and should be activated
-		for (auto i : mSpaces)
+		// for each space, create an empty bit mask, and subsequently activate the cells that lie within the space
+		unsigned int nD = sc.getDSize(), nH = sc.getHSize();
+		sc.mBWordCount = (cubeSize + 63) / 64;
+		sc.mBBits.assign(mSpaces.size() * sc.mBWordCount, 0);
+		for (unsigned int i = 0; i < mSpaces.size(); i++)
 		{
-			sc.mBValues.push_back(std::vector<int>(cubeSize + 1));
-			sc.mBValues.back()[0] = i->getID();
-			utilities::geometry::vertex p1 = i->getCoordinates();
-			utilities::geometry::vertex p2 = i->getDimensions() + p1;
-
-			for (unsigned int j = 1; j < sc.mBValues.back().size(); j++)
+			sc.mBIDs.push_back(mSpaces[i]->getID());
+			utilities::geometry::vertex p1 = mSpaces[i]->getCoordinates();
+			utilities::geometry::vertex p2 = mSpaces[i]->getDimensions() + p1;
+			
+			// the range of cell indices (w,d,h) of the space follows from the positions of its corner coordinates
+			std::vector<unsigned int> begin(3), end(3);
+			for (unsigned int k = 0; k < 3; k++)
 			{
-				utilities::geometry::vertex pCheck = minMSPoint;
+				begin[k] = std::lower_bound(coordValues[k].begin(), coordValues[k].end(), p1[k]) - coordValues[k].begin();
+				end[k] = std::lower_bound(coordValues[k].begin(), coordValues[k].end(), p2[k]) - coordValues[k].begin();
+			}
 			
-				for (unsigned int k = 0; k < sc.getWIndex(j); ++k) pCheck[0] += sc.getWValue(k);
-				for (unsigned int k = 0; k < sc.getDIndex(j); ++k) pCheck[1] += sc.getDValue(k);
-				for (unsigned int k = 0; k < sc.getHIndex(j); ++k) pCheck[2] += sc.getHValue(k);
-
-				bool belongsToSpace = true;
-				for (unsigned int k = 0; k < 3; k++)
+			// cells with consecutive h indices are consecutive bits, activate them a word at a time
+			uint64_t* words = sc.mBBits.data() + i * sc.mBWordCount;
+			for (unsigned int w = begin[0]; w < end[0]; w++)
+			{
+				for (unsigned int d = begin[1]; d < end[1]; d++)
 				{
-					if (pCheck[k] < p1[k] || pCheck[k] >= p2[k])
+					unsigned int bit = w*nD*nH + d*nH + begin[2];
+					unsigned int last = w*nD*nH + d*nH + end[2];
+					while (bit < last)
 					{
-						belongsToSpace = false;
-						break;
+						unsigned int n = std::min(64 - bit%64, last - bit);
+						uint64_t mask = (n == 64)? ~uint64_t(0) : ((uint64_t(1) << n) - 1);
+						words[bit/64] |= mask << (bit%64);
+						bit += n;
 					}
 				}
-				sc.mBValues.back()[j] = belongsToSpace;
 			}
 		}
 		sc.checkValidity();
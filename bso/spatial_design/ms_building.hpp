@@ -4,8 +4,10 @@
 #include <vector>
 #include <map>
 #include <utility>
+#include <istream>
 #include <bso/spatial_design/ms_space.hpp>
 #include <bso/spatial_design/sc_building.hpp>
+#include <bso/utilities/fingerprint.hpp>
 
 namespace bso { namespace spatial_design {
 
@@ -14,14 +16,24 @@ class ms_building
 private:
 	std::vector<ms_space*> mSpaces;
 	mutable unsigned int mLastSpaceID;
+	utilities::fingerprint mFingerprint; // sum of the fingerprints of all spaces, kept up to date by each modification
 	void checkValidity() const;
+	std::vector<std::pair<unsigned int, unsigned int> > findTouchingSpaces(
+		const std::vector<bso::utilities::geometry::quad_hexahedron>& spaceGeoms,
+		const double& tol) const; // broad phase, returns index pairs (i < j) of spaces with touching bounding boxes
+	bool readSpaces(std::istream& input, const bool stopAtEmptyLine = false); // returns true if any space was read
+	void clearSpaces();
+	void updateFingerprint(); // recomputes the fingerprint from all spaces
 	std::string insertFileName;
 public:
 	ms_building(); // empty constructor
 	ms_building(std::string fileName); // initilization by string or text file
+	ms_building(std::istream& input); // initialization by input stream
+	ms_building(const std::vector<ms_space>& spaces); // initialization by a list of spaces
 	ms_building(const ms_building& rhs); // copy constructor
 	ms_building(const sc_building& sc); // convert SC to MS
 	~ms_building(); // destructor
+	ms_building& operator = (const ms_building& rhs); // copy assignment
 	
 	const std::string getInsertFileName() const{return insertFileName;}
 	void writeToFile(std::string fileName) const;
@@ -31,6 +43,7 @@ public:
 	unsigned int getLastSpaceID() const;
 	double getVolume() const;
 	double getFloorArea() const;
+	utilities::fingerprint getFingerprint() const {return mFingerprint;} // order independent, excludes space IDs
 	
 	std::vector<ms_space*> selectSpacesGeometrically(
 		const bso::utilities::geometry::vertex& location,
@@ -65,6 +78,7 @@ public:
 	operator sc_building() const; // convert MS to SC
 	
 	friend std::ostream& operator<< (std::ostream& stream, const ms_building& building);
+	friend class ms_building_reader;
 };
 
 } // namespace spatial_design
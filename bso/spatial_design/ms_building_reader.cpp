@@ -0,0 +1,55 @@
+#ifndef MS_BUILDING_READER_CPP
+#define MS_BUILDING_READER_CPP
+
+#include <sstream>
+#include <stdexcept>
+
+namespace bso { namespace spatial_design {
+
+ms_building_reader::ms_building_reader(const std::string& fileName)
+:	mInput(&mFile), mDesignCount(0)
+{
+	if (!fileName.empty()) mFile.open(fileName.c_str());
+	if (fileName.empty() || !mFile.is_open())
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Could not open the following multi-design MS input file:" << std::endl
+								 << ((fileName.empty())? "no input file given" : fileName) << std::endl
+								 << "(bso/spatial_design/ms_building_reader.cpp). " << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+} // ms_building_reader()
+
+ms_building_reader::ms_building_reader(std::istream& input)
+:	mInput(&input), mDesignCount(0)
+{
+	
+} // ms_building_reader()
+
+ms_building_reader::~ms_building_reader()
+{
+	
+} // ~ms_building_reader()
+
+bool ms_building_reader::next(ms_building& building)
+{ // replaces building by the next design, returns false if no designs are left
+	building.clearSpaces();
+	building.insertFileName = "";
+	if (!building.readSpaces(*mInput, true)) return false;
+	
+	building.mLastSpaceID = building.getLastSpaceID();
+	building.updateFingerprint();
+	building.checkValidity();
+	++mDesignCount;
+	return true;
+} // next()
+
+unsigned int ms_building_reader::getDesignCount() const
+{ // number of designs read so far
+	return mDesignCount;
+} // getDesignCount()
+
+} // namespace spatial_design
+} // namespace bso
+
+#endif // MS_BUILDING_READER_CPP
@@ -0,0 +1,31 @@
+#ifndef MS_BUILDING_READER_HPP
+#define MS_BUILDING_READER_HPP
+
+#include <string>
+#include <fstream>
+#include <istream>
+#include <bso/spatial_design/ms_building.hpp>
+
+namespace bso { namespace spatial_design {
+
+class ms_building_reader
+{ // reads multiple MS designs from one input, designs are separated by one or more empty lines
+private:
+	std::ifstream mFile;
+	std::istream* mInput;
+	unsigned int mDesignCount;
+public:
+	ms_building_reader(const std::string& fileName); // opens the multi-design file once
+	ms_building_reader(std::istream& input); // reads from an existing stream
+	~ms_building_reader();
+	
+	bool next(ms_building& building); // replaces building by the next design, returns false if no designs are left
+	unsigned int getDesignCount() const; // number of designs read so far
+};
+
+} // namespace spatial_design
+} // namespace bso
+
+#include <bso/spatial_design/ms_building_reader.cpp>
+
+#endif // MS_BUILDING_READER_HPP
@@ -386,11 +386,38 @@ double ms_space::getFloorArea() const
 	return mDimensions(0)*mDimensions(1);
 } // getFloorArea()
 
+utilities::fingerprint ms_space::getFingerprint(const double& tol /*= 1e-3*/) const
+{ // hash of the geometry and types, excludes the ID
+	utilities::fingerprint f;
+	if (sDefMethod == "N" || sDefMethod == "n")
+	{ // non-orthogonal spaces are described by their vertices
+		f.combine(uint64_t(pVertex.size()));
+		for (const auto& i : pVertex)
+		{
+			for (unsigned int j = 0; j < 3; j++) f.combine((*i)(j), tol);
+		}
+	}
+	else
+	{
+		for (unsigned int i = 0; i < 3; i++) f.combine(mCoordinates(i), tol);
+		for (unsigned int i = 0; i < 3; i++) f.combine(mDimensions(i), tol);
+	}
+	f.combine(mSpaceType);
+	f.combine(uint64_t(mSurfaceTypes.size()));
+	for (const auto& i : mSurfaceTypes) f.combine(i);
+	return f;
+} // getFingerprint()
+
 bool ms_space::operator == (const ms_space& rhs) const
 {
 	if (mID != rhs.mID) return false;
 	if (mCoordinates != rhs.mCoordinates) return false;
 	if (mDimensions != rhs.mDimensions) return false;
+	if (pVertex.size() != rhs.pVertex.size()) return false;
+	for (unsigned int i = 0; i < pVertex.size(); i++)
+	{
+		if (*pVertex[i] != *rhs.pVertex[i]) return false;
+	}
 	if (mSpaceType != rhs.mSpaceType) return false;
 	if (mSurfaceTypes.size() != rhs.mSurfaceTypes.size()) return false;
 	for (unsigned int i = 0; i < mSurfaceTypes.size(); i++)
@@ -406,6 +433,29 @@ bool ms_space::operator != (const ms_space& rhs) const
 	return !(*this == rhs);
 }
 
+bool ms_space::operator < (const ms_space& rhs) const
+{ // lexicographic order on ID, geometry, and types
+	if (mID != rhs.mID) return mID < rhs.mID;
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		if (mCoordinates(i) != rhs.mCoordinates(i)) return mCoordinates(i) < rhs.mCoordinates(i);
+	}
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		if (mDimensions(i) != rhs.mDimensions(i)) return mDimensions(i) < rhs.mDimensions(i);
+	}
+	if (pVertex.size() != rhs.pVertex.size()) return pVertex.size() < rhs.pVertex.size();
+	for (unsigned int i = 0; i < pVertex.size(); i++)
+	{
+		for (unsigned int j = 0; j < 3; j++)
+		{
+			if ((*pVertex[i])(j) != (*rhs.pVertex[i])(j)) return (*pVertex[i])(j) < (*rhs.pVertex[i])(j);
+		}
+	}
+	if (mSpaceType != rhs.mSpaceType) return mSpaceType < rhs.mSpaceType;
+	return mSurfaceTypes < rhs.mSurfaceTypes;
+}
+
 std::ostream& operator <<(std::ostream& stream, const ms_space& space)
 {
 	stream << "R"
@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <bso/utilities/geometry.hpp>
+#include <bso/utilities/fingerprint.hpp>
 
 namespace bso { namespace spatial_design {
 
@@ -39,8 +40,10 @@ public:
 	bool getSurfaceTypes(std::vector<std::string>& surfaceTypes) const; // returns TRUE is surface types are asssigned FALSE if not. Assigns the surface types to the argument that is passed by reference
 	double getVolume() const;
 	double getFloorArea() const;
+	utilities::fingerprint getFingerprint(const double& tol = 1e-3) const; // hash of the geometry and types, excludes the ID
 	
 	bool operator == (const ms_space& rhs) const;
+	bool operator < (const ms_space& rhs) const; // lexicographic order on ID, geometry, and types
 	bool operator != (const ms_space& rhs) const;
 	
 	friend std::ostream& operator<< (std::ostream& stream, const ms_space& space);
@@ -17,7 +17,8 @@ namespace bso { namespace spatial_design {
 	
 sc_building::sc_building()
 {
-	
+	mBWordCount = 0;
+	this->updateCoordinates();
 } // sc_building()
 
 sc_building::sc_building(std::string input, std::string separators /*= ","*/)
@@ -26,6 +27,7 @@ sc_building::sc_building(std::string input, std::string separators /*= ","*/)
 	bool readFromLine = true;
 	std::string fileError = "";
 	std::string stringError = "";
+	std::vector<std::vector<int> > bValues;
 
 	std::ifstream inputStream;
 	try
@@ -41,69 +43,7 @@ sc_building::sc_building(std::string input, std::string separators /*= ","*/)
 			throw std::invalid_argument(errorMessage.str());
 		}
 
-		std::string line;
-		
-		boost::char_separator<char> sep(separators.c_str());
-		typedef boost::tokenizer< boost::char_separator<char> > t_tokenizer;
-		
-		while (!inputStream.eof())
-		{
-			getline(inputStream,line);
-			if (line == "") continue;
-			try
-			{
-				t_tokenizer tok(line, sep);
-				t_tokenizer::iterator token = tok.begin();
-				
-				char tokenID;
-				try 
-				{
-					tokenID = bso::utilities::trim_and_cast_char(*(token++));
-				}
-				catch (std::invalid_argument& e)
-				{
-					continue;
-				}
-				switch(tokenID)
-				{
-					case 'w':
-					{
-						while (token != tok.end()) mWValues.push_back(bso::utilities::trim_and_cast_double(*(token++)));
-						break;
-					}
-					case 'd':
-					{
-						while (token != tok.end()) mDValues.push_back(bso::utilities::trim_and_cast_double(*(token++)));
-						break;
-					}
-					case 'h':
-					{
-						while (token != tok.end()) mHValues.push_back(bso::utilities::trim_and_cast_double(*(token++)));
-						break;
-					}
-					case 'b':
-					{
-						std::vector<int> row;
-						while (token != tok.end()) row.push_back(bso::utilities::trim_and_cast_int(*(token++)));
-						mBValues.push_back(row);
-						break;
-					}
-					default:
-					{
-						continue;
-					}
-				}
-			}
-			catch(std::exception& e)
-			{
-				std::stringstream errorMessage;
-				errorMessage << "Encountered an error while parsing the following line of an SC input file:" << std::endl
-										 << line << std::endl
-										 << "(bso/spatial_design/sc_building.cpp). Got the following error: " << std::endl
-										 << e.what() << std::endl;
-				throw std::invalid_argument(errorMessage.str());
-			}
-		}
+		this->readFromStream(inputStream, separators, bValues);
 	}
 	catch(std::exception& e)
 	{
@@ -129,13 +69,13 @@ sc_building::sc_building(std::string input, std::string separators /*= ","*/)
 			mWValues = std::vector<double>(w);
 			mDValues = std::vector<double>(d);
 			mHValues = std::vector<double>(h);
-			mBValues = std::vector<std::vector<int> >(b);
+			bValues = std::vector<std::vector<int> >(b);
 			
 			for (auto&& i : mWValues) i = 1000 * bso::utilities::trim_and_cast_double(*(++token));
 			for (auto&& i : mDValues) i = 1000 * bso::utilities::trim_and_cast_double(*(++token));
 			for (auto&& i : mHValues) i = 1000 * bso::utilities::trim_and_cast_double(*(++token));
 			unsigned int count = 1;
-			for (auto&& i : mBValues)
+			for (auto&& i : bValues)
 			{
 				i = std::vector<int>(w*d*h);
 				unsigned int cellIndex = 0;
@@ -188,6 +128,8 @@ sc_building::sc_building(std::string input, std::string separators /*= ","*/)
 
 	try 
 	{
+		this->updateCoordinates();
+		this->setBValues(bValues);
 		this->checkValidity();
 	}
 	catch (std::exception& e)
@@ -202,12 +144,26 @@ sc_building::sc_building(std::string input, std::string separators /*= ","*/)
 	}
 } // sc_building()
 
+sc_building::sc_building(std::istream& input, std::string separators /*= "\t,; "*/)
+{ // initialization by input stream
+	std::vector<std::vector<int> > bValues;
+	this->readFromStream(input, separators, bValues);
+	this->updateCoordinates();
+	this->setBValues(bValues);
+	this->checkValidity();
+} // sc_building()
+
 sc_building::sc_building(const sc_building& rhs)
 {
 	mWValues = rhs.mWValues;
 	mDValues = rhs.mDValues;
 	mHValues = rhs.mHValues;
-	mBValues = rhs.mBValues;
+	mWCoords = rhs.mWCoords;
+	mDCoords = rhs.mDCoords;
+	mHCoords = rhs.mHCoords;
+	mBIDs = rhs.mBIDs;
+	mBBits = rhs.mBBits;
+	mBWordCount = rhs.mBWordCount;
 	
 	this->checkValidity();
 } // sc_building()
@@ -217,12 +173,78 @@ sc_building::~sc_building()
 	
 } // ~sc_building()
 
-void sc_building::checkValidity() const
-{
-	// check if the number of elements in each mBValues is correct
-	unsigned int checkSize = getBRowSize();
+void sc_building::readFromStream(std::istream& input, const std::string& separators,
+	std::vector<std::vector<int> >& bValues)
+{ // parses the w, d, h, and b lines of an SC input
+	std::string line;
+	
+	boost::char_separator<char> sep(separators.c_str());
+	typedef boost::tokenizer< boost::char_separator<char> > t_tokenizer;
+	
+	while (getline(input,line))
+	{
+		if (line == "") continue;
+		try
+		{
+			t_tokenizer tok(line, sep);
+			t_tokenizer::iterator token = tok.begin();
+			
+			char tokenID;
+			try 
+			{
+				tokenID = bso::utilities::trim_and_cast_char(*(token++));
+			}
+			catch (std::invalid_argument& e)
+			{
+				continue;
+			}
+			switch(tokenID)
+			{
+				case 'w':
+				{
+					while (token != tok.end()) mWValues.push_back(bso::utilities::trim_and_cast_double(*(token++)));
+					break;
+				}
+				case 'd':
+				{
+					while (token != tok.end()) mDValues.push_back(bso::utilities::trim_and_cast_double(*(token++)));
+					break;
+				}
+				case 'h':
+				{
+					while (token != tok.end()) mHValues.push_back(bso::utilities::trim_and_cast_double(*(token++)));
+					break;
+				}
+				case 'b':
+				{
+					std::vector<int> row;
+					while (token != tok.end()) row.push_back(bso::utilities::trim_and_cast_int(*(token++)));
+					bValues.push_back(row);
+					break;
+				}
+				default:
+				{
+					continue;
+				}
+			}
+		}
+		catch(std::exception& e)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "Encountered an error while parsing the following line of an SC input file:" << std::endl
+									 << line << std::endl
+									 << "(bso/spatial_design/sc_building.cpp). Got the following error: " << std::endl
+									 << e.what() << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+	}
+} // readFromStream()
 
-	for (auto i : mBValues)
+void sc_building::setBValues(const std::vector<std::vector<int> >& bValues)
+{ // packs b vectors of the form {ID, cell_1, ..., cell_n}
+	// check if the number of elements in each b vector is correct
+	unsigned int checkSize = getBRowSize();
+	for (const auto& i : bValues)
 	{
 		if (i.size() - 1 != checkSize)
 		{
@@ -233,21 +255,76 @@ void sc_building::checkValidity() const
 			throw std::logic_error(errorMessage.str());
 		}
 	}
-	for (auto i : mBValues)
+	
+	mBWordCount = (checkSize + 63) / 64;
+	mBIDs.clear();
+	mBBits.assign(bValues.size() * mBWordCount, 0);
+	for (unsigned int i = 0; i < bValues.size(); i++)
 	{
-		for (unsigned int j = 1; j < i.size(); j++)
+		mBIDs.push_back(bValues[i][0]);
+		uint64_t* words = mBBits.data() + i * mBWordCount;
+		for (unsigned int j = 1; j < bValues[i].size(); j++)
 		{
-			if (i[j] != 0 && i[j] != 1)
+			if (bValues[i][j] == 1) words[(j-1)/64] |= (uint64_t(1) << ((j-1)%64));
+			else if (bValues[i][j] != 0)
 			{
 				std::stringstream errorMessage;
-				errorMessage << "Cell values of supercube are invalid, encountered a cell value of: " << i[j] << std::endl 
-										 << "At index (w,d,h): " << getWIndex(j+1) << "," << getDIndex(j+1) << "," << getHIndex(j+1) << "."
+				errorMessage << "Cell values of supercube are invalid, encountered a cell value of: " << bValues[i][j] << std::endl 
+										 << "At index (w,d,h): " << getWIndex(j) << "," << getDIndex(j) << "," << getHIndex(j) << "."
 										 << "Only ones and zeros are allowed. (bso/spatial_design/sc_building.cpp)" << std::endl;
 				throw std::logic_error(errorMessage.str());
 			}
 		}
 	}
+} // setBValues()
+
+void sc_building::updateCoordinates()
+{ // recomputes the prefix sums of the W, D, and H vectors
+	std::vector<const std::vector<double>*> values = {&mWValues, &mDValues, &mHValues};
+	std::vector<std::vector<double>*> coords = {&mWCoords, &mDCoords, &mHCoords};
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		coords[i]->assign(1, 0.0);
+		for (const auto& j : *values[i]) coords[i]->push_back(coords[i]->back() + j);
+	}
+} // updateCoordinates()
+
+void sc_building::checkValidity() const
+{
+	// check if the bitmasks match the size of the supercube
+	unsigned int checkSize = getBRowSize();
+	if (mBWordCount != (checkSize + 63) / 64 || mBBits.size() != mBIDs.size() * mBWordCount)
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Size of supercube bitmask is incorrect, found " << mBBits.size() << " words for "
+								 << mBIDs.size() << " spaces, expected " << (checkSize + 63) / 64 << " words per space"
+								 << "(bso/spatial_design/sc_building.cpp)" << std::endl;
+		throw std::logic_error(errorMessage.str());
+	}
+	if (mWCoords.size() != mWValues.size() + 1 || mDCoords.size() != mDValues.size() + 1 ||
+			mHCoords.size() != mHValues.size() + 1)
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Coordinate tables of supercube are out of date "
+								 << "(bso/spatial_design/sc_building.cpp)" << std::endl;
+		throw std::logic_error(errorMessage.str());
+	}
 	
+	// check that no bits are set beyond the last cell
+	if (checkSize % 64 != 0)
+	{
+		uint64_t padding = ~((uint64_t(1) << (checkSize % 64)) - 1);
+		for (unsigned int i = 0; i < mBIDs.size(); i++)
+		{
+			if (getBWords(i)[mBWordCount-1] & padding)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "Supercube bitmask of space " << mBIDs[i] << " has cells beyond the last cell "
+										 << "(bso/spatial_design/sc_building.cpp)" << std::endl;
+				throw std::logic_error(errorMessage.str());
+			}
+		}
+	}
 } // checkValidity()
 
 void sc_building::writeToFile(const std::string& fileName) const
@@ -276,11 +353,12 @@ void sc_building::writeToFile(const std::string& fileName) const
 		if (first) first = false;
 	}
 
-	for (auto i : mBValues)
+	unsigned int nCells = getBRowSize();
+	for (unsigned int i = 0; i < mBIDs.size(); i++)
 	{
-		output << "\nb";
-		first = true;
-		for (auto j : i) output << "," << j;
+		output << "\nb," << mBIDs[i];
+		const uint64_t* words = getBWords(i);
+		for (unsigned int j = 0; j < nCells; j++) output << "," << ((words[j/64] >> (j%64)) & 1);
 	}
 	
 	output.close();
@@ -292,27 +370,24 @@ std::string sc_building::writeToString(char separator /*= ','*/) const
 	stream << mWValues.size()
 				 << separator << mDValues.size()
 				 << separator << mHValues.size()
-				 << separator << mBValues.size();
+				 << separator << mBIDs.size();
 	
 	for (const auto& i : mWValues) stream << separator << i/1000;
 	for (const auto& i : mDValues) stream << separator << i/1000;
 	for (const auto& i : mHValues) stream << separator << i/1000;
 	
-	for (const auto& i : mBValues)
+	unsigned int nCells = getBRowSize();
+	for (unsigned int i = 0; i < mBIDs.size(); i++)
 	{
-		bool first = true;
-		for (const auto& j : i)
-		{
-			if (first) first = false;
-			else stream << separator << j;
-		}
+		const uint64_t* words = getBWords(i);
+		for (unsigned int j = 0; j < nCells; j++) stream << separator << ((words[j/64] >> (j%64)) & 1);
 	}
 	return stream.str();
 }
 
 bool sc_building::isEmpty() const
 { // returns true if any of the W, D, H, or B vectors are empty
-	return (mWValues.empty() || mDValues.empty() || mHValues.empty() || mBValues.empty());
+	return (mWValues.empty() || mDValues.empty() || mHValues.empty() || mBIDs.empty());
 }
 
 unsigned int sc_building::getWIndex(const unsigned int& cellIndex) const
@@ -392,12 +467,12 @@ unsigned int sc_building::getCellIndex(const unsigned int& wIndex, const unsigne
 								 << "Supercube is empty (bso/spatial_design/ms_building.cpp)." << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
-	if (wIndex >= mWValues.size() || dIndex >= mDValues.size() || hIndex >= mHValues.size() || spaceIndex >= mBValues.size())
+	if (wIndex >= mWValues.size() || dIndex >= mDValues.size() || hIndex >= mHValues.size() || spaceIndex >= mBIDs.size())
 	{
 		std::stringstream errorMessage;
 		errorMessage << "Cannot get cell index at specified indices (w,d,h,l): " << wIndex << "," << dIndex << "," << hIndex << "," << spaceIndex << std::endl
 								 << "At least one of the indices is out of range:" << std::endl
-								 << "should be greater or equal to zero or smaller than (w,d,h,l): " << mWValues.size() << "," << mWValues.size() << "," << mDValues.size() << "," << mHValues.size() << "," << mBValues.size() << std::endl
+								 << "should be greater or equal to zero or smaller than (w,d,h,l): " << mWValues.size() << "," << mWValues.size() << "," << mDValues.size() << "," << mHValues.size() << "," << mBIDs.size() << std::endl
 								 << "(bso/spatial_design/ms_building.cpp)." << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
@@ -421,7 +496,7 @@ unsigned int sc_building::getHSize() const
 
 unsigned int sc_building::getBSize() const
 { // get the size of the W vector
-	return mBValues.size();
+	return mBIDs.size();
 } // getBSize()
 
 unsigned int sc_building::getBRowSize() const
@@ -445,9 +520,9 @@ bool sc_building::getSpaceIndex(const unsigned int& cellIndex, unsigned int& spa
 								 << "Index exceeds vector bounds (bso/spatial_design/ms_building.cpp)." << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
-	for (unsigned int i = 0; i < mBValues.size(); i++)
+	for (unsigned int i = 0; i < mBIDs.size(); i++)
 	{
-		if (mBValues[i][cellIndex] == 1)
+		if (getBValue(i,cellIndex) == 1)
 		{
 			spaceIndex = i;
 			return true;
@@ -492,31 +567,121 @@ double sc_building::getHValue(const unsigned int& index) const
 	else return mHValues[index];
 } // getHValue()
 
+double sc_building::getWCoordinate(const unsigned int& index) const
+{ // returns the sum of the W values before the specified index
+	if (index >= mWCoords.size())
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Cannot get W-coordinate at specified index: " << index << std::endl
+								 << "Index exceeds vector bounds (bso/spatial_design/sc_building.cpp)." << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+	else return mWCoords[index];
+} // getWCoordinate()
+
+double sc_building::getDCoordinate(const unsigned int& index) const
+{ // returns the sum of the D values before the specified index
+	if (index >= mDCoords.size())
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Cannot get D-coordinate at specified index: " << index << std::endl
+								 << "Index exceeds vector bounds (bso/spatial_design/sc_building.cpp)." << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+	else return mDCoords[index];
+} // getDCoordinate()
+
+double sc_building::getHCoordinate(const unsigned int& index) const
+{ // returns the sum of the H values before the specified index
+	if (index >= mHCoords.size())
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Cannot get H-coordinate at specified index: " << index << std::endl
+								 << "Index exceeds vector bounds (bso/spatial_design/sc_building.cpp)." << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+	else return mHCoords[index];
+} // getHCoordinate()
+
 int sc_building::getBValue(const unsigned int& spaceIndex, const unsigned int& cellIndex) const
 {  // returns the B value at the specified indices
-	if (spaceIndex >= mBValues.size())
+	if (spaceIndex >= mBIDs.size())
 	{
 		std::stringstream errorMessage;
 		errorMessage << "Cannot get B value at specified space index: " << spaceIndex << std::endl
 								 << "Index exceeds vector bounds (bso/spatial_design/ms_building.cpp)." << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
-	else if (cellIndex >= mBValues[spaceIndex].size())
+	else if (cellIndex > getBRowSize())
 	{
 		std::stringstream errorMessage;
 		errorMessage << "Cannot get cell value at specified cell index: " << cellIndex << std::endl
 								 << "Index exceeds vector bounds (bso/spatial_design/ms_building.cpp)." << std::endl;
 		throw std::invalid_argument(errorMessage.str());
 	}
-	else return mBValues[spaceIndex][cellIndex];
+	else if (cellIndex == 0) return mBIDs[spaceIndex];
+	else return (getBWords(spaceIndex)[(cellIndex-1)/64] >> ((cellIndex-1)%64)) & 1;
 } // getBValue()
 
+unsigned int sc_building::getCellCount(const unsigned int& spaceIndex) const
+{ // returns the number of active cells of the specified space
+	if (spaceIndex >= mBIDs.size())
+	{
+		std::stringstream errorMessage;
+		errorMessage << "Cannot count cells of space at specified index: " << spaceIndex << std::endl
+								 << "Index exceeds vector bounds (bso/spatial_design/sc_building.cpp)." << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+	unsigned int count = 0;
+	const uint64_t* words = getBWords(spaceIndex);
+	for (unsigned int i = 0; i < mBWordCount; i++) count += __builtin_popcountll(words[i]);
+	return count;
+} // getCellCount()
+
+bool sc_building::hasOverlappingCells() const
+{ // returns true if any cell is active for more than one space
+	std::vector<uint64_t> occupied(mBWordCount, 0);
+	for (unsigned int i = 0; i < mBIDs.size(); i++)
+	{
+		const uint64_t* words = getBWords(i);
+		for (unsigned int j = 0; j < mBWordCount; j++)
+		{
+			if (occupied[j] & words[j]) return true;
+			occupied[j] |= words[j];
+		}
+	}
+	return false;
+} // hasOverlappingCells()
+
+utilities::fingerprint sc_building::getFingerprint(const double& tol /*= 1e-3*/) const
+{ // independent of the order of the spaces, excludes space IDs
+	utilities::fingerprint f;
+	for (const auto& i : {&mWValues, &mDValues, &mHValues})
+	{
+		f.combine(uint64_t(i->size()));
+		for (const auto& j : *i) f.combine(j, tol);
+	}
+	
+	utilities::fingerprint spaces;
+	for (unsigned int i = 0; i < mBIDs.size(); i++)
+	{
+		utilities::fingerprint space;
+		const uint64_t* words = getBWords(i);
+		for (unsigned int j = 0; j < mBWordCount; j++) space.combine(words[j]);
+		spaces.add(space);
+	}
+	f.combine(spaces.getFirst());
+	f.combine(spaces.getSecond());
+	return f;
+} // getFingerprint()
+
 bool sc_building::operator == (const sc_building& rhs)
 {
 	if (mWValues != rhs.mWValues) return false;
 	if (mDValues != rhs.mDValues) return false;
 	if (mHValues != rhs.mHValues) return false;
-	if (mBValues != rhs.mBValues) return false;
+	if (mBIDs != rhs.mBIDs) return false;
+	if (mBBits != rhs.mBBits) return false;
 	return true;
 } // operator ==
 
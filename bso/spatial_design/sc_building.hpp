@@ -2,7 +2,10 @@
 #define SC_BUILDING_HPP
 
 #include <sstream>
+#include <istream>
 #include <vector>
+#include <cstdint>
+#include <bso/utilities/fingerprint.hpp>
 
 namespace bso { namespace spatial_design {
 
@@ -12,14 +15,25 @@ private:
 	std::vector<double> mWValues;
 	std::vector<double> mDValues;
 	std::vector<double> mHValues;
-	std::vector<std::vector<int> > mBValues;
+	std::vector<double> mWCoords; // prefix sums of the W, D, and H vectors, starting at zero
+	std::vector<double> mDCoords;
+	std::vector<double> mHCoords;
+	std::vector<int> mBIDs; // space ID of each b vector
+	std::vector<uint64_t> mBBits; // cell bitmasks of all spaces, 64 cells per word, mBWordCount words per space
+	unsigned int mBWordCount;
 
 	void checkValidity() const;
+	void readFromStream(std::istream& input, const std::string& separators,
+		std::vector<std::vector<int> >& bValues);
+	void setBValues(const std::vector<std::vector<int> >& bValues); // packs b vectors of the form {ID, cell_1, ..., cell_n}
+	void updateCoordinates(); // recomputes the prefix sums of the W, D, and H vectors
+	const uint64_t* getBWords(const unsigned int& spaceIndex) const {return mBBits.data() + spaceIndex * mBWordCount;}
 	
 	friend class ms_building;
 public:
 	sc_building();
 	sc_building(std::string input, std::string separators = "\t,; ");
+	sc_building(std::istream& input, std::string separators = "\t,; ");
 	sc_building(const sc_building& rhs);
 	~sc_building();
 	
@@ -43,7 +57,13 @@ public:
 	double getWValue(const unsigned int& index) const; // returns the W value at the specified index
 	double getDValue(const unsigned int& index) const; // returns the D value at the specified index
 	double getHValue(const unsigned int& index) const; // returns the H value at the specified index
+	double getWCoordinate(const unsigned int& index) const; // returns the sum of the W values before the specified index
+	double getDCoordinate(const unsigned int& index) const; // returns the sum of the D values before the specified index
+	double getHCoordinate(const unsigned int& index) const; // returns the sum of the H values before the specified index
 	int getBValue(const unsigned int& spaceIndex, const unsigned int& cellIndex) const;  // returns the B value at the specified indices
+	unsigned int getCellCount(const unsigned int& spaceIndex) const; // returns the number of active cells of the specified space
+	bool hasOverlappingCells() const; // returns true if any cell is active for more than one space
+	utilities::fingerprint getFingerprint(const double& tol = 1e-3) const; // independent of the order of the spaces, excludes space IDs
 	
 	bool operator == (const sc_building& rhs); // checks if two supercubes are equal
 	bool operator != (const sc_building& rhs); // checks if two supercubes differ
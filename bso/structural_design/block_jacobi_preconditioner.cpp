@@ -0,0 +1,111 @@
+#ifndef SD_BLOCK_JACOBI_PRECONDITIONER_CPP
+#define SD_BLOCK_JACOBI_PRECONDITIONER_CPP
+
+#include <sstream>
+#include <stdexcept>
+
+namespace bso { namespace structural_design {
+
+	block_jacobi_preconditioner::block_jacobi_preconditioner()
+	{
+
+	} // ctor()
+
+	template <class MATRIX>
+	block_jacobi_preconditioner::block_jacobi_preconditioner(const MATRIX& mat)
+	{
+		this->compute(mat);
+	} // ctor()
+
+	void block_jacobi_preconditioner::setBlockSizes(const std::vector<unsigned long>& blockSizes)
+	{
+		for (const auto& i : blockSizes)
+		{
+			if (i == 0 || i > 6)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nError, block Jacobi preconditioner received a block of size: " << i << "\n"
+										 << "blocks should contain one to six rows.\n"
+										 << "(bso/structural_design/block_jacobi_preconditioner.cpp)" << std::endl;
+				throw std::invalid_argument(errorMessage.str());
+			}
+		}
+		mRequestedBlockSizes = blockSizes;
+	} // setBlockSizes()
+
+	template <class MATRIX>
+	block_jacobi_preconditioner& block_jacobi_preconditioner::analyzePattern(const MATRIX& mat)
+	{
+		mSize = mat.rows();
+		mBlockOffsets.clear();
+		unsigned long offset = 0;
+		if (mRequestedBlockSizes.empty()) mBlockSizes.assign(mSize, 1);
+		else mBlockSizes = mRequestedBlockSizes;
+		for (const auto& i : mBlockSizes)
+		{
+			mBlockOffsets.push_back(offset);
+			offset += i;
+		}
+		if (offset != (unsigned long)mSize || mat.cols() != mSize)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, the blocks of a block Jacobi preconditioner cover " << offset << " rows,\n"
+									 << "while the matrix has " << mat.rows() << " rows and " << mat.cols() << " columns.\n"
+									 << "(bso/structural_design/block_jacobi_preconditioner.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		return *this;
+	} // analyzePattern()
+
+	template <class MATRIX>
+	block_jacobi_preconditioner& block_jacobi_preconditioner::factorize(const MATRIX& mat)
+	{
+		mInverses.resize(mBlockSizes.size());
+		for (unsigned long i = 0; i < mBlockSizes.size(); ++i)
+		{
+			const unsigned long n = mBlockSizes[i], offset = mBlockOffsets[i];
+			block b(n,n);
+			for (unsigned long j = 0; j < n; ++j)
+			{
+				for (unsigned long k = 0; k < n; ++k) b(j,k) = mat.coeff(offset + j, offset + k);
+			}
+			Eigen::LDLT<block> ldlt(b);
+			if (ldlt.info() == Eigen::Success && (ldlt.vectorD().array() > 0).all())
+			{
+				mInverses[i] = ldlt.solve(block::Identity(n,n));
+			}
+			else
+			{ // fall back to the diagonal of a block that is not positive definite
+				mInverses[i].setZero(n,n);
+				for (unsigned long j = 0; j < n; ++j)
+				{
+					mInverses[i](j,j) = (b(j,j) != 0)? 1.0/b(j,j) : 1.0;
+				}
+			}
+		}
+		return *this;
+	} // factorize()
+
+	template <class MATRIX>
+	block_jacobi_preconditioner& block_jacobi_preconditioner::compute(const MATRIX& mat)
+	{
+		this->analyzePattern(mat);
+		return this->factorize(mat);
+	} // compute()
+
+	template <class RHS>
+	Eigen::VectorXd block_jacobi_preconditioner::solve(const Eigen::MatrixBase<RHS>& b) const
+	{
+		Eigen::VectorXd x(b.rows());
+		for (unsigned long i = 0; i < mBlockSizes.size(); ++i)
+		{
+			x.segment(mBlockOffsets[i], mBlockSizes[i]) =
+				mInverses[i] * b.segment(mBlockOffsets[i], mBlockSizes[i]);
+		}
+		return x;
+	} // solve()
+
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_BLOCK_JACOBI_PRECONDITIONER_CPP
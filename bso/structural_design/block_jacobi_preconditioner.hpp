@@ -0,0 +1,50 @@
+#ifndef SD_BLOCK_JACOBI_PRECONDITIONER_HPP
+#define SD_BLOCK_JACOBI_PRECONDITIONER_HPP
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <vector>
+
+namespace bso { namespace structural_design {
+
+	class block_jacobi_preconditioner
+	{ // preconditioner for Eigen's iterative solvers that inverts the diagonal blocks of a matrix,
+		// e.g. the (at most 6x6) blocks of the DOFs of each node. Without blocks it is a diagonal preconditioner
+	private:
+		typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, 6, 6> block;
+		std::vector<unsigned long> mRequestedBlockSizes;
+		std::vector<unsigned long> mBlockSizes; // the requested sizes, or blocks of one row
+		std::vector<unsigned long> mBlockOffsets;
+		std::vector<block, Eigen::aligned_allocator<block> > mInverses;
+		Eigen::Index mSize = 0;
+	public:
+		typedef int StorageIndex;
+		enum {ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic};
+
+		block_jacobi_preconditioner();
+		template <class MATRIX>
+		explicit block_jacobi_preconditioner(const MATRIX& mat);
+
+		void setBlockSizes(const std::vector<unsigned long>& blockSizes); // consecutive blocks on the diagonal, each of at most six rows
+
+		template <class MATRIX>
+		block_jacobi_preconditioner& analyzePattern(const MATRIX& mat);
+		template <class MATRIX>
+		block_jacobi_preconditioner& factorize(const MATRIX& mat);
+		template <class MATRIX>
+		block_jacobi_preconditioner& compute(const MATRIX& mat);
+
+		template <class RHS>
+		Eigen::VectorXd solve(const Eigen::MatrixBase<RHS>& b) const;
+
+		Eigen::Index rows() const {return mSize;}
+		Eigen::Index cols() const {return mSize;}
+		Eigen::ComputationInfo info() {return Eigen::Success;}
+	};
+
+} // namespace structural_design
+} // namespace bso
+
+#include <bso/structural_design/block_jacobi_preconditioner.cpp>
+
+#endif // SD_BLOCK_JACOBI_PRECONDITIONER_HPP
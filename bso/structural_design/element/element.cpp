@@ -18,13 +18,15 @@ namespace bso { namespace structural_design { namespace element {
 
 	void element::generateEFT()
 	{ //
-		mEFT.clear();unsigned int count = 0;
-		unsigned int localDOF = 0;
+		mEFT.clear();
+		mEFT.reserve(mNodes.size() * mEFS.sum());
 		for (const auto& i : mNodes)
 		{
+			const std::array<unsigned long, 6>& NFT = i->getNFT();
 			for (unsigned int j = 0; j < 6; ++j)
 			{
-				if (i->getNFS(j) == 0 && mEFS(j) == 1)
+				if (mEFS(j) == 0) continue;
+				if (i->getNFS(j) == 0)
 				{
 					std::stringstream errorMessage;
 					errorMessage << "Error, nodal DOF is not active, while it should be.\n"
@@ -32,22 +34,7 @@ namespace bso { namespace structural_design { namespace element {
 											 << "(bso/structural_design/element.cpp)" << std::endl;
 					throw std::runtime_error(errorMessage.str());
 				}
-				if (mEFS(j) == 1)
-				{
-					try
-					{
-						if (i->getConstraint(j) == 0) mEFT[localDOF] = i->getGlobalDOF(j);
-					}
-					catch (std::exception& e)
-					{
-						std::stringstream errorMessage;
-						errorMessage << "\nError while generating element freedom table.\n"
-												 << "Received the following error:\n" << e.what()
-												 << "\n(bso/structural_design/element.cpp)" << std::endl;
-						throw std::runtime_error(errorMessage.str());
-					}
-					++localDOF;
-				}
+				mEFT.push_back(NFT[j]); // inactiveDOF if the DOF is constrained
 			}
 		}
 	} //
@@ -55,48 +42,84 @@ namespace bso { namespace structural_design { namespace element {
 	std::vector<triplet> element::getSMTriplets() const
 	{ //
 		std::vector<triplet> tripletList;
-		for (unsigned int m = 0; m < mSM.rows(); ++m)
+		tripletList.reserve(mSM.size());
+		for (unsigned int m = 0; m < mSM.rows() && m < mEFT.size(); ++m)
 		{
-			for (unsigned int n = 0; n < mSM.cols(); ++n)
+			if (mEFT[m] == inactiveDOF) continue;
+			for (unsigned int n = 0; n < mSM.cols() && n < mEFT.size(); ++n)
 			{
-				if ((mSM(m,n) != 0) && (mEFT.find(m) != mEFT.end()) && (mEFT.find(n) != mEFT.end()))
+				if ((mSM(m,n) != 0) && (mEFT[n] != inactiveDOF))
 				{
-					tripletList.push_back(triplet(mEFT.at(m),mEFT.at(n),mSM(m,n))); // have to use map::at() because triplet initializer takes non const argument by reference
+					tripletList.push_back(triplet(mEFT[m],mEFT[n],mSM(m,n)));
 				}
 			}
 		}
 		return tripletList;
 	} //
 
+	long element::responseIndex(const load_case& lc) const
+	{ //
+		if (mResponseBuffer != nullptr) return mResponseBuffer->loadCaseIndex(lc);
+		for (unsigned long i = 0; i < mLoadCases.size(); ++i)
+		{
+			if (mLoadCases[i] == lc) return i;
+		}
+		return -1;
+	} // responseIndex()
+
+	void element::storeResponse(const load_case& lc, const Eigen::VectorXd& elementDisplacements)
+	{ //
+		long index = this->responseIndex(lc);
+		if (index < 0)
+		{
+			index = mLoadCases.size();
+			mLoadCases.push_back(lc);
+			mDisplacements.conservativeResize(elementDisplacements.size(), mLoadCases.size());
+			mEnergies.conservativeResize(mLoadCases.size());
+		}
+		else mTotalEnergy -= mEnergies(index);
+		mDisplacements.col(index) = elementDisplacements;
+		mEnergies(index) = 0.5 * elementDisplacements.transpose() * mSM * elementDisplacements;
+		mTotalEnergy += mEnergies(index);
+	} // storeResponse()
+
 	void element::computeResponse(load_case lc)
 	{ //
+		mResponseBuffer = nullptr;
 		Eigen::VectorXd elementDisplacements(mSM.rows());
 		elementDisplacements.setZero();
 		auto dispIte = elementDisplacements.data();
 
 		for (const auto& i : mNodes)
 		{
+			Eigen::Vector6d nodalDisplacements = i->getDisplacements(lc);
 			for (unsigned int j = 0; j < 6; ++j)
 			{
 				if (mEFS(j) == 1)
 				{
-					*dispIte = i->getDisplacements(lc)(j);
+					*dispIte = nodalDisplacements(j);
 					++dispIte;
 				}
 			}
 		}
-		mDisplacements[lc] = elementDisplacements;
-		mEnergies[lc] = 0.5 * elementDisplacements.transpose() * mSM * elementDisplacements;
-		mTotalEnergy += mEnergies[lc];
+		this->storeResponse(lc, elementDisplacements);
+		this->computeStress(elementDisplacements);
 	} //
 	
 	void element::clearResponse()
 	{ // 
-		mDisplacements.clear();
-		mEnergies.clear();
+		mLoadCases.clear();
+		mDisplacements.resize(0,0);
+		mEnergies.resize(0);
 		mTotalEnergy = 0;
 	} // clearResponse()
 	
+	void element::setResponseBuffer(const response_buffer* buffer, const unsigned long& index)
+	{
+		mResponseBuffer = buffer;
+		mResponseIndex = index;
+	} // setResponseBuffer()
+	
 	void element::updateDensity(const double& x, const double& penal /*= 1*/, std::string type /*= "modifiedSIMP"*/)
 	{
 		if (type == "modifiedSIMP")
@@ -123,13 +146,18 @@ namespace bso { namespace structural_design { namespace element {
 	
 	double element::getTotalEnergy(const std::string& type /*= ""*/) const
 	{
-		if (type == "") return mTotalEnergy;
-		else return 0.0;
+		if (type != "") return 0.0;
+		if (mResponseBuffer == nullptr) return mTotalEnergy;
+		if ((long)mResponseIndex < mResponseBuffer->mTotalEnergies.size())
+		{
+			return mResponseBuffer->mTotalEnergies(mResponseIndex);
+		}
+		return 0.0;
 	} // getTotalEnergy()
 	
 	double element::getEnergySensitivity(const double& penal /* 1*/) const
 	{
-		return mTotalEnergy * (-(penal*pow(mDensity,penal - 1)*(mE0 - mEmin))/(mEmin + pow(mDensity,penal)*(mE0 - mEmin)));
+		return element::getTotalEnergy() * (-(penal*pow(mDensity,penal - 1)*(mE0 - mEmin))/(mEmin + pow(mDensity,penal)*(mE0 - mEmin)));
 	} // getEnergySensitivity()
 	
 	double element::getVolumeSensitivity() const
@@ -163,9 +191,11 @@ namespace bso { namespace structural_design { namespace element {
 
 	const double& element::getEnergy(load_case lc, const std::string& type/*= ""*/) const
 	{ //
-		if (mEnergies.find(lc) != mEnergies.end())
+		long index = this->responseIndex(lc);
+		if (index >= 0)
 		{
-			return mEnergies.find(lc)->second;
+			if (mResponseBuffer == nullptr) return mEnergies(index);
+			return mResponseBuffer->mEnergies(mResponseIndex, index);
 		}
 		else
 		{
@@ -177,11 +207,18 @@ namespace bso { namespace structural_design { namespace element {
 		}
 	} //
 
-	const Eigen::VectorXd& element::getDisplacements(load_case lc) const
+	Eigen::VectorXd element::getDisplacements(load_case lc) const
 	{ //
-		if (mDisplacements.find(lc) != mDisplacements.end())
+		long index = this->responseIndex(lc);
+		if (index >= 0)
 		{
-			return mDisplacements.find(lc)->second;
+			if (mResponseBuffer == nullptr) return mDisplacements.col(index);
+			Eigen::VectorXd elementDisplacements = Eigen::VectorXd::Zero(mEFT.size());
+			for (unsigned long i = 0; i < mEFT.size(); ++i)
+			{
+				if (mEFT[i] != inactiveDOF) elementDisplacements(i) = mResponseBuffer->mDisplacements(mEFT[i], index);
+			}
+			return elementDisplacements;
 		}
 		else
 		{
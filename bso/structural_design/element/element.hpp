@@ -23,14 +23,19 @@ namespace bso { namespace structural_design { namespace element {
 		std::vector<node*> mNodes; // pointers to the nodes of this element
 		Eigen::Vector6i mEFS; // the freedom signature of that belongs to each node of this element
 
-		std::map<unsigned int, unsigned long> mEFT; // element freedom table, the global DOF indices of each DOF of this element's node
+		std::vector<unsigned long> mEFT; // element freedom table, for each DOF of this element, its global DOF index or inactiveDOF if it is constrained
 		
 		Eigen::MatrixXd mOriginalSM; // the element stiffness matrix before applying topology densities
 		Eigen::MatrixXd mSM; // the element stiffness matrix after applying topology densities
 		
-		std::map<load_case, Eigen::VectorXd> mDisplacements;
-		std::map<load_case, double> mEnergies;
-		double mTotalEnergy;
+		// the responses, read from the response buffer of the FEA if this element is part of one,
+		// otherwise they are stored in this element by computeResponse()
+		const response_buffer* mResponseBuffer = nullptr;
+		unsigned long mResponseIndex = 0; // the row of this element in the response buffer
+		std::vector<load_case> mLoadCases; // in the order of the columns of mDisplacements and mEnergies
+		Eigen::MatrixXd mDisplacements; // column n contains the displacements of this element's DOFs in load case n
+		Eigen::VectorXd mEnergies; // coefficient n contains the energy in load case n
+		double mTotalEnergy = 0.0;
 		
 		// Variables related to the stiffness of this element, mostly related to topology optimization
 		double mDensity = 1.0; // element density
@@ -38,6 +43,9 @@ namespace bso { namespace structural_design { namespace element {
 		double mE0; // the initial youngs modulus [N/mm²]
 		double mE; // the actual youngs modulus [N/mm²]
 		
+		long responseIndex(const load_case& lc) const; // the column of the load case in the responses, -1 if there is none
+		virtual void storeResponse(const load_case& lc, const Eigen::VectorXd& elementDisplacements);
+		
 		// for identification
 		bool mIsTruss = false;
 		bool mIsBeam = false;
@@ -52,8 +60,10 @@ namespace bso { namespace structural_design { namespace element {
 		
 		virtual void generateEFT();
 		virtual std::vector<triplet> getSMTriplets() const;
-		virtual void computeResponse(load_case lc);
+		virtual void computeResponse(load_case lc); // from the displacements of the nodes
+		virtual void computeStress(const Eigen::VectorXd& elementDisplacements) {} // for elements that compute their stresses
 		virtual void clearResponse();
+		void setResponseBuffer(const response_buffer* buffer, const unsigned long& index); // nullptr uses the responses stored in this element
 		
 		virtual void updateDensity(const double& x, const double& penal = 1, std::string type = "modifiedSIMP");
 		
@@ -78,8 +88,12 @@ namespace bso { namespace structural_design { namespace element {
 		virtual bool& isActiveInCompliance() {return mActiveInCompliance;}
 		virtual const double& getDensity() const {return mDensity;}
 		virtual const double& getEnergy(load_case lc, const std::string& type = "") const;
-		virtual const Eigen::VectorXd& getDisplacements(load_case lc) const;
+		virtual Eigen::VectorXd getDisplacements(load_case lc) const;
 		const std::vector<node*>& getNodes() const {return mNodes;}
+		const std::vector<unsigned long>& getEFT() const {return mEFT;}
+		const Eigen::MatrixXd& getOriginalSM() const {return mOriginalSM;}
+		virtual std::vector<const Eigen::MatrixXd*> getSeparatedSMs() const {return {};} // the parts of the SM whose energies are reported separately
+		double getStiffnessFactor() const {return mE/mE0;} // mSM is mOriginalSM scaled by this factor
 		
 	};
 	
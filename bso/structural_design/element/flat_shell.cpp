@@ -292,33 +292,39 @@ namespace bso { namespace structural_design { namespace element {
 		
 	} // dtor
 	
-	void flat_shell::computeResponse(load_case lc)
+	long flat_shell::separatedEnergyIndex(const std::string& type)
+	{ // the row of the energy in the separated energies
+		if (type == "normal" || type == "axial") return 0;
+		else if (type == "shear") return 1;
+		else if (type == "bending") return 2;
+		else return -1;
+	} // separatedEnergyIndex()
+	
+	void flat_shell::storeResponse(const load_case& lc, const Eigen::VectorXd& elementDisplacements)
 	{
-		Eigen::VectorXd elementDisplacements(mSM.rows());
-		elementDisplacements.setZero();
-		auto dispIte = elementDisplacements.data();
-		
-		for (const auto& i : mNodes)
+		long index = this->responseIndex(lc);
+		element::storeResponse(lc, elementDisplacements);
+		if (index < 0)
 		{
-			for (unsigned int j = 0; j < 6; ++j)
-			{
-				if (mEFS(j) == 1)
-				{
-					*dispIte = i->getDisplacements(lc)(j);
-					++dispIte;
-				}
-			}
+			index = mLoadCases.size() - 1;
+			mSeparatedEnergies.conservativeResize(Eigen::NoChange, mLoadCases.size());
 		}
-		mDisplacements[lc] = elementDisplacements;
-		mEnergies[lc] = 0.5 * elementDisplacements.transpose() * mSM * elementDisplacements;
-		mTotalEnergy += mEnergies[lc];
-		mSeparatedEnergies[lc]["normal"]  = 0.5 * elementDisplacements.transpose() * mSMNormal  * elementDisplacements;
-		mAxialEnergy += mSeparatedEnergies[lc]["normal"];
-		mSeparatedEnergies[lc]["shear"]   = 0.5 * elementDisplacements.transpose() * mSMShear   * elementDisplacements;
-		mShearEnergy += mSeparatedEnergies[lc]["shear"];
-		mSeparatedEnergies[lc]["bending"] = 0.5 * elementDisplacements.transpose() * mSMBending * elementDisplacements;
-		mBendEnergy += mSeparatedEnergies[lc]["bending"];
-
+		else
+		{
+			mAxialEnergy -= mSeparatedEnergies(0,index);
+			mShearEnergy -= mSeparatedEnergies(1,index);
+			mBendEnergy  -= mSeparatedEnergies(2,index);
+		}
+		mSeparatedEnergies(0,index) = 0.5 * elementDisplacements.transpose() * mSMNormal  * elementDisplacements;
+		mAxialEnergy += mSeparatedEnergies(0,index);
+		mSeparatedEnergies(1,index) = 0.5 * elementDisplacements.transpose() * mSMShear   * elementDisplacements;
+		mShearEnergy += mSeparatedEnergies(1,index);
+		mSeparatedEnergies(2,index) = 0.5 * elementDisplacements.transpose() * mSMBending * elementDisplacements;
+		mBendEnergy += mSeparatedEnergies(2,index);
+	} // storeResponse()
+	
+	void flat_shell::computeStress(const Eigen::VectorXd& elementDisplacements)
+	{
 		// stress calculation - NOTE: only in-plane stresses are considered (dKQ stresses are ignored) because of the application in topology optimization, in which stress gradients over the thickness of the element cannot be considered in a 2D case
 		Eigen::VectorXd elementDisp24DOF;
 		elementDisp24DOF.setZero(24);
@@ -340,12 +346,12 @@ namespace bso { namespace structural_design { namespace element {
 
 		mE0K0U.setZero(24);
 		mE0K0U = (mE0 / mE) * mSM * elementDisplacements; // for stress sensitivity
-	} // computeResponse()
+	} // computeStress()
 	
 	void flat_shell::clearResponse()
 	{
 		element::clearResponse();
-		mSeparatedEnergies.clear();
+		mSeparatedEnergies.resize(3,0);
 		mTotalEnergy = 0;
 		mShearEnergy = 0;
 		mAxialEnergy = 0;
@@ -370,7 +376,8 @@ namespace bso { namespace structural_design { namespace element {
 			}
 		}
 		
-		if (mSeparatedEnergies.find(lc) == mSeparatedEnergies.end())
+		long index = this->responseIndex(lc);
+		if (index < 0)
 		{
 			std::stringstream errorMessage;
 			errorMessage << "\nError, when retrieving energies from a flat shell element.\n"
@@ -379,7 +386,8 @@ namespace bso { namespace structural_design { namespace element {
 			throw std::invalid_argument(errorMessage.str());
 		}
 		
-		if (mSeparatedEnergies.find(lc)->second.find(type) == mSeparatedEnergies.find(lc)->second.end())
+		long typeIndex = separatedEnergyIndex(type);
+		if (typeIndex < 0)
 		{
 			std::stringstream errorMessage;
 			errorMessage << "\nError, when retrieving energies from a flat shell element.\n"
@@ -388,7 +396,8 @@ namespace bso { namespace structural_design { namespace element {
 			throw std::invalid_argument(errorMessage.str());
 		}
 		
-		return mSeparatedEnergies.find(lc)->second.find(type)->second;
+		if (mResponseBuffer == nullptr) return mSeparatedEnergies(typeIndex,index);
+		return mResponseBuffer->mSeparatedEnergies[typeIndex](mResponseIndex,index);
 	} // getEnergy
 	
 	double flat_shell::getTotalEnergy(const std::string& type /*= ""*/) const
@@ -397,19 +406,8 @@ namespace bso { namespace structural_design { namespace element {
 		{
 			return element::getTotalEnergy(type);
 		}
-		else if (type == "shear")
-		{
-			return mShearEnergy;
-		}
-		else if (type == "axial")
-		{
-			return mAxialEnergy;
-		}
-		else if (type == "bending")
-		{
-			return mBendEnergy;
-		}
-		else
+		long typeIndex = separatedEnergyIndex(type);
+		if (typeIndex < 0)
 		{
 			std::stringstream errorMessage;
 			errorMessage << "\nError, when retrieving total energy from a flat shell element.\n"
@@ -417,6 +415,17 @@ namespace bso { namespace structural_design { namespace element {
 									 << "(bso/structural_design/element/flat_shell.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
+		if (mResponseBuffer == nullptr)
+		{
+			if (typeIndex == 0) return mAxialEnergy;
+			else if (typeIndex == 1) return mShearEnergy;
+			else return mBendEnergy;
+		}
+		if ((long)mResponseIndex < mResponseBuffer->mSeparatedTotalEnergies.rows())
+		{
+			return mResponseBuffer->mSeparatedTotalEnergies(mResponseIndex,typeIndex);
+		}
+		return 0.0;
 	}
 	
 	double flat_shell::getProperty(std::string var) const
@@ -10,9 +10,9 @@ namespace bso { namespace structural_design { namespace element {
 		double mThickness;
 		double mPoisson;
 		
-		double mShearEnergy;
-		double mAxialEnergy;
-		double mBendEnergy;
+		double mShearEnergy = 0.0;
+		double mAxialEnergy = 0.0;
+		double mBendEnergy = 0.0;
 		
 		Eigen::MatrixXd mSMNormal;
 		Eigen::MatrixXd mSMShear;
@@ -22,13 +22,15 @@ namespace bso { namespace structural_design { namespace element {
 		Eigen::MatrixXd mETermSolid; // 3x3 matrix with normal- and shear terms
 		Eigen::MatrixXd mB1, mB2, mB3, mB4, mBAv; // 3x8 (strain-displacement) matrices for in-plane behaviour
 		
-		std::map<load_case, std::map<std::string, double>> mSeparatedEnergies;
+		Eigen::Matrix<double, 3, Eigen::Dynamic> mSeparatedEnergies; // the normal, shear and bending energy, column n in load case n
 		Eigen::VectorXd melementDisp8DOF;
 		Eigen::Vector3d mStress;
 		Eigen::VectorXd mE0K0U;
 		
 		template<class CONTAINER>
 		void deriveStiffnessMatrix(CONTAINER& l);
+		void storeResponse(const load_case& lc, const Eigen::VectorXd& elementDisplacements);
+		static long separatedEnergyIndex(const std::string& type); // -1 if it is not a separated energy
 	public:
 		template<class CONTAINER>
 		flat_shell(const unsigned long& ID, const double& E, const double& thickness, const double& poisson,
@@ -37,8 +39,9 @@ namespace bso { namespace structural_design { namespace element {
 							 std::initializer_list<node*>&& l, const double ERelativeLowerBound = 1e-6, const double geomTol = 1e-3);
 		~flat_shell();
 		
-		void computeResponse(load_case lc);
+		void computeStress(const Eigen::VectorXd& elementDisplacements);
 		void clearResponse();
+		std::vector<const Eigen::MatrixXd*> getSeparatedSMs() const {return {&mSMNormal, &mSMShear, &mSMBending};}
 		
 		const double& getEnergy(load_case lc, const std::string& type = "") const;
 		double getTotalEnergy(const std::string& type = "") const;
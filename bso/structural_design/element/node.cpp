@@ -7,6 +7,7 @@ namespace bso { namespace structural_design { namespace element {
 	{
 		mConstraints.setZero();
 		mNFS.setZero();
+		mNFT.fill(inactiveDOF);
 	} // initializeVariables
 
 	node::node(const std::initializer_list<double>&& l, const unsigned long& ID) :
@@ -28,6 +29,15 @@ namespace bso { namespace structural_design { namespace element {
 		
 	} //
 	
+	long node::findLoadCase(const std::vector<component::load_case>& loadCases, const component::load_case& lc)
+	{ // the index of the load case, -1 if it is not found. A node has loads in only a few load cases
+		for (unsigned long i = 0; i < loadCases.size(); ++i)
+		{
+			if (loadCases[i] == lc) return i;
+		}
+		return -1;
+	} // findLoadCase()
+	
 	void node::updateNFS(const Eigen::Vector6i& EFS)
 	{  // updates the nodal freedom signature with that of an element's node
 		for (unsigned int i = 0; i < 6; ++i)
@@ -54,46 +64,56 @@ namespace bso { namespace structural_design { namespace element {
 	
 	void node::addLoad(const load& l)
 	{ 
-		if (mLoads.find(l.loadCase()) == mLoads.end())
+		long index = findLoadCase(mLoadCases, l.loadCase());
+		if (index < 0)
 		{
 			this->addLoadCase(l.loadCase());
+			index = mLoadCases.size() - 1;
 		}
-		mLoads[l.loadCase()](l.DOF()) += l.magnitude();
+		mLoads(l.DOF(), index) += l.magnitude();
 
 	} //
 	
 	void node::addDisplacements(const std::map<component::load_case, Eigen::VectorXd>& displacements)
 	{
-		mDisplacements.clear();
+		mResponseBuffer = nullptr;
+		mDisplacementCases.clear();
+		mDisplacements.setZero(6, displacements.size());
+		unsigned long index = 0;
 		for (const auto& i : displacements)
 		{
-			Eigen::Vector6d tempDisplacements;
-			tempDisplacements.setZero();
+			mDisplacementCases.push_back(i.first);
 			for (unsigned int j = 0; j < 6; ++j)
 			{
-				if (mNFS(j) == 1 && mConstraints(j) == 0)
-				{
-					tempDisplacements(j) = i.second[mNFT[j]];
-				}
+				if (mNFT[j] != inactiveDOF) mDisplacements(j, index) = i.second[mNFT[j]];
 			}
-			mDisplacements[i.first] = tempDisplacements;
+			++index;
 		}
 	}
 	
 	void node::addLoadCase(load_case lc)
 	{
-		mLoads[lc] = Eigen::Vector6d::Zero();
+		if (findLoadCase(mLoadCases, lc) >= 0) return;
+		mLoadCases.push_back(lc);
+		mLoads.conservativeResize(Eigen::NoChange, mLoadCases.size());
+		mLoads.col(mLoadCases.size() - 1).setZero();
 	} // addLoadCase()
 	
 	void node::clearDisplacements()
 	{ // 
-		mDisplacements.clear();
+		mDisplacementCases.clear();
+		mDisplacements.resize(6, 0);
 	} // clearDisplacements()
 	
+	void node::setResponseBuffer(const response_buffer* buffer)
+	{
+		mResponseBuffer = buffer;
+	} // setResponseBuffer()
+	
 	Eigen::Vector6d node::getDisplacements(component::load_case lc) const
 	{
-		auto lcSearch = mDisplacements.find(lc);
-		if (lcSearch == mDisplacements.end())
+		long index = (mResponseBuffer == nullptr)? findLoadCase(mDisplacementCases, lc) : mResponseBuffer->loadCaseIndex(lc);
+		if (index < 0)
 		{
 			std::stringstream errorMessage;
 			errorMessage << "\nError, could not access displacements for load case:\n"
@@ -102,13 +122,19 @@ namespace bso { namespace structural_design { namespace element {
 									 << "(bso/structural_design/element/node.cpp)" << std::endl;
 			throw std::runtime_error(errorMessage.str());
 		}
-		return lcSearch->second; 
+		if (mResponseBuffer == nullptr) return mDisplacements.col(index);
+		Eigen::Vector6d displacements = Eigen::Vector6d::Zero();
+		for (unsigned int i = 0; i < 6; ++i)
+		{
+			if (mNFT[i] != inactiveDOF) displacements(i) = mResponseBuffer->mDisplacements(mNFT[i], index);
+		}
+		return displacements;
 	}
 	
 	Eigen::Vector6d node::getLoads(component::load_case lc) const
 	{
-		auto lcSearch = mLoads.find(lc);
-		if (lcSearch == mLoads.end())
+		long index = findLoadCase(mLoadCases, lc);
+		if (index < 0)
 		{
 			std::stringstream errorMessage;
 			errorMessage << "\nError, could not access loads for load case:\n"
@@ -117,7 +143,7 @@ namespace bso { namespace structural_design { namespace element {
 									 << "(bso/structural_design/element/node.cpp)" << std::endl;
 			throw std::runtime_error(errorMessage.str());
 		}
-		return lcSearch->second;
+		return mLoads.col(index);
 	}
 	
 	const int& node::getConstraint(const unsigned int& n) const
@@ -148,21 +174,12 @@ namespace bso { namespace structural_design { namespace element {
 		return mNFS[n];
 	}
 	
-	std::vector<component::load_case> node::getLoadCases() const
-	{
-		std::vector<component::load_case> temp;
-		for (auto& i : mLoads) temp.push_back(i.first);
-		return temp;
-	} // get LoadCases()
-	
 	void node::generateNFT(unsigned long& NFM)
 	{ // 
 		for (unsigned int i = 0; i < 6; ++i)
 		{
-			if (mNFS(i) == 1 && mConstraints(i) == 0)
-			{
-				mNFT[i] = NFM++;
-			}
+			if (mNFS(i) == 1 && mConstraints(i) == 0) mNFT[i] = NFM++;
+			else mNFT[i] = inactiveDOF;
 		}
 	} // generateNFT()
 	
@@ -185,23 +202,24 @@ namespace bso { namespace structural_design { namespace element {
 									 << "(bso/structural_design/element/node.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
-		if (mNFT.find(localDOF) == mNFT.end())
+		if (mNFT[localDOF] == inactiveDOF)
 		{
 			std::stringstream errorMessage;
 			errorMessage << "Error, could not find the global DOF from a node.\n"
 									 << "(bso/structural_design/element/node.cpp)" << std::endl;
 			throw std::invalid_argument(errorMessage.str());
 		}
-		return mNFT.find(localDOF)->second;
+		return mNFT[localDOF];
 	} //
 	
 	bool node::checkLoad(component::load_case lc, const unsigned int& localDOF, double& load) const
 	{ 
 		if (mNFS(localDOF) == 1 && mConstraints(localDOF) == 0)
 		{
-			if (mLoads.find(lc) != mLoads.end())
+			long index = findLoadCase(mLoadCases, lc);
+			if (index >= 0)
 			{
-				load = mLoads.find(lc)->second(localDOF);
+				load = mLoads(localDOF, index);
 				if (load != 0) return true;
 				else return false;
 			}
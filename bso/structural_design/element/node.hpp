@@ -2,28 +2,38 @@
 #define SD_NODE_HPP
 
 #include <bso/structural_design/component/load.hpp>
+#include <bso/structural_design/element/response_buffer.hpp>
 #include <bso/utilities/geometry.hpp>
 
 #include <Eigen/Dense>
 
+#include <array>
+#include <limits>
 #include <map>
 #include <stdexcept>
+#include <vector>
 
 namespace Eigen {typedef Matrix<int, 6, 1> Vector6i;}
 namespace Eigen {typedef Matrix<double, 6, 1> Vector6d;}
 
 namespace bso { namespace structural_design { namespace element {
 
+	const unsigned long inactiveDOF = std::numeric_limits<unsigned long>::max(); // in a freedom table, a DOF that is not active or is constrained
+
 	class node : public bso::utilities::geometry::vertex
 	{
 	private:
 		unsigned long mID;
-		std::map<unsigned int, unsigned long> mNFT; // nodal freedom table, contains the global indices of the node's DOFs
+		std::array<unsigned long, 6> mNFT; // nodal freedom table, for each local DOF index, contains its global index or inactiveDOF
 		Eigen::Vector6i mNFS; // nodal freedom signature, for each local DOF index, contains info if it is active or not
 		Eigen::Vector6i mConstraints; // constraints, for each local DOF index, contains if it is constrained or not
-		std::map<component::load_case, Eigen::Vector6d> mLoads; // indexe dby load case, contains for each local DOF index, the magnitude of the load
-		std::map<component::load_case, Eigen::Vector6d> mDisplacements; // indexed by load case, contains for each local DOF index, the magnitude of the displacement
+		std::vector<component::load_case> mLoadCases; // of the loads on this node, in the order they were added
+		Eigen::Matrix<double, 6, Eigen::Dynamic> mLoads; // column n contains for each local DOF index, the magnitude of the load in load case n
+		std::vector<component::load_case> mDisplacementCases; // in the order of the columns of mDisplacements
+		Eigen::Matrix<double, 6, Eigen::Dynamic> mDisplacements; // column n contains for each local DOF index, the magnitude of the displacement in load case n
+		const response_buffer* mResponseBuffer = nullptr; // if set, the displacements are read from the global displacements in it
 		
+		static long findLoadCase(const std::vector<component::load_case>& loadCases, const component::load_case& lc);
 		void initializeVariables();
 	public:
 		node(const std::initializer_list<double>&& l, const unsigned long& ID); // initialize by initializer list
@@ -36,16 +46,19 @@ namespace bso { namespace structural_design { namespace element {
 		void addDisplacements(const std::map<component::load_case, Eigen::VectorXd>& displacements);
 		void addLoadCase(load_case lc);
 		void clearDisplacements();
+		void setResponseBuffer(const response_buffer* buffer); // nullptr reads the displacements added to this node again
 
 		Eigen::Vector6d getDisplacements(component::load_case lc) const;
 		Eigen::Vector6d getLoads(component::load_case lc) const;
 		const int& getConstraint(const unsigned int& n) const;
 		const int& getNFS(const unsigned int& n) const;
 		const unsigned long& ID() const {return mID;}
-		std::vector<component::load_case> getLoadCases() const;
+		const std::vector<component::load_case>& getLoadCases() const {return mLoadCases;}
+		const Eigen::Matrix<double, 6, Eigen::Dynamic>& getLoadTable() const {return mLoads;} // column n belongs to load case n of getLoadCases()
 		
 		void generateNFT(unsigned long& NFM); // this will map the local DOFs to the global DOFs of this node
 		unsigned long getGlobalDOF(const unsigned int& localDOF) const;
+		const std::array<unsigned long, 6>& getNFT() const {return mNFT;}
 		
 		bool checkLoad(component::load_case lc, const unsigned int& localDOF, double& load) const;
 	};
@@ -209,18 +209,16 @@ namespace bso { namespace structural_design { namespace element {
 		
 	} // dtor
 
-	void quad_hexahedron::computeResponse(load_case lc)
-	{ //
-		element::computeResponse(lc);
-		// calculate stress of solid element at centroid
+	void quad_hexahedron::computeStress(const Eigen::VectorXd& elementDisplacements)
+	{ // calculate stress of solid element at centroid
 		mBAv = (1.0/8) * mBSum; // average B-matrix
 		mDispLoc.setZero(24);
-		mDispLoc = mT * mDisplacements[lc];
+		mDispLoc = mT * elementDisplacements;
 		Eigen::VectorXd StrainAv;
 		StrainAv.setZero(6);
 		StrainAv = mBAv * mDispLoc; // average strain
 		mStress = mETermSolid * StrainAv; // average stress per element (averaged over 2x2x2 integration points)
-	} // computeResponse()
+	} // computeStress()
 
 	double quad_hexahedron::getProperty(std::string var) const
 	{ //
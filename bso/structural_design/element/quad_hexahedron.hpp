@@ -27,7 +27,7 @@ namespace bso { namespace structural_design { namespace element {
 										const double geomTol = 1e-3);
 		~quad_hexahedron();
 
-		void computeResponse(load_case lc);
+		void computeStress(const Eigen::VectorXd& elementDisplacements);
 
 		double getProperty(std::string var) const;
 		double getVolume() const;
@@ -0,0 +1,29 @@
+#ifndef SD_RESPONSE_BUFFER_CPP
+#define SD_RESPONSE_BUFFER_CPP
+
+namespace bso { namespace structural_design { namespace element {
+
+	long response_buffer::loadCaseIndex(const load_case& lc) const
+	{ // a system has only a few load cases
+		for (unsigned long i = 0; i < mLoadCases.size(); ++i)
+		{
+			if (mLoadCases[i] == lc) return i;
+		}
+		return -1;
+	} // loadCaseIndex()
+
+	void response_buffer::clear()
+	{
+		mLoadCases.clear();
+		mDisplacements.resize(0,0);
+		mEnergies.resize(0,0);
+		for (auto& i : mSeparatedEnergies) i.resize(0,0);
+		mTotalEnergies.resize(0);
+		mSeparatedTotalEnergies.resize(0,3);
+	} // clear()
+
+} // namespace element
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_RESPONSE_BUFFER_CPP
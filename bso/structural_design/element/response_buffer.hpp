@@ -0,0 +1,34 @@
+#ifndef SD_RESPONSE_BUFFER_HPP
+#define SD_RESPONSE_BUFFER_HPP
+
+#include <bso/structural_design/component/load.hpp>
+
+#include <Eigen/Dense>
+
+#include <array>
+#include <vector>
+
+namespace bso { namespace structural_design { namespace element {
+
+	struct response_buffer
+	{ // the responses of an FEA system, owned by the FEA and read by its nodes and elements.
+		// Each column belongs to the load case with the same index in mLoadCases, each row of
+		// the energy matrices to the element with the same index in the FEA
+		std::vector<load_case> mLoadCases;
+		Eigen::MatrixXd mDisplacements; // global DOFs x load cases
+		Eigen::MatrixXd mEnergies; // elements x load cases
+		std::array<Eigen::MatrixXd, 3> mSeparatedEnergies; // the normal, shear and bending energies, elements x load cases
+		Eigen::VectorXd mTotalEnergies; // of each element, summed over the load cases
+		Eigen::Matrix<double, Eigen::Dynamic, 3> mSeparatedTotalEnergies; // of each element, summed over the load cases
+
+		long loadCaseIndex(const load_case& lc) const; // -1 if the load case is not in the buffer
+		void clear();
+	};
+
+} // namespace element
+} // namespace structural_design
+} // namespace bso
+
+#include <bso/structural_design/element/response_buffer.cpp>
+
+#endif // SD_RESPONSE_BUFFER_HPP
@@ -0,0 +1,189 @@
+#ifndef SD_ELEMENT_BY_ELEMENT_OPERATOR_CPP
+#define SD_ELEMENT_BY_ELEMENT_OPERATOR_CPP
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace bso { namespace structural_design {
+
+	element_by_element_operator::element_by_element_operator()
+	{
+
+	} // ctor()
+
+	void element_by_element_operator::initialize(const std::vector<element::element*>& elements,
+		const std::vector<element::node*>& nodes, const unsigned long& DOFCount,
+		const unsigned int& threads /*= 0*/)
+	{
+		mSize = DOFCount;
+		mElements.assign(elements.begin(), elements.end());
+		mReferenceStiffnesses.clear();
+		mReferenceIndices.clear();
+		mDOFs.clear();
+		mDOFOffsets.clear();
+		mColours.clear();
+
+		std::map<const element::node*, unsigned long> nodeIndices;
+		mBlocks.assign(mSize, -1);
+		for (unsigned long i = 0; i < nodes.size(); ++i)
+		{
+			nodeIndices[nodes[i]] = i;
+			for (unsigned int j = 0; j < 6; ++j)
+			{
+				if (nodes[i]->getNFS(j) == 1 && nodes[i]->getConstraint(j) == 0)
+				{
+					mBlocks[nodes[i]->getGlobalDOF(j)] = i;
+				}
+			}
+		}
+
+		std::vector<std::vector<unsigned long> > nodeColours(nodes.size());
+		for (unsigned long i = 0; i < mElements.size(); ++i)
+		{
+			const Eigen::MatrixXd& stiffness = mElements[i]->getOriginalSM();
+
+			// congruent elements share their stiffness matrix, the most recent ones are the most likely match
+			const double tolerance = 1e-12 * stiffness.cwiseAbs().maxCoeff();
+			long reference = -1;
+			for (long j = mReferenceStiffnesses.size() - 1;
+					 j >= 0 && j + 16 >= (long)mReferenceStiffnesses.size(); --j)
+			{
+				const Eigen::MatrixXd& candidate = mReferenceStiffnesses[j];
+				if (candidate.rows() == stiffness.rows() &&
+						(candidate - stiffness).cwiseAbs().maxCoeff() <= tolerance)
+				{
+					reference = j;
+					break;
+				}
+			}
+			if (reference < 0)
+			{
+				reference = mReferenceStiffnesses.size();
+				mReferenceStiffnesses.push_back(stiffness);
+			}
+			mReferenceIndices.push_back(reference);
+
+			mDOFOffsets.push_back(mDOFs.size());
+			const auto& EFT = mElements[i]->getEFT();
+			for (unsigned int j = 0; j < stiffness.rows(); ++j)
+			{
+				mDOFs.push_back((j >= EFT.size() || EFT[j] == element::inactiveDOF)? -1 : (long)EFT[j]);
+			}
+
+			// greedy colouring, the lowest colour that none of the element's nodes has yet
+			std::vector<bool> used(mColours.size() + 1, false);
+			for (const auto& j : mElements[i]->getNodes())
+			{
+				for (const auto& k : nodeColours[nodeIndices.at(j)]) used[k] = true;
+			}
+			unsigned long colour = std::find(used.begin(), used.end(), false) - used.begin();
+			if (colour == mColours.size()) mColours.push_back({});
+			mColours[colour].push_back(i);
+			for (const auto& j : mElements[i]->getNodes())
+			{
+				nodeColours[nodeIndices.at(j)].push_back(colour);
+			}
+		}
+
+		unsigned int threadCount = (threads == 0)? std::thread::hardware_concurrency() : threads;
+		if (threadCount > 1) mThreadPool = std::make_shared<bso::utilities::thread_pool>(threadCount);
+		else mThreadPool.reset();
+		this->update();
+	} // initialize()
+
+	void element_by_element_operator::update()
+	{
+		mFactors.resize(mElements.size());
+		std::vector<Eigen::Triplet<double> > triplets;
+		for (unsigned long i = 0; i < mElements.size(); ++i)
+		{
+			mFactors[i] = mElements[i]->getStiffnessFactor();
+			const Eigen::MatrixXd& stiffness = mReferenceStiffnesses[mReferenceIndices[i]];
+			const long* DOFs = mDOFs.data() + mDOFOffsets[i];
+			for (unsigned int j = 0; j < stiffness.rows(); ++j)
+			{
+				if (DOFs[j] < 0) continue;
+				for (unsigned int k = 0; k < stiffness.cols(); ++k)
+				{
+					if (DOFs[k] < 0 || mBlocks[DOFs[j]] != mBlocks[DOFs[k]] || stiffness(j,k) == 0) continue;
+					triplets.push_back(Eigen::Triplet<double>(DOFs[j], DOFs[k], mFactors[i] * stiffness(j,k)));
+				}
+			}
+		}
+		mBlockDiagonal.resize(mSize, mSize);
+		mBlockDiagonal.setFromTriplets(triplets.begin(), triplets.end());
+	} // update()
+
+	void element_by_element_operator::addProducts(const std::vector<unsigned long>& elements,
+		const unsigned long& begin, const unsigned long& end, const Eigen::VectorXd& u,
+		Eigen::VectorXd& Ku) const
+	{
+		Eigen::VectorXd elementDisplacements, elementForces;
+		for (unsigned long i = begin; i < end; ++i)
+		{
+			const unsigned long& e = elements[i];
+			const Eigen::MatrixXd& stiffness = mReferenceStiffnesses[mReferenceIndices[e]];
+			const long* DOFs = mDOFs.data() + mDOFOffsets[e];
+			elementDisplacements.resize(stiffness.rows());
+			for (unsigned int j = 0; j < stiffness.rows(); ++j)
+			{
+				elementDisplacements(j) = (DOFs[j] < 0)? 0.0 : u(DOFs[j]);
+			}
+			elementForces.noalias() = stiffness * elementDisplacements;
+			for (unsigned int j = 0; j < stiffness.rows(); ++j)
+			{
+				if (DOFs[j] >= 0) Ku(DOFs[j]) += mFactors[e] * elementForces(j);
+			}
+		}
+	} // addProducts()
+
+	void element_by_element_operator::multiply(const Eigen::VectorXd& u, Eigen::VectorXd& Ku) const
+	{
+		if (u.rows() != mSize)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, cannot multiply an element by element operator of size " << mSize << "\n"
+									 << "with a vector of size " << u.rows() << ".\n"
+									 << "(bso/structural_design/element_by_element_operator.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		Ku = Eigen::VectorXd::Zero(mSize);
+		for (const auto& i : mColours)
+		{ // the elements of one colour write to different DOFs
+			if (!mThreadPool)
+			{
+				this->addProducts(i, 0, i.size(), u, Ku);
+				continue;
+			}
+			const unsigned long tasks = mThreadPool->size();
+			std::vector<std::future<void> > results;
+			for (unsigned long j = 0; j < tasks; ++j)
+			{
+				unsigned long begin = (i.size() * j) / tasks, end = (i.size() * (j + 1)) / tasks;
+				if (begin == end) continue;
+				results.push_back(mThreadPool->submit([this, &i, begin, end, &u, &Ku]()
+				{
+					this->addProducts(i, begin, end, u, Ku);
+				}));
+			}
+			for (auto& j : results)
+			{
+				mThreadPool->wait(j);
+				j.get();
+			}
+		}
+	} // multiply()
+
+	double element_by_element_operator::coeff(const Eigen::Index& row, const Eigen::Index& col) const
+	{
+		return mBlockDiagonal.coeff(row, col);
+	} // coeff()
+
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_ELEMENT_BY_ELEMENT_OPERATOR_CPP
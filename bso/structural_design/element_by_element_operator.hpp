@@ -0,0 +1,104 @@
+#ifndef SD_ELEMENT_BY_ELEMENT_OPERATOR_HPP
+#define SD_ELEMENT_BY_ELEMENT_OPERATOR_HPP
+
+#include <bso/structural_design/element/elements.hpp>
+#include <bso/utilities/thread_pool.hpp>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <memory>
+#include <vector>
+
+namespace bso { namespace structural_design {
+	class element_by_element_operator;
+} // namespace structural_design
+} // namespace bso
+
+namespace Eigen { namespace internal {
+	template <>
+	struct traits<bso::structural_design::element_by_element_operator>
+	:	public Eigen::internal::traits<Eigen::SparseMatrix<double> >
+	{ // lets Eigen's iterative solvers use the operator as a (matrix-free) sparse matrix
+	};
+} // namespace internal
+} // namespace Eigen
+
+namespace bso { namespace structural_design {
+
+	class element_by_element_operator : public Eigen::EigenBase<element_by_element_operator>
+	{ // the global stiffness matrix as a matrix-free operator: K*u is summed element by element.
+		// Congruent elements (e.g. those of a structured grid) share one original stiffness matrix,
+		// which is scaled by the stiffness factor E/E0 of each element. The elements are coloured
+		// such that elements of one colour share no nodes, and each colour is processed in parallel
+	private:
+		std::vector<const element::element*> mElements;
+		std::vector<Eigen::MatrixXd> mReferenceStiffnesses; // the unique original stiffness matrices
+		std::vector<unsigned long> mReferenceIndices; // of each element
+		std::vector<double> mFactors; // of each element
+		std::vector<long> mDOFs; // the global index of each local DOF of each element, -1 if it is not free
+		std::vector<unsigned long> mDOFOffsets; // of each element in mDOFs
+		std::vector<std::vector<unsigned long> > mColours; // the element indices of each colour
+		std::vector<long> mBlocks; // the node of each global DOF
+		Eigen::SparseMatrix<double> mBlockDiagonal; // the assembled nodal blocks on the diagonal
+		Eigen::Index mSize = 0;
+		std::shared_ptr<bso::utilities::thread_pool> mThreadPool; // none when running on one thread
+
+		void addProducts(const std::vector<unsigned long>& elements, const unsigned long& begin,
+			const unsigned long& end, const Eigen::VectorXd& u, Eigen::VectorXd& Ku) const;
+	public:
+		typedef double Scalar;
+		typedef double RealScalar;
+		typedef int StorageIndex;
+		enum {ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic, IsRowMajor = false};
+
+		element_by_element_operator();
+
+		void initialize(const std::vector<element::element*>& elements,
+			const std::vector<element::node*>& nodes, const unsigned long& DOFCount,
+			const unsigned int& threads = 0); // after the freedom tables have been generated, 0 threads is one per hardware thread
+		void update(); // reads the stiffness factors after the element densities have changed
+		void multiply(const Eigen::VectorXd& u, Eigen::VectorXd& Ku) const; // Ku = K*u
+
+		double coeff(const Eigen::Index& row, const Eigen::Index& col) const; // only within the nodal blocks on the diagonal, e.g. for a block Jacobi preconditioner
+		Eigen::Index rows() const {return mSize;}
+		Eigen::Index cols() const {return mSize;}
+		bool isInitialized() const {return !mDOFOffsets.empty();}
+		unsigned long colours() const {return mColours.size();}
+		unsigned long referenceStiffnesses() const {return mReferenceStiffnesses.size();}
+
+		template <class RHS>
+		Eigen::Product<element_by_element_operator, RHS, Eigen::AliasFreeProduct> operator*(
+			const Eigen::MatrixBase<RHS>& x) const
+		{
+			return Eigen::Product<element_by_element_operator, RHS, Eigen::AliasFreeProduct>(*this, x.derived());
+		}
+	};
+
+} // namespace structural_design
+} // namespace bso
+
+namespace Eigen { namespace internal {
+	template <class RHS>
+	struct generic_product_impl<bso::structural_design::element_by_element_operator, RHS,
+		SparseShape, DenseShape, GemvProduct>
+	:	generic_product_impl_base<bso::structural_design::element_by_element_operator, RHS,
+			generic_product_impl<bso::structural_design::element_by_element_operator, RHS> >
+	{
+		typedef typename Product<bso::structural_design::element_by_element_operator, RHS>::Scalar Scalar;
+
+		template <class DEST>
+		static void scaleAndAddTo(DEST& dst, const bso::structural_design::element_by_element_operator& lhs,
+			const RHS& rhs, const Scalar& alpha)
+		{
+			Eigen::VectorXd Ku;
+			lhs.multiply(rhs, Ku);
+			dst += alpha * Ku;
+		}
+	};
+} // namespace internal
+} // namespace Eigen
+
+#include <bso/structural_design/element_by_element_operator.cpp>
+
+#endif // SD_ELEMENT_BY_ELEMENT_OPERATOR_HPP
@@ -0,0 +1,157 @@
+#ifndef SD_ELEMENT_INDEX_CPP
+#define SD_ELEMENT_INDEX_CPP
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace bso { namespace structural_design {
+
+	void element_index::bounding_box::extend(const bounding_box& rhs)
+	{
+		mMin = mMin.cwiseMin(rhs.mMin);
+		mMax = mMax.cwiseMax(rhs.mMax);
+	} // extend()
+
+	bool element_index::bounding_box::overlaps(const bounding_box& rhs) const
+	{
+		return (mMin.array() <= rhs.mMax.array()).all() && (rhs.mMin.array() <= mMax.array()).all();
+	} // overlaps()
+
+	bool element_index::bounding_box::contains(const bounding_box& rhs) const
+	{
+		return (mMin.array() <= rhs.mMin.array()).all() && (rhs.mMax.array() <= mMax.array()).all();
+	} // contains()
+
+	element_index::element_index()
+	{
+
+	} // ctor()
+
+	long element_index::buildNode(const unsigned long& begin, const unsigned long& end)
+	{ // splits the elements at the median of their centers along the longest side of the box of the centers
+		tree_node node;
+		node.mBegin = begin;
+		node.mEnd = end;
+		node.mBox = mElementBoxes[mOrder[begin]];
+		bounding_box centers = {mElementBoxes[mOrder[begin]].mMin + mElementBoxes[mOrder[begin]].mMax,
+														mElementBoxes[mOrder[begin]].mMin + mElementBoxes[mOrder[begin]].mMax};
+		for (unsigned long i = begin + 1; i < end; ++i)
+		{
+			const bounding_box& elementBox = mElementBoxes[mOrder[i]];
+			node.mBox.extend(elementBox);
+			Eigen::Vector3d center = elementBox.mMin + elementBox.mMax; // twice the center
+			centers.extend({center, center});
+		}
+		long index = mTree.size();
+		mTree.push_back(node);
+		if (end - begin <= mLeafSize) return index;
+
+		unsigned int axis;
+		(centers.mMax - centers.mMin).maxCoeff(&axis);
+		unsigned long middle = begin + (end - begin) / 2;
+		std::nth_element(mOrder.begin() + begin, mOrder.begin() + middle, mOrder.begin() + end,
+			[this, &axis](const unsigned long& lhs, const unsigned long& rhs)
+		{
+			return mElementBoxes[lhs].mMin(axis) + mElementBoxes[lhs].mMax(axis) <
+						 mElementBoxes[rhs].mMin(axis) + mElementBoxes[rhs].mMax(axis);
+		});
+		long left = this->buildNode(begin, middle);
+		long right = this->buildNode(middle, end);
+		mTree[index].mLeft = left;
+		mTree[index].mRight = right;
+		return index;
+	} // buildNode()
+
+	void element_index::build(const std::vector<element::element*>& elements)
+	{
+		this->clear();
+		std::unordered_map<const element::node*, unsigned long> nodeIndices;
+		mElementNodes.resize(elements.size());
+		mElementBoxes.resize(elements.size());
+		for (unsigned long i = 0; i < elements.size(); ++i)
+		{
+			bounding_box& elementBox = mElementBoxes[i];
+			elementBox.mMin.setConstant(std::numeric_limits<double>::max());
+			elementBox.mMax.setConstant(std::numeric_limits<double>::lowest());
+			for (const auto& j : elements[i]->getNodes())
+			{
+				auto nodeSearch = nodeIndices.find(j);
+				if (nodeSearch == nodeIndices.end())
+				{
+					nodeSearch = nodeIndices.emplace(j, mNodes.size()).first;
+					mNodes.push_back(j);
+				}
+				mElementNodes[i].push_back(nodeSearch->second);
+				elementBox.extend({*j, *j});
+			}
+		}
+		mOrder.resize(elements.size());
+		std::iota(mOrder.begin(), mOrder.end(), 0);
+		if (!mOrder.empty()) this->buildNode(0, mOrder.size());
+	} // build()
+
+	void element_index::clear()
+	{
+		mNodes.clear();
+		mElementNodes.clear();
+		mElementBoxes.clear();
+		mOrder.clear();
+		mTree.clear();
+	} // clear()
+
+	template <class GEOMETRY>
+	std::vector<unsigned long> element_index::findContained(const GEOMETRY& geom, const double& tol /*= 1e-3*/) const
+	{
+		std::vector<unsigned long> contained;
+		if (mTree.empty()) return contained;
+
+		// the tolerances of the containment tests are partly relative to the size of the geometry
+		bounding_box query = {*geom.begin(), *geom.begin()};
+		for (const auto& i : geom) query.extend({i, i});
+		Eigen::Vector3d margin = Eigen::Vector3d::Constant(2 * tol * (1 + (query.mMax - query.mMin).norm()));
+		query.mMin -= margin;
+		query.mMax += margin;
+
+		std::unordered_map<unsigned long, bool> nodeIsInside;
+		std::vector<long> stack = {0};
+		while (!stack.empty())
+		{
+			const tree_node& node = mTree[stack.back()];
+			stack.pop_back();
+			if (!query.overlaps(node.mBox)) continue;
+			if (node.mLeft >= 0)
+			{
+				stack.push_back(node.mRight);
+				stack.push_back(node.mLeft);
+				continue;
+			}
+			for (unsigned long i = node.mBegin; i < node.mEnd; ++i)
+			{
+				const unsigned long& elementIndex = mOrder[i];
+				if (!query.contains(mElementBoxes[elementIndex])) continue;
+				bool allNodesInsideOrOn = true;
+				for (const auto& j : mElementNodes[elementIndex])
+				{
+					auto nodeSearch = nodeIsInside.find(j);
+					if (nodeSearch == nodeIsInside.end())
+					{
+						nodeSearch = nodeIsInside.emplace(j, geom.isInsideOrOn(*mNodes[j], tol)).first;
+					}
+					if (!nodeSearch->second)
+					{
+						allNodesInsideOrOn = false;
+						break;
+					}
+				}
+				if (allNodesInsideOrOn) contained.push_back(elementIndex);
+			}
+		}
+		std::sort(contained.begin(), contained.end());
+		return contained;
+	} // findContained()
+
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_ELEMENT_INDEX_CPP
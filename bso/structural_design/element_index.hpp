@@ -0,0 +1,56 @@
+#ifndef SD_ELEMENT_INDEX_HPP
+#define SD_ELEMENT_INDEX_HPP
+
+#include <bso/structural_design/element/elements.hpp>
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace bso { namespace structural_design {
+
+	class element_index
+	{ // a bounding volume hierarchy over the axis aligned bounding boxes of the elements of an FEA
+		// system. A query only tests the nodes of the elements whose boxes lie in the box of the
+		// geometry, and tests each of those nodes once
+	private:
+		struct bounding_box
+		{
+			Eigen::Vector3d mMin, mMax;
+			void extend(const bounding_box& rhs);
+			bool overlaps(const bounding_box& rhs) const;
+			bool contains(const bounding_box& rhs) const;
+		};
+		struct tree_node
+		{
+			bounding_box mBox;
+			unsigned long mBegin, mEnd; // the range of mOrder in this node
+			long mLeft = -1, mRight = -1; // children, -1 for a leaf
+		};
+		std::vector<const element::node*> mNodes;
+		std::vector<std::vector<unsigned long> > mElementNodes; // the indices in mNodes of the nodes of each element
+		std::vector<bounding_box> mElementBoxes;
+		std::vector<unsigned long> mOrder; // the element indices, ordered by the tree
+		std::vector<tree_node> mTree; // the root is the first node
+		static const unsigned long mLeafSize = 8;
+
+		long buildNode(const unsigned long& begin, const unsigned long& end);
+	public:
+		element_index();
+
+		void build(const std::vector<element::element*>& elements);
+		void clear();
+
+		template <class GEOMETRY>
+		std::vector<unsigned long> findContained(const GEOMETRY& geom, const double& tol = 1e-3) const; // the elements of which all nodes are inside or on geom, in ascending order
+
+		bool isEmpty() const {return mElementBoxes.empty();}
+		unsigned long size() const {return mElementBoxes.size();}
+	};
+
+} // namespace structural_design
+} // namespace bso
+
+#include <bso/structural_design/element_index.cpp>
+
+#endif // SD_ELEMENT_INDEX_HPP
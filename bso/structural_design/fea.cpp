@@ -1,6 +1,8 @@
 #ifndef SD_FEA_CPP
 #define SD_FEA_CPP
 
+#include <algorithm>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 
@@ -8,7 +10,10 @@ namespace bso { namespace structural_design {
 	
 	void fea::simplicialLLT()
 	{
-		mLLTSolver.compute(mGSM);
+		{
+			BSO_SCOPED_TIMER("factorisation");
+			mLLTSolver.compute(mGSM);
+		}
 		if (mLLTSolver.info() != Eigen::Success)
 		{
 			std::stringstream errorMessage;
@@ -18,6 +23,7 @@ namespace bso { namespace structural_design {
 			throw std::runtime_error(errorMessage.str());
 		}
 		
+		BSO_SCOPED_TIMER("solve");
 		for (auto& lc : mLoadCases)
 		{
 			try
@@ -41,7 +47,10 @@ namespace bso { namespace structural_design {
 	
 	void fea::simplicialLDLT()
 	{
-		mLDLTSolver.compute(mGSM);
+		{
+			BSO_SCOPED_TIMER("factorisation");
+			mLDLTSolver.compute(mGSM);
+		}
 		if (mLDLTSolver.info() != Eigen::Success)
 		{
 			std::stringstream errorMessage;
@@ -51,6 +60,7 @@ namespace bso { namespace structural_design {
 			throw std::runtime_error(errorMessage.str());
 		}
 		
+		BSO_SCOPED_TIMER("solve");
 		for (auto& lc : mLoadCases)
 		{
 			try
@@ -72,8 +82,121 @@ namespace bso { namespace structural_design {
 		}
 	} // simplicialLDLT()
 	
-	void fea::BiCGSTAB()
+	void fea::supernodal()
 	{
+		{
+			BSO_SCOPED_TIMER("factorisation");
+			mSupernodalSolver.compute(mGSM);
+		}
+		if (mSupernodalSolver.info() != Eigen::Success)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nWhen solving an FEA system with Supernodal,\n"
+									 << "Could not decompose the GSM\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::runtime_error(errorMessage.str());
+		}
+		BSO_COUNT("supernodes", mSupernodalSolver.supernodes());
+		
+		BSO_SCOPED_TIMER("solve");
+		for (auto& lc : mLoadCases)
+		{
+			try
+			{
+				mDisplacements[lc] = mSupernodalSolver.solve(mLoads[lc]);
+			}
+			catch (std::exception& e)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nWhen solving FEA system with Supernodal for load case: " << lc << "\n"
+										 << "received the following error:\n" << e.what() << "\n"
+										 << "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::runtime_error(errorMessage.str());
+			}
+		}
+	} // supernodal()
+	
+	void fea::reanalysis()
+	{ // solves the system with a low rank update of the reference system if possible, otherwise factors it
+		if (mReanalysis == nullptr) mReanalysis = std::make_shared<low_rank_reanalysis>();
+		std::vector<dof_key> keys = this->DOFKeys();
+		{
+			BSO_SCOPED_TIMER("factorisation");
+			mReanalysisUpdate = mReanalysis->compute(mGSM, keys);
+		}
+		if (!mReanalysisUpdate.isValid())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nWhen solving an FEA system with Reanalysis,\n"
+									 << "Could not decompose the GSM\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::runtime_error(errorMessage.str());
+		}
+		BSO_COUNT("reanalysis_rank", mReanalysisUpdate.rank());
+		
+		BSO_SCOPED_TIMER("solve");
+		Eigen::MatrixXd loads(mDOFCount, mLoadCases.size()), displacements;
+		for (unsigned long i = 0; i < mLoadCases.size(); ++i) loads.col(i) = mLoads[mLoadCases[i]];
+		displacements = mReanalysisUpdate.solve(loads);
+		if (mReanalysisUpdate.rank() > 0 && (mGSM * displacements - loads).norm() > 1e-6 * loads.norm())
+		{ // the update loses its accuracy when the system is close to singular
+			mReanalysisUpdate = mReanalysis->factorize(mGSM, keys);
+			if (!mReanalysisUpdate.isValid())
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nWhen solving an FEA system with Reanalysis,\n"
+										 << "Could not decompose the GSM\n"
+										 << "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::runtime_error(errorMessage.str());
+			}
+			displacements = mReanalysisUpdate.solve(loads);
+		}
+		for (unsigned long i = 0; i < mLoadCases.size(); ++i) mDisplacements[mLoadCases[i]] = displacements.col(i);
+	} // reanalysis()
+	
+	void fea::solveCondensed(const std::string& solver)
+	{ // the solver solves the reduced system in place of the GSM, the interiors are recovered afterwards
+		if (solver != "SimplicialLLT" && solver != "SimplicialLDLT" && solver != "Supernodal")
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nTrying to solve a statically condensed FEA system with solver: " << solver << "\n"
+									 << "condensed systems can only be solved with SimplicialLLT, SimplicialLDLT or Supernodal\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		Eigen::SparseMatrix<double> reducedGSM;
+		std::map<element::load_case,Eigen::VectorXd> reducedLoads;
+		{
+			BSO_SCOPED_TIMER("static_condensation");
+			mStaticCondensation.condense(mElements, mDOFCount, mLoads, reducedGSM, reducedLoads);
+		}
+		BSO_COUNT("condensed_dofs", mStaticCondensation.reducedDOFCount());
+		
+		std::swap(mGSM, reducedGSM);
+		std::swap(mLoads, reducedLoads);
+		try
+		{
+			if (solver == "SimplicialLLT") this->simplicialLLT();
+			else if (solver == "SimplicialLDLT") this->simplicialLDLT();
+			else this->supernodal();
+		}
+		catch (...)
+		{
+			std::swap(mGSM, reducedGSM);
+			std::swap(mLoads, reducedLoads);
+			throw;
+		}
+		std::swap(mGSM, reducedGSM);
+		std::swap(mLoads, reducedLoads);
+		
+		std::map<element::load_case,Eigen::VectorXd> reducedDisplacements;
+		std::swap(mDisplacements, reducedDisplacements);
+		mStaticCondensation.recover(reducedDisplacements, mDisplacements);
+	} // solveCondensed()
+	
+	void fea::BiCGSTAB()
+	{ // preconditioning and iterations are timed together as the solve
+		BSO_SCOPED_TIMER("solve");
 		Eigen::BiCGSTAB<Eigen::SparseMatrix<double>, Eigen::DiagonalPreconditioner<double>> solver;
 		
 		for (auto& lc : mLoadCases)
@@ -89,6 +212,7 @@ namespace bso { namespace structural_design {
 				}
 				
 				mDisplacements[lc] = solver.solve(mLoads[lc]);
+				mSolverStatistics[lc] = {(unsigned long)solver.iterations(), solver.error()};
 				if (solver.info() != Eigen::Success)
 				{
 					throw std::runtime_error("Solver failed to solve GSM for loads");
@@ -106,7 +230,8 @@ namespace bso { namespace structural_design {
 	} // BiCGSTAB()
 	
 	void fea::scaledBiCGSTAB()
-	{
+	{ // preconditioning and iterations are timed together as the solve
+		BSO_SCOPED_TIMER("solve");
 		Eigen::BiCGSTAB<Eigen::SparseMatrix<double>, Eigen::DiagonalPreconditioner<double>> solver;
 		
 		for (auto& lc : mLoadCases)
@@ -144,6 +269,7 @@ namespace bso { namespace structural_design {
 				Eigen::VectorXd y(mDOFCount);
 				y = solver.solve(mLoads[lc]);
 				mDisplacements[lc] = wInverse.asDiagonal() * y;
+				mSolverStatistics[lc] = {(unsigned long)solver.iterations(), solver.error()};
 				if (solver.info() != Eigen::Success)
 				{
 					throw std::runtime_error("Solver failed to solver for y");
@@ -160,6 +286,211 @@ namespace bso { namespace structural_design {
 		}
 	} // scaledBiCGSTAB()
 	
+	template <class SOLVER, class MATRIX>
+	void fea::conjugateGradient(SOLVER& solver, const MATRIX& GSM,
+		const std::map<element::load_case,Eigen::VectorXd>& initialGuesses)
+	{
+		{
+			BSO_SCOPED_TIMER("factorisation");
+			solver.compute(GSM);
+		}
+		if (solver.info() != Eigen::Success)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nWhen solving an FEA system with PCG,\n"
+									 << "could not compute the " << mPCGSettings.mPreconditioner << " preconditioner of the GSM\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::runtime_error(errorMessage.str());
+		}
+		solver.setTolerance(mPCGSettings.mTolerance);
+		if (mPCGSettings.mMaxIterations > 0) solver.setMaxIterations(mPCGSettings.mMaxIterations);
+		
+		BSO_SCOPED_TIMER("solve");
+		for (auto& lc : mLoadCases)
+		{
+			try
+			{
+				auto guess = initialGuesses.find(lc);
+				if (guess != initialGuesses.end() && guess->second.size() == (long)mDOFCount)
+				{
+					mDisplacements[lc] = solver.solveWithGuess(mLoads[lc], guess->second);
+				}
+				else mDisplacements[lc] = solver.solve(mLoads[lc]);
+				mSolverStatistics[lc] = {(unsigned long)solver.iterations(), solver.error()};
+				BSO_COUNT("pcg_iterations", solver.iterations());
+				if (solver.info() != Eigen::Success)
+				{
+					std::stringstream error;
+					error << "Solver did not converge, relative residual after "
+								<< solver.iterations() << " iterations: " << solver.error();
+					throw std::runtime_error(error.str());
+				}
+			}
+			catch (std::exception& e)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nWhen solving FEA system with PCG for load case: " << lc << "\n"
+										 << "received the following error:\n" << e.what() << "\n"
+										 << "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::runtime_error(errorMessage.str());
+			}
+		}
+	} // conjugateGradient()
+	
+	std::vector<unsigned long> fea::nodalBlockSizes() const
+	{ // the free DOFs of a node are numbered consecutively
+		std::vector<unsigned long> blockSizes;
+		for (const auto& i : mNodes)
+		{
+			unsigned long nodalDOFs = 0;
+			for (unsigned int j = 0; j < 6; ++j)
+			{
+				if (i->getNFS(j) == 1 && i->getConstraint(j) == 0) ++nodalDOFs;
+			}
+			if (nodalDOFs > 0) blockSizes.push_back(nodalDOFs);
+		}
+		return blockSizes;
+	} // nodalBlockSizes()
+	
+	std::vector<dof_key> fea::DOFKeys() const
+	{ // the position and local index of each global DOF, they identify it in the systems of other models
+		std::vector<dof_key> keys(mDOFCount);
+		for (const auto& i : mNodes)
+		{
+			for (unsigned int j = 0; j < 6; ++j)
+			{
+				if (i->getNFS(j) == 0 || i->getConstraint(j) == 1) continue;
+				keys[i->getGlobalDOF(j)] = low_rank_reanalysis::key(*i, j);
+			}
+		}
+		return keys;
+	} // DOFKeys()
+	
+	void fea::PCG(const std::map<element::load_case,Eigen::VectorXd>& initialGuesses)
+	{ // the GSM is symmetric, both triangles are used so that Eigen can multiply it in parallel
+		if (mMatrixFree)
+		{ // of the GSM, only the nodal blocks on the diagonal are available
+			if (mPCGSettings.mPreconditioner != "BlockJacobi")
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nTrying to solve a matrix-free FEA system with PCG and preconditioner:\n"
+										 << mPCGSettings.mPreconditioner << "\n"
+										 << "matrix-free systems can only be preconditioned with BlockJacobi\n"
+										 << "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::invalid_argument(errorMessage.str());
+			}
+			Eigen::ConjugateGradient<element_by_element_operator, Eigen::Lower|Eigen::Upper,
+				block_jacobi_preconditioner> solver;
+			solver.preconditioner().setBlockSizes(this->nodalBlockSizes());
+			this->conjugateGradient(solver, mEBEOperator, initialGuesses);
+		}
+		else if (mPCGSettings.mPreconditioner == "IncompleteCholesky")
+		{
+			Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper,
+				Eigen::IncompleteCholesky<double> > solver;
+			this->conjugateGradient(solver, mGSM, initialGuesses);
+		}
+		else if (mPCGSettings.mPreconditioner == "BlockJacobi")
+		{
+			Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper,
+				block_jacobi_preconditioner> solver;
+			solver.preconditioner().setBlockSizes(this->nodalBlockSizes());
+			this->conjugateGradient(solver, mGSM, initialGuesses);
+		}
+		else if (mPCGSettings.mPreconditioner == "Multigrid")
+		{
+			if (mMultigridLevels.empty())
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nTrying to solve FEA system with a multigrid preconditioner,\n"
+										 << "but the system has no coarse levels, e.g. because it was meshed with an odd mesh size.\n"
+										 << "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::runtime_error(errorMessage.str());
+			}
+			Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper,
+				multigrid_preconditioner> solver;
+			solver.preconditioner().setProlongations(this->multigridProlongations());
+			solver.preconditioner().setSmoothingSteps(mPCGSettings.mSmoothingSteps);
+			this->conjugateGradient(solver, mGSM, initialGuesses);
+		}
+		else
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nTrying to solve FEA system with PCG and unknown preconditioner:\n"
+									 << mPCGSettings.mPreconditioner << "\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+	} // PCG()
+	
+	std::vector<Eigen::SparseMatrix<double> > fea::multigridProlongations() const
+	{ // the free DOFs of the nodes on each coarse level are numbered in the order of mNodes
+		unsigned long levels = mMultigridLevels.size();
+		if (mPCGSettings.mMultigridLevels > 0 && mPCGSettings.mMultigridLevels < levels)
+		{
+			levels = mPCGSettings.mMultigridLevels;
+		}
+		
+		std::map<element::node*, std::vector<long> > fineDOFs, coarseDOFs;
+		for (const auto& i : mNodes)
+		{
+			std::vector<long> DOFs(6,-1);
+			for (unsigned int j = 0; j < 6; ++j)
+			{
+				if (i->getNFS(j) == 1 && i->getConstraint(j) == 0) DOFs[j] = i->getGlobalDOF(j);
+			}
+			fineDOFs[i] = DOFs;
+		}
+		
+		std::vector<Eigen::SparseMatrix<double> > prolongations;
+		long fineDOFCount = mDOFCount;
+		for (unsigned long l = 0; l < levels; ++l)
+		{
+			std::set<element::node*> coarseNodes;
+			for (const auto& i : mMultigridLevels[l])
+			{
+				for (const auto& j : i.second) coarseNodes.insert(j.first);
+			}
+			coarseDOFs.clear();
+			long coarseDOFCount = 0;
+			for (const auto& i : mNodes)
+			{
+				if (coarseNodes.find(i) == coarseNodes.end()) continue;
+				std::vector<long> DOFs(6,-1);
+				for (unsigned int j = 0; j < 6; ++j)
+				{
+					if (i->getNFS(j) == 1 && i->getConstraint(j) == 0) DOFs[j] = coarseDOFCount++;
+				}
+				coarseDOFs[i] = DOFs;
+			}
+			
+			std::vector<Eigen::Triplet<double> > triplets;
+			for (const auto& i : mMultigridLevels[l])
+			{
+				auto fineSearch = fineDOFs.find(i.first);
+				if (fineSearch == fineDOFs.end()) continue; // the node is not on this level
+				for (const auto& j : i.second)
+				{
+					auto coarseSearch = coarseDOFs.find(j.first);
+					if (coarseSearch == coarseDOFs.end()) continue; // the node is not part of this system
+					for (unsigned int k = 0; k < 6; ++k)
+					{ // DOFs that are constrained or inactive on either level are not interpolated
+						if (fineSearch->second[k] < 0 || coarseSearch->second[k] < 0) continue;
+						triplets.push_back(Eigen::Triplet<double>(fineSearch->second[k],
+							coarseSearch->second[k], j.second));
+					}
+				}
+			}
+			Eigen::SparseMatrix<double> prolongation(fineDOFCount, coarseDOFCount);
+			prolongation.setFromTriplets(triplets.begin(), triplets.end());
+			prolongations.push_back(prolongation);
+			
+			std::swap(fineDOFs, coarseDOFs);
+			fineDOFCount = coarseDOFCount;
+		}
+		return prolongations;
+	} // multigridProlongations()
+	
 	fea::fea()
 	{
 		
@@ -188,51 +519,35 @@ namespace bso { namespace structural_design {
 	void fea::addElement(element::element* ele)
 	{
 		mElements.push_back(ele);
+		mResponseGroups.clear();
 	} // addElement()
 	
 	void fea::generateGSM()
 	{
+		BSO_SCOPED_TIMER("gsm_assembly");
 		if (!mSystemInitialized)
 		{
 			mDOFCount = 0;
 			for (auto& i : mNodes) i->generateNFT(mDOFCount);
 			for (auto& i : mElements) i->generateEFT();
 			
-			// get all the load cases
-			for (auto& i : mNodes)
-			{
-				auto nodalLC = i->getLoadCases();
-				for (auto& j : nodalLC)
-				{
-					if (std::find(mLoadCases.begin(), mLoadCases.end(),j) == mLoadCases.end())
-					{
-						mLoadCases.push_back(j);
-					}
-				}
-			}
-			
-			// create and fill the load vectors
-			for (auto& i : mLoadCases)
+			// get all the load cases and fill their load vectors in a single pass over the nodes
+			for (const auto& i : mNodes)
 			{
-				mLoads[i] = Eigen::VectorXd::Zero(mDOFCount);
-				for (auto & j : mNodes)
+				const auto& nodalLC = i->getLoadCases();
+				const auto& nodalLoads = i->getLoadTable();
+				const std::array<unsigned long, 6>& NFT = i->getNFT();
+				for (unsigned long j = 0; j < nodalLC.size(); ++j)
 				{
-					Eigen::Vector6d nodalLoads;
-					try
+					auto loadSearch = mLoads.find(nodalLC[j]);
+					if (loadSearch == mLoads.end())
 					{
-						Eigen::Vector6d nodalLoads = j->getLoads(i);
-					}
-					catch (std::exception& e)
-					{
-						// this node does not have a load with this load case
-						j->addLoadCase(i);
-						Eigen::Vector6d nodalLoads = j->getLoads(i);
+						mLoadCases.push_back(nodalLC[j]);
+						loadSearch = mLoads.emplace(nodalLC[j], Eigen::VectorXd::Zero(mDOFCount)).first;
 					}
 					for (unsigned int k = 0; k < 6; ++k)
 					{
-						if (j->getNFS(k) == 0 || j->getConstraint(k) == 1) continue;
-						unsigned int DOF = j->getGlobalDOF(k);
-						mLoads[i](DOF) = nodalLoads(k);
+						if (NFT[k] != element::inactiveDOF) loadSearch->second(NFT[k]) = nodalLoads(k,j);
 					}
 				}
 			}
@@ -243,8 +558,26 @@ namespace bso { namespace structural_design {
 			mSystemInitialized = true;
 		}
 	
-		mGSM.resize(0,0); // clear it in case there are still any components left
-		mGSM.resize(mDOFCount,mDOFCount); // size it to the numbe rof DOF''s in the system
+		BSO_COUNT("gsm_dofs", mDOFCount);
+		if (mMatrixFree)
+		{ // only the stiffness factors of the elements have to be read again
+			mGSM = Eigen::SparseMatrix<double>(); // releases the memory of the assembled GSM
+			if (!mEBEOperator.isInitialized())
+			{
+				mEBEOperator.initialize(mElements, mNodes, mDOFCount, mMatrixFreeThreads);
+			}
+			else mEBEOperator.update();
+			return;
+		}
+		
+		this->assembleGSM(mGSM);
+		BSO_COUNT("gsm_non_zeros", mGSM.nonZeros());
+	} // generateGSM()
+	
+	void fea::assembleGSM(Eigen::SparseMatrix<double>& GSM) const
+	{
+		GSM.resize(0,0); // clear it in case there are still any components left
+		GSM.resize(mDOFCount,mDOFCount); // size it to the numbe rof DOF''s in the system
 		
 		std::vector<element::triplet > triplets;
 		for (const auto& i : mElements)
@@ -253,25 +586,153 @@ namespace bso { namespace structural_design {
 			triplets.insert(triplets.end(), trips.begin(), trips.end());
 		}
 		
-		mGSM.setFromTriplets(triplets.begin(), triplets.end());
-	} // generateGSM()
+		GSM.setFromTriplets(triplets.begin(), triplets.end());
+	} // assembleGSM()
+	
+	void fea::setMatrixFree(const bool& matrixFree, const unsigned int& threads /*= 0*/)
+	{
+		mMatrixFree = matrixFree;
+		mMatrixFreeThreads = threads;
+		mEBEOperator = element_by_element_operator();
+		if (mSystemInitialized) this->generateGSM();
+	} // setMatrixFree()
 	
 	void fea::clearResponse()
 	{
 		for (auto& i : mElements) i->clearResponse();
 		for (auto& i : mNodes) i->clearDisplacements();
 		for (auto& i : mDisplacements) i.second.setZero();
+		mResponses.clear();
 	} // clearResponse()
 	
+	void fea::groupResponseElements()
+	{ // congruent elements share their stiffness matrices, the most recent groups are the most likely match
+		mResponseGroups.clear();
+		for (unsigned long i = 0; i < mElements.size(); ++i)
+		{
+			const element::element* e = mElements[i];
+			const std::vector<const Eigen::MatrixXd*> separatedSMs = e->getSeparatedSMs();
+			long group = -1;
+			for (long j = mResponseGroups.size() - 1;
+					 j >= 0 && j + 16 >= (long)mResponseGroups.size(); --j)
+			{
+				const element::element* reference = mElements[mResponseGroups[j].front()];
+				if (reference->getOriginalSM().rows() != e->getOriginalSM().rows() ||
+						reference->getEFT().size() != e->getEFT().size() ||
+						reference->getOriginalSM() != e->getOriginalSM()) continue;
+				const std::vector<const Eigen::MatrixXd*> referenceSMs = reference->getSeparatedSMs();
+				bool sameSMs = (referenceSMs.size() == separatedSMs.size());
+				for (unsigned long k = 0; sameSMs && k < separatedSMs.size(); ++k)
+				{
+					sameSMs = (*referenceSMs[k] == *separatedSMs[k]);
+				}
+				if (!sameSMs) continue;
+				group = j;
+				break;
+			}
+			if (group < 0)
+			{
+				group = mResponseGroups.size();
+				mResponseGroups.push_back({});
+			}
+			mResponseGroups[group].push_back(i);
+		}
+	} // groupResponseElements()
+	
+	void fea::computeResponses()
+	{ // the energies of each group of elements that share their stiffness matrix are computed with one
+		// product of that matrix with the displacements of all the elements in all the load cases
+		BSO_SCOPED_TIMER("responses");
+		const unsigned long loadCaseCount = mLoadCases.size();
+		mResponses.mLoadCases = mLoadCases;
+		mResponses.mDisplacements.resize(mDOFCount, loadCaseCount);
+		for (unsigned long i = 0; i < loadCaseCount; ++i)
+		{
+			mResponses.mDisplacements.col(i) = mDisplacements.at(mLoadCases[i]);
+		}
+		mResponses.mEnergies.setZero(mElements.size(), loadCaseCount);
+		for (auto& i : mResponses.mSeparatedEnergies) i.setZero(mElements.size(), loadCaseCount);
+		if (mResponseGroups.empty()) this->groupResponseElements();
+		
+		Eigen::MatrixXd U, KU;
+		Eigen::RowVectorXd energies;
+		for (const auto& i : mResponseGroups)
+		{
+			const element::element* reference = mElements[i.front()];
+			const unsigned long DOFCount = reference->getEFT().size();
+			
+			// the displacements of the element DOFs, one column for each element and load case
+			U.setZero(DOFCount, i.size() * loadCaseCount);
+			for (unsigned long j = 0; j < i.size(); ++j)
+			{
+				const std::vector<unsigned long>& EFT = mElements[i[j]]->getEFT();
+				for (unsigned long k = 0; k < DOFCount; ++k)
+				{
+					if (EFT[k] == element::inactiveDOF) continue;
+					U.block(k, j * loadCaseCount, 1, loadCaseCount) = mResponses.mDisplacements.row(EFT[k]);
+				}
+			}
+			
+			KU.noalias() = reference->getOriginalSM() * U;
+			energies.noalias() = 0.5 * U.cwiseProduct(KU).colwise().sum();
+			for (unsigned long j = 0; j < i.size(); ++j)
+			{
+				mResponses.mEnergies.row(i[j]) = mElements[i[j]]->getStiffnessFactor() *
+					energies.segment(j * loadCaseCount, loadCaseCount);
+			}
+			const std::vector<const Eigen::MatrixXd*> separatedSMs = reference->getSeparatedSMs();
+			for (unsigned long k = 0; k < separatedSMs.size() && k < mResponses.mSeparatedEnergies.size(); ++k)
+			{
+				KU.noalias() = *separatedSMs[k] * U;
+				energies.noalias() = 0.5 * U.cwiseProduct(KU).colwise().sum();
+				for (unsigned long j = 0; j < i.size(); ++j)
+				{
+					mResponses.mSeparatedEnergies[k].row(i[j]) = energies.segment(j * loadCaseCount, loadCaseCount);
+				}
+			}
+			
+			// the stresses of the elements that compute them are those of the last load case
+			if (loadCaseCount == 0) continue;
+			for (unsigned long j = 0; j < i.size(); ++j)
+			{
+				mElements[i[j]]->computeStress(U.col((j + 1) * loadCaseCount - 1));
+			}
+		}
+		
+		mResponses.mTotalEnergies = mResponses.mEnergies.rowwise().sum();
+		mResponses.mSeparatedTotalEnergies.resize(mElements.size(), 3);
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			mResponses.mSeparatedTotalEnergies.col(i) = mResponses.mSeparatedEnergies[i].rowwise().sum();
+		}
+		for (auto& i : mNodes) i->setResponseBuffer(&mResponses);
+		for (unsigned long i = 0; i < mElements.size(); ++i) mElements[i]->setResponseBuffer(&mResponses, i);
+	} // computeResponses()
+	
 	void fea::solve(std::string solver /*= "SimplicialLLT"*/)
 	{
+		if (mMatrixFree && solver != "PCG")
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nTrying to solve a matrix-free FEA system with solver: " << solver << "\n"
+									 << "matrix-free systems can only be solved with PCG\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
 		msolver = solver;
+		std::map<element::load_case,Eigen::VectorXd> initialGuesses;
+		if (solver == "PCG" && mPCGSettings.mWarmStart) initialGuesses = mDisplacements;
 		// solve the system with the specified solver
 		this->clearResponse();
-		if (solver == "SimplicialLLT") this->simplicialLLT();
+		mSolverStatistics.clear();
+		if (!mStaticCondensation.isEmpty()) this->solveCondensed(solver);
+		else if (solver == "SimplicialLLT") this->simplicialLLT();
 		else if (solver == "SimplicialLDLT") this->simplicialLDLT();
+		else if (solver == "Supernodal") this->supernodal();
+		else if (solver == "Reanalysis") this->reanalysis();
 		else if (solver == "BiCGSTAB") this->BiCGSTAB();
 		else if (solver == "scaledBiCGSTAB") this->scaledBiCGSTAB();
+		else if (solver == "PCG") this->PCG(initialGuesses);
 		else 
 		{
 			std::stringstream errorMessage;
@@ -281,22 +742,66 @@ namespace bso { namespace structural_design {
 			throw std::invalid_argument(errorMessage.str());
 		}
 
-		// add the displacements to the nodes
-		for (auto& i : mNodes) i->addDisplacements(mDisplacements);
-		
-		// compute the responses for elements for every load case
-		for (auto& i : mElements) 
+		// the responses of the nodes and elements for every load case
+		this->computeResponses();
+	} // solve()
+	
+	void fea::setPCGSettings(const pcg_settings& settings)
+	{
+		if (!(settings.mTolerance > 0))
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nThe tolerance of the PCG solver should be larger than zero, received:\n"
+									 << settings.mTolerance << "\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		if (settings.mSmoothingSteps == 0)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nThe multigrid preconditioner of the PCG solver needs at least one smoothing step.\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		mPCGSettings = settings;
+	} // setPCGSettings()
+	
+	void fea::setStaticCondensation(const std::vector<std::vector<element::element*> >& components,
+		const unsigned int& threads /*= 0*/)
+	{
+		mStaticCondensation.setGroups(components, threads);
+	} // setStaticCondensation()
+	
+	void fea::setReanalysis(std::shared_ptr<low_rank_reanalysis> reanalysis)
+	{
+		mReanalysis = reanalysis;
+	} // setReanalysis()
+	
+	void fea::setMultigridLevels(const std::vector<nodal_prolongation>& levels)
+	{
+		for (const auto& i : levels)
 		{
-			for (auto& j : mLoadCases) 
+			if (i.empty())
 			{
-				i->computeResponse(j);
+				std::stringstream errorMessage;
+				errorMessage << "\nError, received a multigrid level without nodes.\n"
+										 << "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::invalid_argument(errorMessage.str());
 			}
-		}		
-	} // solve()
+		}
+		mMultigridLevels = levels;
+	} // setMultigridLevels()
 
 	Eigen::MatrixXd fea::solveAdjoint(Eigen::MatrixXd& ae) // for stress_based topopt
 	{
 		Eigen::MatrixXd Lambda;
+		if (!mStaticCondensation.isEmpty())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nCould not solve Adjoint system of a statically condensed FEA system\n"
+									 << "(bso/structural_design/fea.cpp)" << std::endl;
+			throw std::runtime_error(errorMessage.str());
+		}
 		if (msolver == "SimplicialLLT")
 		{
 			try
@@ -335,6 +840,36 @@ namespace bso { namespace structural_design {
 				throw std::runtime_error(errorMessage.str());
 			}
 		}
+		else if (msolver == "Supernodal")
+		{
+			try
+			{
+				Lambda = mSupernodalSolver.solve(ae);
+			}
+			catch (std::exception& e)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nWhen solving an Adjoint system with Supernodal \n"
+										<< "received the following error:\n" << e.what() << "\n"
+										<< "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::runtime_error(errorMessage.str());
+			}
+		}
+		else if (msolver == "Reanalysis")
+		{
+			try
+			{
+				Lambda = mReanalysisUpdate.solve(ae);
+			}
+			catch (std::exception& e)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nWhen solving an Adjoint system with Reanalysis \n"
+										<< "received the following error:\n" << e.what() << "\n"
+										<< "(bso/structural_design/fea.cpp)" << std::endl;
+				throw std::runtime_error(errorMessage.str());
+			}
+		}
 		else
 		{
 			std::stringstream errorMessage;
@@ -347,11 +882,19 @@ namespace bso { namespace structural_design {
 
 	bool fea::isSingular()
 	{
-		if (mGSM.nonZeros() == 0) return true;
-		Eigen::JacobiSVD<Eigen::MatrixXd> SVD(mGSM);
-		double cond = SVD.singularValues()(0) / SVD.singularValues()(SVD.singularValues().size()-1);
-		return cond > 1e10;
-	}
+		Eigen::SparseMatrix<double> assembledGSM;
+		if (mMatrixFree) this->assembleGSM(assembledGSM);
+		const Eigen::SparseMatrix<double>& GSM = mMatrixFree? assembledGSM : mGSM;
+		if (GSM.nonZeros() == 0) return true;
+		// a column of which the part that is independent of the preceding columns is shorter than
+		// 1e-10 times the longest column bounds the condition number from below by 1e10
+		double maxColumnNorm = 0;
+		for (long i = 0; i < GSM.outerSize(); ++i) maxColumnNorm = std::max(maxColumnNorm, GSM.col(i).norm());
+		Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > QR;
+		QR.setPivotThreshold(1e-10 * maxColumnNorm);
+		QR.compute(GSM);
+		return QR.info() != Eigen::Success || QR.rank() < GSM.cols();
+	} // isSingular()
 
 	Eigen::VectorXd fea::getDisplacements(element::load_case lc) const
 	{
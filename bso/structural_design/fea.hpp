@@ -2,11 +2,36 @@
 #define SD_FEA_HPP
 
 #include <bso/structural_design/element/elements.hpp>
+#include <bso/structural_design/block_jacobi_preconditioner.hpp>
+#include <bso/structural_design/multigrid_preconditioner.hpp>
+#include <bso/structural_design/element_by_element_operator.hpp>
+#include <bso/structural_design/supernodal_cholesky.hpp>
+#include <bso/structural_design/low_rank_reanalysis.hpp>
+#include <bso/structural_design/static_condensation.hpp>
+#include <bso/utilities/instrumentation.hpp>
 #include <Eigen/Sparse>
 #include <Eigen/Dense>
 
 namespace bso { namespace structural_design {
 	
+	struct pcg_settings
+	{
+		std::string mPreconditioner = "IncompleteCholesky"; // or "BlockJacobi", with the DOFs of each node as a block, or "Multigrid"
+		double mTolerance = 1e-8; // of the residual, relative to the load vector
+		unsigned long mMaxIterations = 0; // 0 is twice the number of DOFs
+		bool mWarmStart = true; // start from the displacements of the previous solve
+		unsigned int mMultigridLevels = 0; // the number of coarse levels used by the multigrid preconditioner, 0 is all levels
+		unsigned int mSmoothingSteps = 2; // the Gauss-Seidel sweeps on each multigrid level, before and after the coarse correction
+	};
+	
+	typedef std::map<element::node*, std::vector<std::pair<element::node*,double> > > nodal_prolongation; // for each node of a level, the interpolation weights of the nodes on the next coarser level
+	
+	struct solver_statistics
+	{ // of an iterative solver, for a single load case
+		unsigned long mIterations = 0;
+		double mRelativeResidual = 0.0;
+	};
+	
 	class fea
 	{
 	private:
@@ -17,19 +42,44 @@ namespace bso { namespace structural_design {
 		std::vector<element::load_case> mLoadCases;
 		std::map<element::load_case,Eigen::VectorXd> mLoads;
 		std::map<element::load_case,Eigen::VectorXd> mDisplacements;
+		element::response_buffer mResponses; // read by the nodes and elements after a solve
+		std::vector<std::vector<unsigned long> > mResponseGroups; // of the elements that share their stiffness matrices
 		
 		Eigen::SparseMatrix<double> mGSM;
 		bool mSystemInitialized = false;
+		bool mMatrixFree = false; // K*u is computed element by element instead of assembling mGSM
+		unsigned int mMatrixFreeThreads = 0;
+		element_by_element_operator mEBEOperator;
 		
 		std::string msolver;
 		Eigen::SimplicialLLT<Eigen::SparseMatrix<double> > mLLTSolver;
 		Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > mLDLTSolver;
+		supernodal_cholesky mSupernodalSolver;
+		std::shared_ptr<low_rank_reanalysis> mReanalysis; // may be shared with the systems of other models
+		low_rank_reanalysis::update mReanalysisUpdate;
+		static_condensation mStaticCondensation;
+		pcg_settings mPCGSettings;
+		std::map<element::load_case,solver_statistics> mSolverStatistics;
+		std::vector<nodal_prolongation> mMultigridLevels;
 
 		// solvers
 		void simplicialLLT();
 		void simplicialLDLT();
+		void supernodal();
+		void reanalysis();
+		void solveCondensed(const std::string& solver);
 		void BiCGSTAB();
 		void scaledBiCGSTAB();
+		void PCG(const std::map<element::load_case,Eigen::VectorXd>& initialGuesses);
+		std::vector<Eigen::SparseMatrix<double> > multigridProlongations() const;
+		std::vector<unsigned long> nodalBlockSizes() const;
+		std::vector<dof_key> DOFKeys() const;
+		template <class SOLVER, class MATRIX>
+		void conjugateGradient(SOLVER& solver, const MATRIX& GSM,
+			const std::map<element::load_case,Eigen::VectorXd>& initialGuesses);
+		void assembleGSM(Eigen::SparseMatrix<double>& GSM) const;
+		void groupResponseElements();
+		void computeResponses();
 	public:
 		fea();
 		~fea();
@@ -38,18 +88,33 @@ namespace bso { namespace structural_design {
 		void addElement(element::element* ele);
 		
 		void generateGSM();
+		void setMatrixFree(const bool& matrixFree, const unsigned int& threads = 0); // only PCG with BlockJacobi can solve a matrix-free system, 0 threads is one per hardware thread
 		void clearResponse();
 		
-		void solve(std::string solver = "SimplicialLDLT");
+		void solve(std::string solver = "SimplicialLDLT"); // SimplicialLLT, SimplicialLDLT, Supernodal, Reanalysis, BiCGSTAB, scaledBiCGSTAB, or PCG
+		void setStaticCondensation(const std::vector<std::vector<element::element*> >& components,
+			const unsigned int& threads = 0); // the interiors of the components are condensed before solving with SimplicialLLT, SimplicialLDLT or Supernodal, no components solves the full system
+		void setReanalysis(std::shared_ptr<low_rank_reanalysis> reanalysis); // the reference system of the Reanalysis solver, e.g. shared by the models of similar designs
+		void setPCGSettings(const pcg_settings& settings);
+		void setMultigridLevels(const std::vector<nodal_prolongation>& levels); // from fine to coarse, e.g. the nodes of the meshes at n, n/2, n/4
 		Eigen::MatrixXd solveAdjoint(Eigen::MatrixXd& ae);
 		bool isSingular();
 		
 		Eigen::VectorXd getDisplacements(element::load_case lc) const;
+		const element::response_buffer& getResponses() const {return mResponses;} // of the last solve, the rows of the energies follow getElements()
 		const std::vector<element::node*>& getNodes() const {return mNodes;}
 		std::vector<element::node*>& getNodes() {return mNodes;}
 		const std::vector<element::element*>& getElements() const {return mElements;}
 		std::vector<element::element*>& getElements() {return mElements;}
 		const unsigned long& getDOFCount() const {return mDOFCount;}
+		const pcg_settings& getPCGSettings() const {return mPCGSettings;}
+		const std::vector<nodal_prolongation>& getMultigridLevels() const {return mMultigridLevels;}
+		const bool& isMatrixFree() const {return mMatrixFree;}
+		const element_by_element_operator& getEBEOperator() const {return mEBEOperator;}
+		const std::shared_ptr<low_rank_reanalysis>& getReanalysis() const {return mReanalysis;}
+		const static_condensation& getStaticCondensation() const {return mStaticCondensation;}
+		unsigned long getReanalysisRank() const {return mReanalysisUpdate.rank();} // of the change solved by the last Reanalysis solve, 0 if it was factored or did not change
+		const std::map<element::load_case,solver_statistics>& getSolverStatistics() const {return mSolverStatistics;} // of the last solve with an iterative solver
 	};
 	
 } // namespace structural_design
@@ -0,0 +1,265 @@
+#ifndef SD_LOW_RANK_REANALYSIS_CPP
+#define SD_LOW_RANK_REANALYSIS_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace bso { namespace structural_design {
+
+	template <class RHS>
+	Eigen::MatrixXd low_rank_reanalysis::update::solve(const Eigen::MatrixBase<RHS>& b) const
+	{
+		if (mReference == nullptr)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, cannot solve a system with a low rank update\n"
+									 << "that has no factored reference system.\n"
+									 << "(bso/structural_design/low_rank_reanalysis.cpp)" << std::endl;
+			throw std::runtime_error(errorMessage.str());
+		}
+		if ((unsigned long)b.rows() != mReferenceDOFs.size())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, cannot solve a system of " << mReferenceDOFs.size() << " rows with\n"
+									 << "a right hand side of " << b.rows() << " rows.\n"
+									 << "(bso/structural_design/low_rank_reanalysis.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+
+		// the right hand side in the DOFs of the reference, it is zero on the decoupled DOFs
+		Eigen::MatrixXd y = Eigen::MatrixXd::Zero(mReference->mGSM.rows(), b.cols());
+		for (unsigned long i = 0; i < mReferenceDOFs.size(); ++i) y.row(mReferenceDOFs[i]) = b.row(i);
+		y = mReference->mFactorisation.solve(y);
+
+		if (this->rank() > 0)
+		{ // y - K0^-1*U*(C^-1 + U^T*K0^-1*U)^-1*U^T*y, the correction is one more solve with K0
+			Eigen::MatrixXd ySupport(mSupport.size(), b.cols());
+			for (unsigned long i = 0; i < mSupport.size(); ++i) ySupport.row(i) = y.row(mSupport[i]);
+			Eigen::MatrixXd correction = mV * mCapacitance.solve(mV.transpose() * ySupport);
+			Eigen::MatrixXd Ucorrection = Eigen::MatrixXd::Zero(y.rows(), b.cols());
+			for (unsigned long i = 0; i < mSupport.size(); ++i) Ucorrection.row(mSupport[i]) = correction.row(i);
+			y -= mReference->mFactorisation.solve(Ucorrection);
+		}
+
+		Eigen::MatrixXd x(mReferenceDOFs.size(), b.cols());
+		for (unsigned long i = 0; i < mReferenceDOFs.size(); ++i) x.row(i) = y.row(mReferenceDOFs[i]);
+		return x;
+	} // solve()
+
+	low_rank_reanalysis::low_rank_reanalysis()
+	:	mFactorisations(0), mReanalyses(0)
+	{
+
+	} // ctor()
+
+	void low_rank_reanalysis::setMaxRank(const unsigned long& n)
+	{ // 0 always factors the system
+		mMaxRank = n;
+	} // setMaxRank()
+
+	void low_rank_reanalysis::setTolerance(const double& tol)
+	{
+		if (!(tol > 0))
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nThe tolerance of a low rank reanalysis should be larger than zero, received:\n"
+									 << tol << "\n"
+									 << "(bso/structural_design/low_rank_reanalysis.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		mTolerance = tol;
+	} // setTolerance()
+
+	low_rank_reanalysis::update low_rank_reanalysis::compute(const Eigen::SparseMatrix<double>& GSM,
+		const std::vector<dof_key>& keys)
+	{
+		if (GSM.rows() != GSM.cols() || (unsigned long)GSM.rows() != keys.size())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, cannot reanalyze a system with " << GSM.rows() << " rows, "
+									 << GSM.cols() << " columns\n"
+									 << "and " << keys.size() << " DOF keys.\n"
+									 << "(bso/structural_design/low_rank_reanalysis.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		std::shared_ptr<const reference_system> reference;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			reference = mReference;
+		}
+		if (reference == nullptr || mMaxRank == 0) return this->factorize(GSM, keys);
+
+		// match the DOFs of the system with those of the reference
+		update result;
+		result.mReference = reference;
+		const unsigned long referenceSize = reference->mGSM.rows();
+		std::vector<long> systemDOFs(referenceSize, -1);
+		result.mReferenceDOFs.resize(keys.size());
+		for (unsigned long i = 0; i < keys.size(); ++i)
+		{
+			auto DOFSearch = reference->mDOFs.find(keys[i]);
+			if (DOFSearch == reference->mDOFs.end() || systemDOFs[DOFSearch->second] != -1)
+			{ // the reference does not have this DOF
+				return this->factorize(GSM, keys);
+			}
+			result.mReferenceDOFs[i] = DOFSearch->second;
+			systemDOFs[DOFSearch->second] = i;
+		}
+
+		// the change of the system in the DOFs of the reference, column by column, without the round-off
+		// of its assembly. The reference DOFs that the system does not have keep their diagonal coefficient
+		const Eigen::SparseMatrix<double>& K0 = reference->mGSM;
+		const double threshold = mTolerance * reference->mMaxCoefficient;
+		std::vector<Eigen::Triplet<double> > changes;
+		auto addChange = [&changes, &threshold](const long& row, const long& col, const double& value)
+		{
+			if (std::abs(value) > threshold) changes.push_back(Eigen::Triplet<double>(row, col, value));
+		};
+		std::vector<std::pair<long, double> > column;
+		for (unsigned long j = 0; j < referenceSize; ++j)
+		{
+			column.clear();
+			if (systemDOFs[j] == -1) column.push_back(std::make_pair(j, K0.coeff(j,j)));
+			else
+			{
+				for (Eigen::SparseMatrix<double>::InnerIterator it(GSM,systemDOFs[j]); it; ++it)
+				{
+					column.push_back(std::make_pair(result.mReferenceDOFs[it.row()], it.value()));
+				}
+				std::sort(column.begin(), column.end());
+			}
+			auto entry = column.begin();
+			for (Eigen::SparseMatrix<double>::InnerIterator it(K0,j); it; ++it)
+			{
+				for (; entry != column.end() && entry->first < it.row(); ++entry)
+				{
+					addChange(entry->first, j, entry->second);
+				}
+				if (entry != column.end() && entry->first == it.row())
+				{
+					addChange(it.row(), j, entry->second - it.value());
+					++entry;
+				}
+				else addChange(it.row(), j, -it.value());
+			}
+			for (; entry != column.end(); ++entry) addChange(entry->first, j, entry->second);
+		}
+
+		std::vector<long> supportIndices(referenceSize, -1);
+		for (const auto& i : changes)
+		{
+			for (const long& j : {(long)i.row(), (long)i.col()})
+			{
+				if (supportIndices[j] != -1) continue;
+				supportIndices[j] = result.mSupport.size();
+				result.mSupport.push_back(j);
+			}
+		}
+		if (result.mSupport.empty())
+		{
+			++mReanalyses;
+			return result;
+		}
+		if (result.mSupport.size() > 4 * mMaxRank)
+		{ // the eigenvalue decomposition would cost more than it could save
+			return this->factorize(GSM, keys);
+		}
+
+		// dK = U*C*U^T, with the eigenvectors of the change in its support as U and the eigenvalues as C
+		const unsigned long supportSize = result.mSupport.size();
+		Eigen::MatrixXd dKSupport = Eigen::MatrixXd::Zero(supportSize, supportSize);
+		for (const auto& i : changes) dKSupport(supportIndices[i.row()], supportIndices[i.col()]) = i.value();
+		Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigenSolver(dKSupport);
+		const Eigen::VectorXd& eigenvalues = eigenSolver.eigenvalues();
+		const double eigenvalueThreshold = mTolerance * eigenvalues.cwiseAbs().maxCoeff();
+		std::vector<unsigned long> ranks;
+		for (unsigned long i = 0; i < supportSize; ++i)
+		{
+			if (std::abs(eigenvalues(i)) > eigenvalueThreshold) ranks.push_back(i);
+		}
+		if (ranks.size() > mMaxRank) return this->factorize(GSM, keys);
+
+		const unsigned long rank = ranks.size();
+		result.mV.resize(supportSize, rank);
+		Eigen::VectorXd inverseC(rank);
+		for (unsigned long i = 0; i < rank; ++i)
+		{
+			result.mV.col(i) = eigenSolver.eigenvectors().col(ranks[i]);
+			inverseC(i) = 1.0 / eigenvalues(ranks[i]);
+		}
+		// U^T*K0^-1*U = W^T*W with W = L^-1*P*U, which is only nonzero on the ancestors of the support
+		Eigen::MatrixXd U = Eigen::MatrixXd::Zero(referenceSize, rank);
+		for (unsigned long i = 0; i < supportSize; ++i) U.row(result.mSupport[i]) = result.mV.row(i);
+		Eigen::MatrixXd W = reference->mFactorisation.solveLower(U);
+		std::vector<unsigned long> reachedRows;
+		for (unsigned long i = 0; i < referenceSize; ++i)
+		{
+			if (!W.row(i).isZero(0)) reachedRows.push_back(i);
+		}
+		Eigen::MatrixXd WReached(reachedRows.size(), rank);
+		for (unsigned long i = 0; i < reachedRows.size(); ++i) WReached.row(i) = W.row(reachedRows[i]);
+		Eigen::MatrixXd capacitance(rank, rank);
+		capacitance.setZero();
+		capacitance.selfadjointView<Eigen::Lower>().rankUpdate(WReached.transpose());
+		capacitance = capacitance.selfadjointView<Eigen::Lower>();
+		capacitance.diagonal() += inverseC;
+		result.mCapacitance.compute(capacitance);
+		if (!result.mCapacitance.isInvertible())
+		{ // the changed system is singular, or too close to it for the update
+			return this->factorize(GSM, keys);
+		}
+
+		++mReanalyses;
+		return result;
+	} // compute()
+
+	low_rank_reanalysis::update low_rank_reanalysis::factorize(const Eigen::SparseMatrix<double>& GSM,
+		const std::vector<dof_key>& keys)
+	{
+		if (GSM.rows() != GSM.cols() || (unsigned long)GSM.rows() != keys.size())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, cannot factorize a system with " << GSM.rows() << " rows, "
+									 << GSM.cols() << " columns\n"
+									 << "and " << keys.size() << " DOF keys.\n"
+									 << "(bso/structural_design/low_rank_reanalysis.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		std::shared_ptr<reference_system> reference = std::make_shared<reference_system>();
+		reference->mGSM = GSM;
+		reference->mGSM.makeCompressed();
+		if (GSM.nonZeros() > 0) reference->mMaxCoefficient = reference->mGSM.coeffs().cwiseAbs().maxCoeff();
+		for (unsigned long i = 0; i < keys.size(); ++i) reference->mDOFs[keys[i]] = i;
+		reference->mFactorisation.compute(reference->mGSM);
+		++mFactorisations;
+
+		update result;
+		result.mReferenceDOFs.resize(keys.size());
+		std::iota(result.mReferenceDOFs.begin(), result.mReferenceDOFs.end(), 0);
+		if (reference->mFactorisation.info() != Eigen::Success) return result;
+
+		result.mReference = reference;
+		std::lock_guard<std::mutex> lock(mMutex);
+		mReference = reference;
+		return result;
+	} // factorize()
+
+	dof_key low_rank_reanalysis::key(const Eigen::Vector3d& position, const unsigned int& localDOF)
+	{
+		return {std::llround(position(0) * 1e6), std::llround(position(1) * 1e6),
+						std::llround(position(2) * 1e6), (long long)localDOF};
+	} // key()
+
+	bool low_rank_reanalysis::hasReference() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mReference != nullptr;
+	} // hasReference()
+
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_LOW_RANK_REANALYSIS_CPP
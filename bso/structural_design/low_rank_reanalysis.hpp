@@ -0,0 +1,80 @@
+#ifndef SD_LOW_RANK_REANALYSIS_HPP
+#define SD_LOW_RANK_REANALYSIS_HPP
+
+#include <bso/structural_design/supernodal_cholesky.hpp>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace bso { namespace structural_design {
+
+	typedef std::array<long long, 4> dof_key; // the position of a node, rounded to 1e-6, and the local index of one of its DOFs
+
+	class low_rank_reanalysis
+	{ // keeps the Cholesky factorisation of a reference system K0 and solves systems that differ from it
+		// by a low rank change dK = U*C*U^T with the Sherman-Morrison-Woodbury identity:
+		// (K0 + U*C*U^T)^-1 = K0^-1 - K0^-1*U*(C^-1 + U^T*K0^-1*U)^-1*U^T*K0^-1.
+		// The DOFs of a system are matched with those of the reference by their keys, so consecutive
+		// models with different meshes can share one reference. Reference DOFs that a system does not
+		// have are decoupled from the others, they are part of the change. If the system has DOFs that
+		// the reference does not have, or the rank of the change exceeds the threshold, the system is
+		// factored and becomes the new reference. One reference may be shared by concurrent analyses
+	private:
+		struct reference_system
+		{
+			Eigen::SparseMatrix<double> mGSM;
+			double mMaxCoefficient = 0.0;
+			std::map<dof_key, unsigned long> mDOFs;
+			supernodal_cholesky mFactorisation;
+		};
+		std::shared_ptr<const reference_system> mReference;
+		unsigned long mMaxRank = 64;
+		double mTolerance = 1e-10; // relative to the largest coefficient of K0 and the largest eigenvalue of the change
+		std::atomic<unsigned long> mFactorisations, mReanalyses;
+		mutable std::mutex mMutex;
+	public:
+		class update
+		{ // the change of one system with respect to the reference it was computed with
+			friend class low_rank_reanalysis;
+		private:
+			std::shared_ptr<const reference_system> mReference;
+			std::vector<unsigned long> mReferenceDOFs; // of each DOF of the system
+			std::vector<unsigned long> mSupport; // the reference DOFs that are changed, the nonzero rows of U
+			Eigen::MatrixXd mV; // the rows of U in the support
+			Eigen::FullPivLU<Eigen::MatrixXd> mCapacitance; // of C^-1 + U^T*K0^-1*U
+		public:
+			template <class RHS>
+			Eigen::MatrixXd solve(const Eigen::MatrixBase<RHS>& b) const;
+
+			bool isValid() const {return mReference != nullptr;} // false if the system could not be factored
+			unsigned long rank() const {return mV.cols();}
+		};
+
+		low_rank_reanalysis();
+
+		void setMaxRank(const unsigned long& n); // 0 always factors the system
+		void setTolerance(const double& tol);
+
+		update compute(const Eigen::SparseMatrix<double>& GSM, const std::vector<dof_key>& keys); // keys of each DOF of the GSM
+		update factorize(const Eigen::SparseMatrix<double>& GSM, const std::vector<dof_key>& keys); // the GSM becomes the reference
+
+		static dof_key key(const Eigen::Vector3d& position, const unsigned int& localDOF);
+		bool hasReference() const;
+		const unsigned long& getMaxRank() const {return mMaxRank;}
+		unsigned long factorisations() const {return mFactorisations;}
+		unsigned long reanalyses() const {return mReanalyses;} // the systems that were solved by a low rank update
+	};
+
+} // namespace structural_design
+} // namespace bso
+
+#include <bso/structural_design/low_rank_reanalysis.cpp>
+
+#endif // SD_LOW_RANK_REANALYSIS_HPP
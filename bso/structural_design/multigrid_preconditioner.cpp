@@ -0,0 +1,130 @@
+#ifndef SD_MULTIGRID_PRECONDITIONER_CPP
+#define SD_MULTIGRID_PRECONDITIONER_CPP
+
+#include <sstream>
+#include <stdexcept>
+
+namespace bso { namespace structural_design {
+
+	multigrid_preconditioner::multigrid_preconditioner()
+	{
+
+	} // ctor()
+
+	template <class MATRIX>
+	multigrid_preconditioner::multigrid_preconditioner(const MATRIX& mat)
+	{
+		this->compute(mat);
+	} // ctor()
+
+	void multigrid_preconditioner::setProlongations(
+		const std::vector<Eigen::SparseMatrix<double> >& prolongations)
+	{
+		for (unsigned long i = 1; i < prolongations.size(); ++i)
+		{
+			if (prolongations[i].rows() != prolongations[i-1].cols())
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nError, prolongation " << i << " of a multigrid preconditioner maps to "
+										 << prolongations[i].rows() << " DOFs,\n"
+										 << "while the level above it has " << prolongations[i-1].cols() << " DOFs.\n"
+										 << "(bso/structural_design/multigrid_preconditioner.cpp)" << std::endl;
+				throw std::invalid_argument(errorMessage.str());
+			}
+		}
+		mProlongations = prolongations;
+	} // setProlongations()
+
+	void multigrid_preconditioner::setSmoothingSteps(const unsigned int& n)
+	{
+		if (n == 0)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, a multigrid preconditioner needs at least one smoothing step.\n"
+									 << "(bso/structural_design/multigrid_preconditioner.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		mSmoothingSteps = n;
+	} // setSmoothingSteps()
+
+	template <class MATRIX>
+	multigrid_preconditioner& multigrid_preconditioner::analyzePattern(const MATRIX& mat)
+	{
+		mSize = mat.rows();
+		if (mat.cols() != mSize ||
+				(!mProlongations.empty() && mProlongations.front().rows() != mSize))
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, the finest prolongation of a multigrid preconditioner maps to "
+									 << (mProlongations.empty()? mSize : mProlongations.front().rows()) << " DOFs,\n"
+									 << "while the matrix has " << mat.rows() << " rows and " << mat.cols() << " columns.\n"
+									 << "(bso/structural_design/multigrid_preconditioner.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		return *this;
+	} // analyzePattern()
+
+	template <class MATRIX>
+	multigrid_preconditioner& multigrid_preconditioner::factorize(const MATRIX& mat)
+	{
+		mOperators.resize(mProlongations.size() + 1);
+		mOperators[0] = mat;
+		for (unsigned long i = 0; i < mProlongations.size(); ++i)
+		{ // Galerkin coarse operator
+			Eigen::SparseMatrix<double> AP = mOperators[i] * mProlongations[i];
+			mOperators[i+1] = Eigen::SparseMatrix<double>(mProlongations[i].transpose()) * AP;
+		}
+		mCoarseSolver.compute(mOperators.back());
+		mInfo = mCoarseSolver.info();
+		return *this;
+	} // factorize()
+
+	template <class MATRIX>
+	multigrid_preconditioner& multigrid_preconditioner::compute(const MATRIX& mat)
+	{
+		this->analyzePattern(mat);
+		return this->factorize(mat);
+	} // compute()
+
+	void multigrid_preconditioner::smooth(const unsigned long& level, Eigen::VectorXd& x,
+		const Eigen::VectorXd& b, const bool& forward) const
+	{ // one Gauss-Seidel sweep, the operators are symmetric so column i holds row i
+		const Eigen::SparseMatrix<double>& A = mOperators[level];
+		const Eigen::Index n = A.rows();
+		for (Eigen::Index k = 0; k < n; ++k)
+		{
+			const Eigen::Index i = forward? k : n - 1 - k;
+			double sum = b(i), diagonal = 0;
+			for (Eigen::SparseMatrix<double>::InnerIterator it(A,i); it; ++it)
+			{
+				if (it.row() == i) diagonal = it.value();
+				else sum -= it.value() * x(it.row());
+			}
+			if (diagonal != 0) x(i) = sum / diagonal;
+		}
+	} // smooth()
+
+	Eigen::VectorXd multigrid_preconditioner::vCycle(const unsigned long& level,
+		const Eigen::VectorXd& b) const
+	{
+		if (level + 1 == mOperators.size()) return mCoarseSolver.solve(b);
+
+		Eigen::VectorXd x = Eigen::VectorXd::Zero(b.rows());
+		for (unsigned int i = 0; i < mSmoothingSteps; ++i) this->smooth(level, x, b, true);
+		Eigen::VectorXd residual = b - mOperators[level] * x;
+		x += mProlongations[level] *
+			this->vCycle(level + 1, mProlongations[level].transpose() * residual);
+		for (unsigned int i = 0; i < mSmoothingSteps; ++i) this->smooth(level, x, b, false);
+		return x;
+	} // vCycle()
+
+	template <class RHS>
+	Eigen::VectorXd multigrid_preconditioner::solve(const Eigen::MatrixBase<RHS>& b) const
+	{
+		return this->vCycle(0, b);
+	} // solve()
+
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_MULTIGRID_PRECONDITIONER_CPP
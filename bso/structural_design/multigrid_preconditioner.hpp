@@ -0,0 +1,59 @@
+#ifndef SD_MULTIGRID_PRECONDITIONER_HPP
+#define SD_MULTIGRID_PRECONDITIONER_HPP
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <vector>
+
+namespace bso { namespace structural_design {
+
+	class multigrid_preconditioner
+	{ // preconditioner for Eigen's iterative solvers that applies one geometric multigrid V-cycle.
+		// The coarse operators are the Galerkin products P^T*A*P of the given prolongations, the
+		// levels are smoothed by Gauss-Seidel (forward before, backward after the coarse correction,
+		// so the preconditioner stays symmetric) and the coarsest level is solved directly
+	private:
+		std::vector<Eigen::SparseMatrix<double> > mProlongations; // from each coarse level to the level above it
+		std::vector<Eigen::SparseMatrix<double> > mOperators; // the symmetric matrix of each level, finest first
+		Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > mCoarseSolver;
+		unsigned int mSmoothingSteps = 2;
+		Eigen::ComputationInfo mInfo = Eigen::Success;
+		Eigen::Index mSize = 0;
+
+		void smooth(const unsigned long& level, Eigen::VectorXd& x, const Eigen::VectorXd& b,
+			const bool& forward) const;
+		Eigen::VectorXd vCycle(const unsigned long& level, const Eigen::VectorXd& b) const;
+	public:
+		typedef int StorageIndex;
+		enum {ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic};
+
+		multigrid_preconditioner();
+		template <class MATRIX>
+		explicit multigrid_preconditioner(const MATRIX& mat);
+
+		void setProlongations(const std::vector<Eigen::SparseMatrix<double> >& prolongations); // from fine to coarse, each maps the DOFs of a coarser level to those of the level above it
+		void setSmoothingSteps(const unsigned int& n);
+
+		template <class MATRIX>
+		multigrid_preconditioner& analyzePattern(const MATRIX& mat);
+		template <class MATRIX>
+		multigrid_preconditioner& factorize(const MATRIX& mat);
+		template <class MATRIX>
+		multigrid_preconditioner& compute(const MATRIX& mat);
+
+		template <class RHS>
+		Eigen::VectorXd solve(const Eigen::MatrixBase<RHS>& b) const;
+
+		unsigned long levels() const {return mOperators.size();}
+		Eigen::Index coarseSize() const {return mOperators.empty()? 0 : mOperators.back().rows();}
+		Eigen::Index rows() const {return mSize;}
+		Eigen::Index cols() const {return mSize;}
+		Eigen::ComputationInfo info() {return mInfo;}
+	};
+
+} // namespace structural_design
+} // namespace bso
+
+#include <bso/structural_design/multigrid_preconditioner.cpp>
+
+#endif // SD_MULTIGRID_PRECONDITIONER_HPP
@@ -3,6 +3,9 @@
 
 #include <bso/structural_design/topology_optimization/topology_optimization.hpp>
 
+#include <algorithm>
+#include <utility>
+
 namespace bso { namespace structural_design {
 	
 	void sd_model::clearMesh()
@@ -15,8 +18,136 @@ namespace bso { namespace structural_design {
 			delete mFEA;
 			mFEA = new fea();
 			mMeshedPoints.clear();
+			mElementIndex.clear();
+			mComponentElements.clear();
 		}
 	} // clearMesh()
+	
+	template <class GEOMETRY>
+	std::vector<unsigned long> sd_model::containedElements(const GEOMETRY* geom)
+	{ // the elements inside a component of this model are looked up after its first query
+		if (mElementIndex.size() != mFEA->getElements().size()) mElementIndex.build(mFEA->getElements());
+		auto componentPtr = dynamic_cast<const component::geometry*>(geom);
+		if (componentPtr == nullptr ||
+				std::find(mGeometries.begin(), mGeometries.end(), componentPtr) == mGeometries.end())
+		{
+			return mElementIndex.findContained(*geom);
+		}
+		auto componentSearch = mComponentElements.find(componentPtr);
+		if (componentSearch == mComponentElements.end())
+		{
+			componentSearch = mComponentElements.emplace(componentPtr, mElementIndex.findContained(*geom)).first;
+		}
+		return componentSearch->second;
+	} // containedElements()
+
+	void sd_model::generateMultigridLevels(const unsigned int& n,
+		const std::map<component::point*, element::node*>& nodeMap)
+	{ // the grid of a component meshed at n contains its grids at n/2, n/4, ... as every second,
+		// fourth, ... grid point. A node that is not on the next coarser grid is interpolated
+		// (bi/tri)linearly from the coarse grid points around it
+		unsigned int levels = 0;
+		while (n > 0 && n % (2u << levels) == 0) ++levels;
+		if (levels == 0) return;
+		
+		// the grid coordinates of the meshed points of each component
+		std::vector<std::pair<component::geometry*,unsigned int> > grids;
+		for (const auto& i : mGeometries)
+		{
+			unsigned int dimensions = 1;
+			if (i->isQuadrilateral()) dimensions = 2;
+			else if (i->isQuadHexahedron()) dimensions = 3;
+			unsigned long gridPoints = 1;
+			for (unsigned int j = 0; j < dimensions; ++j) gridPoints *= n + 1;
+			if (i->getMeshedPoints().size() == gridPoints) grids.push_back({i,dimensions});
+		}
+		auto gridCoordinates = [n](const unsigned long& index, const unsigned int& dimensions)
+		{
+			std::vector<unsigned int> coordinates(dimensions);
+			unsigned long remainder = index;
+			for (auto& i : coordinates)
+			{
+				i = remainder % (n + 1);
+				remainder /= n + 1;
+			}
+			return coordinates;
+		};
+		auto coordinateLevel = [levels](const std::vector<unsigned int>& coordinates)
+		{ // the coarsest level on which each coordinate is a grid line
+			unsigned int level = levels;
+			for (const auto& i : coordinates)
+			{
+				unsigned int coordinateLevel = 0;
+				while (i != 0 && coordinateLevel < levels && i % (2u << coordinateLevel) == 0) ++coordinateLevel;
+				if (i != 0 && coordinateLevel < level) level = coordinateLevel;
+			}
+			return level;
+		};
+		
+		// a node is on a level if it is a grid point of that level in every component that contains it
+		std::map<element::node*, unsigned int> nodeLevels;
+		for (const auto& i : nodeMap) nodeLevels[i.second] = levels;
+		for (const auto& i : grids)
+		{
+			const auto& points = i.first->getMeshedPoints();
+			for (unsigned long j = 0; j < points.size(); ++j)
+			{
+				unsigned int& level = nodeLevels[nodeMap.at(points[j])];
+				level = std::min(level, coordinateLevel(gridCoordinates(j,i.second)));
+			}
+		}
+		
+		std::vector<nodal_prolongation> prolongations(levels);
+		for (unsigned int l = 0; l < levels; ++l)
+		{
+			const unsigned int stride = 1u << l;
+			for (const auto& i : nodeLevels)
+			{ // nodes that are on the coarser level are injected
+				if (i.second > l) prolongations[l][i.first] = {{i.first,1.0}};
+			}
+			for (const auto& i : grids)
+			{
+				const auto& points = i.first->getMeshedPoints();
+				for (unsigned long j = 0; j < points.size(); ++j)
+				{
+					element::node* fineNode = nodeMap.at(points[j]);
+					if (nodeLevels[fineNode] != l || prolongations[l].count(fineNode) > 0) continue;
+					std::vector<unsigned int> coordinates = gridCoordinates(j,i.second);
+					if (coordinateLevel(coordinates) != l) continue;
+					
+					// the tensor product of the linear interpolation along each grid direction
+					std::vector<std::pair<unsigned long,double> > weights = {{0,1.0}};
+					unsigned long directionStride = 1;
+					for (const auto& k : coordinates)
+					{
+						std::vector<std::pair<unsigned long,double> > newWeights;
+						for (const auto& m : weights)
+						{
+							if (k % (2*stride) == 0)
+							{
+								newWeights.push_back({m.first + k*directionStride, m.second});
+							}
+							else
+							{
+								newWeights.push_back({m.first + (k - stride)*directionStride, 0.5*m.second});
+								newWeights.push_back({m.first + (k + stride)*directionStride, 0.5*m.second});
+							}
+						}
+						weights = newWeights;
+						directionStride *= n + 1;
+					}
+					
+					auto& interpolation = prolongations[l][fineNode];
+					for (const auto& k : weights)
+					{
+						element::node* coarseNode = nodeMap.at(points[k.first]);
+						if (nodeLevels[coarseNode] > l) interpolation.push_back({coarseNode,k.second});
+					}
+				}
+			}
+		}
+		mFEA->setMultigridLevels(prolongations);
+	} // generateMultigridLevels()
 
 	sd_model::sd_model() 
 	{
@@ -27,7 +158,9 @@ namespace bso { namespace structural_design {
 	{
 		for (const auto& i : rhs.mPoints)
 		{
-			this->addPoint(*i);
+			auto newPoint = this->addPoint(*i);
+			for (const auto& j : i->getLoads()) newPoint->addLoad(j);
+			for (const auto& j : i->getConstraints()) newPoint->addConstraint(j);
 		}
 		for (const auto& i : rhs.mGeometries)
 		{
@@ -63,6 +196,16 @@ namespace bso { namespace structural_design {
 		}
 		mMeshSize = rhs.mMeshSize;
 		mTopOptStreamBuffer = rhs.mTopOptStreamBuffer;
+		mTopOptMaxIterations = rhs.mTopOptMaxIterations;
+		mTopOptSolver = rhs.mTopOptSolver;
+		mMatrixFree = rhs.mMatrixFree;
+		mMatrixFreeThreads = rhs.mMatrixFreeThreads;
+		mStaticCondensation = rhs.mStaticCondensation;
+		mCondensationThreads = rhs.mCondensationThreads;
+		mReanalysis = rhs.mReanalysis;
+		mStabilityFEA = rhs.mStabilityFEA;
+		mStabilitySignature = rhs.mStabilitySignature;
+		mIsStable = rhs.mIsStable;
 	}
 
 	sd_model::~sd_model()
@@ -73,6 +216,30 @@ namespace bso { namespace structural_design {
 		if (mIsMeshed) delete mFEA;
 	} // //dtor()
 
+	sd_model& sd_model::operator=(sd_model rhs)
+	{ // rhs is a copy, swapping hands the current components to it for deletion
+		std::swap(mPoints, rhs.mPoints);
+		std::swap(mGeometries, rhs.mGeometries);
+		std::swap(mMeshedPoints, rhs.mMeshedPoints);
+		std::swap(mFEA, rhs.mFEA);
+		std::swap(mTopOptStreamBuffer, rhs.mTopOptStreamBuffer);
+		std::swap(mTopOptMaxIterations, rhs.mTopOptMaxIterations);
+		std::swap(mTopOptSolver, rhs.mTopOptSolver);
+		std::swap(mMatrixFree, rhs.mMatrixFree);
+		std::swap(mMatrixFreeThreads, rhs.mMatrixFreeThreads);
+		std::swap(mStaticCondensation, rhs.mStaticCondensation);
+		std::swap(mCondensationThreads, rhs.mCondensationThreads);
+		std::swap(mReanalysis, rhs.mReanalysis);
+		std::swap(mMeshSize, rhs.mMeshSize);
+		std::swap(mIsMeshed, rhs.mIsMeshed);
+		std::swap(mElementIndex, rhs.mElementIndex);
+		std::swap(mComponentElements, rhs.mComponentElements);
+		std::swap(mStabilityFEA, rhs.mStabilityFEA);
+		std::swap(mStabilitySignature, rhs.mStabilitySignature);
+		std::swap(mIsStable, rhs.mIsStable);
+		return *this;
+	} // operator=()
+
 	component::point* sd_model::addPoint(bso::utilities::geometry::vertex p)
 	{
 		for (auto& i : mPoints)
@@ -148,6 +315,7 @@ namespace bso { namespace structural_design {
 
 	void sd_model::mesh(const unsigned int& n, bool meshLoadPanels /* = true */)
 	{
+		BSO_SCOPED_TIMER("mesh");
 		// intiialize a new FEA system
 		this->clearMesh();
 
@@ -297,8 +465,15 @@ namespace bso { namespace structural_design {
 			}
 		}
 
+		BSO_COUNT("mesh_elements", elementID);
+		this->generateMultigridLevels(n, nodeMap);
+
 		// generate the fea system
+		if (mStaticCondensation) this->condenseQuadrilaterals();
+		if (mMatrixFree) mFEA->setMatrixFree(true, mMatrixFreeThreads);
+		if (mReanalysis != nullptr) mFEA->setReanalysis(mReanalysis);
 		mFEA->generateGSM();
+		mElementIndex.build(mFEA->getElements());
 		mIsMeshed = true;
 	} // mesh()
 
@@ -334,15 +509,36 @@ namespace bso { namespace structural_design {
 		}
 	} // analyze()
 	
+	std::vector<unsigned long> sd_model::stabilitySignature() const
+	{ // components are only ever added to a model, and structures and constraints to its components
+		std::vector<unsigned long> signature = {mPoints.size(), mGeometries.size()};
+		for (const auto& i : mPoints) signature.push_back(i->getConstraints().size());
+		for (const auto& i : mGeometries)
+		{
+			signature.push_back(i->getStructures().size());
+			signature.push_back(i->getConstraints().size());
+		}
+		return signature;
+	} // stabilitySignature()
+	
 	bool sd_model::isStable()
-	{
-		bool preMeshed = mIsMeshed;
-		mesh(1,false);
-		mIsMeshed = false;
-		bool isStable = !mFEA->isSingular();
-		if (preMeshed) this->mesh(); // mesh it back to original mesh size
-		return isStable;
-	}
+	{ // the coarse mesh is generated in a copy of the model, so the mesh of this model is left intact
+		std::vector<unsigned long> signature = this->stabilitySignature();
+		if (mStabilityFEA != nullptr && signature == mStabilitySignature) return mIsStable;
+		
+		sd_model coarseModel(*this);
+		coarseModel.mMatrixFree = false;
+		coarseModel.mStaticCondensation = false;
+		coarseModel.mReanalysis = nullptr;
+		coarseModel.mesh(1,false);
+		mStabilityFEA.reset(coarseModel.mFEA);
+		coarseModel.mFEA = nullptr;
+		coarseModel.mIsMeshed = false;
+		
+		mIsStable = !mStabilityFEA->isSingular();
+		mStabilitySignature = signature;
+		return mIsStable;
+	} // isStable()
 	
 	void sd_model::rescaleStructuralVolume(const double& scaleFactor)
 	{
@@ -350,6 +546,7 @@ namespace bso { namespace structural_design {
 		{
 			i->rescaleStructuralVolume(scaleFactor);
 		}
+		mStabilityFEA = nullptr; // the coarse mesh has the old structural volume
 	} // rescaleStructuralVolume()
 	
 	void sd_model::setElementDensities(const double& volumeFraction, const double& penalty)
@@ -374,6 +571,48 @@ namespace bso { namespace structural_design {
 		mTopOptStreamBuffer = out.rdbuf();
 	}
 	
+	void sd_model::setTopOptMaxIterations(const unsigned int& n)
+	{ // 0 means that the optimizations run until they converge
+		mTopOptMaxIterations = n;
+	} // setTopOptMaxIterations()
+	
+	void sd_model::setTopOptSolver(const std::string& solver)
+	{ // e.g. PCG, which starts from the displacements of the previous iteration
+		mTopOptSolver = solver;
+	} // setTopOptSolver()
+	
+	void sd_model::setMatrixFree(const bool& matrixFree, const unsigned int& threads /*= 0*/)
+	{ // e.g. for topology optimization of solid models with PCG and BlockJacobi
+		mMatrixFree = matrixFree;
+		mMatrixFreeThreads = threads;
+		if (mIsMeshed) mFEA->setMatrixFree(matrixFree, threads);
+	} // setMatrixFree()
+	
+	void sd_model::condenseQuadrilaterals()
+	{ // at mesh size n, the (n-1)^2 interior nodes of a quadrilateral only connect to its own elements
+		std::vector<std::vector<element::element*> > components;
+		for (const auto& i : mGeometries)
+		{
+			if (i->isQuadrilateral()) components.push_back(i->getElements());
+		}
+		mFEA->setStaticCondensation(components, mCondensationThreads);
+	} // condenseQuadrilaterals()
+	
+	void sd_model::setStaticCondensation(const bool& condense, const unsigned int& threads /*= 0*/)
+	{ // e.g. for finely meshed shell structures
+		mStaticCondensation = condense;
+		mCondensationThreads = threads;
+		if (!mIsMeshed) return;
+		if (condense) this->condenseQuadrilaterals();
+		else mFEA->setStaticCondensation({});
+	} // setStaticCondensation()
+	
+	void sd_model::setReanalysis(std::shared_ptr<low_rank_reanalysis> reanalysis)
+	{ // the models that share it only factor their system if it differs too much from the reference
+		mReanalysis = reanalysis;
+		if (mIsMeshed) mFEA->setReanalysis(reanalysis);
+	} // setReanalysis()
+	
 	sd_results sd_model::getTotalResults()
 	{
 		sd_results results;
@@ -403,19 +642,10 @@ namespace bso { namespace structural_design {
 	{
 		sd_results results;
 		
-		for (const auto& i : mFEA->getElements())
+		const std::vector<element::element*>& elements = mFEA->getElements();
+		for (const auto& j : this->containedElements(geom))
 		{
-			bool allPointsInsideOrOn = true;
-			for (const auto& j : i->getNodes())
-			{
-				auto vertexPtr = dynamic_cast<bso::utilities::geometry::vertex*>(j);
-				if (!geom->isInsideOrOn(*vertexPtr))
-				{
-					allPointsInsideOrOn = false;
-					break;
-				}
-			}
-			if (!allPointsInsideOrOn) continue;
+			const element::element* i = elements[j];
 			
 			if (i->isActiveInCompliance())
 			{
@@ -441,19 +671,10 @@ namespace bso { namespace structural_design {
 	{
 		sd_results results;
 		
-		for (const auto& i : mFEA->getElements())
+		const std::vector<element::element*>& elements = mFEA->getElements();
+		for (const auto& j : this->containedElements(geom))
 		{
-			bool allPointsInsideOrOn = true;
-			for (const auto& j : i->getNodes())
-			{
-				auto vertexPtr = dynamic_cast<bso::utilities::geometry::vertex*>(j);
-				if (!geom->isInsideOrOn(*vertexPtr))
-				{
-					allPointsInsideOrOn = false;
-					break;
-				}
-			}
-			if (!allPointsInsideOrOn) continue;
+			const element::element* i = elements[j];
 
 			if (i->isActiveInCompliance())
 			{
@@ -4,6 +4,7 @@
 #include <ostream>
 #include <sstream>
 #include <bso/structural_design/fea.hpp>
+#include <bso/structural_design/element_index.hpp>
 #include <bso/structural_design/component/point.hpp>
 #include <bso/structural_design/component/line_segment.hpp>
 #include <bso/structural_design/component/quadrilateral.hpp>
@@ -20,16 +21,35 @@ namespace bso { namespace structural_design {
 		std::vector<component::geometry*> mGeometries;
 		std::vector<component::point*> mMeshedPoints;
 		
-		fea* mFEA;
+		fea* mFEA = nullptr;
 		std::streambuf* mTopOptStreamBuffer;
+		unsigned int mTopOptMaxIterations = 0; // 0 means that the optimizations run until they converge
+		std::string mTopOptSolver = "SimplicialLDLT"; // the stress based optimization always uses SimplicialLDLT
+		bool mMatrixFree = false; // the meshed FEA systems are not assembled
+		unsigned int mMatrixFreeThreads = 0;
+		bool mStaticCondensation = false; // the interiors of quadrilaterals are condensed before solving
+		unsigned int mCondensationThreads = 0;
+		std::shared_ptr<low_rank_reanalysis> mReanalysis; // the reference system of the Reanalysis solver, shared with copies of the model
 		
 		unsigned int mMeshSize = 1;
 		bool mIsMeshed = false;
+		element_index mElementIndex; // of the elements of the FEA system, built by mesh()
+		std::map<const component::geometry*, std::vector<unsigned long> > mComponentElements; // the elements inside each component that was queried
 		void clearMesh();
+		template <class GEOMETRY>
+		std::vector<unsigned long> containedElements(const GEOMETRY* geom); // the indices in the FEA system of the elements inside geom
+		std::shared_ptr<fea> mStabilityFEA; // the model meshed at size 1 without load panels, shared with copies of the model
+		std::vector<unsigned long> mStabilitySignature; // of the components that mStabilityFEA was meshed from
+		bool mIsStable = false; // the result of the singularity test of mStabilityFEA
+		std::vector<unsigned long> stabilitySignature() const; // the numbers of components, structures and constraints
+		void condenseQuadrilaterals(); // passes the elements of each quadrilateral to the fea system
+		void generateMultigridLevels(const unsigned int& n,
+			const std::map<component::point*, element::node*>& nodeMap); // passes the grids at n/2, n/4, ... to the fea system
 	public:
 		sd_model();
 		sd_model(const sd_model& rhs);
 		~sd_model();
+		sd_model& operator=(sd_model rhs); // releases the components of the model that is assigned to
 		
 		component::point* addPoint(bso::utilities::geometry::vertex p);
 		component::geometry* addGeometry(const bso::utilities::geometry::line_segment& g);
@@ -40,7 +60,7 @@ namespace bso { namespace structural_design {
 		void mesh();
 		void mesh(const unsigned int& n, bool meshLoadPanels = true);
 		void analyze(std::string solver = "SimplicialLDLT");
-		bool isStable();
+		bool isStable(); // tests a coarse mesh of the model, which is kept until components, structures or constraints are added
 		
 		void rescaleStructuralVolume(const double& scaleFactor);
 		void setElementDensities(const double& volumeFraction, const double& penalty);
@@ -48,6 +68,11 @@ namespace bso { namespace structural_design {
 		template <typename T, typename...ARGS>
 		void topologyOptimization(const ARGS&...);
 		void setTopOptOutputStream(std::ostream& out);
+		void setTopOptMaxIterations(const unsigned int& n);
+		void setTopOptSolver(const std::string& solver);
+		void setMatrixFree(const bool& matrixFree, const unsigned int& threads = 0);
+		void setStaticCondensation(const bool& condense, const unsigned int& threads = 0); // only for SimplicialLLT, SimplicialLDLT and Supernodal, 0 threads is one per hardware thread
+		void setReanalysis(std::shared_ptr<low_rank_reanalysis> reanalysis); // e.g. the same for consecutive models of a grammar, which are then analyzed with Reanalysis
 		
 		sd_results getTotalResults();
 		sd_results getPartialResults(bso::utilities::geometry::polygon* geom);
@@ -0,0 +1,251 @@
+#ifndef SD_STATIC_CONDENSATION_CPP
+#define SD_STATIC_CONDENSATION_CPP
+
+#include <algorithm>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace bso { namespace structural_design {
+
+	static_condensation::static_condensation()
+	{
+
+	} // ctor()
+
+	void static_condensation::setGroups(const std::vector<std::vector<element::element*> >& groups,
+		const unsigned int& threads /*= 0*/)
+	{
+		mGroups.clear();
+		for (const auto& i : groups)
+		{
+			if (!i.empty()) mGroups.push_back(std::vector<const element::element*>(i.begin(), i.end()));
+		}
+		mThreads = threads;
+		mComponents.clear();
+	} // setGroups()
+
+	void static_condensation::condenseComponent(component& c,
+		const std::map<element::load_case, Eigen::VectorXd>& loads) const
+	{
+		const unsigned long interiorSize = c.mInterior.size(), boundarySize = c.mBoundary.size();
+		std::map<unsigned long, unsigned long> localDOFs; // the interior DOFs first
+		for (unsigned long i = 0; i < interiorSize; ++i) localDOFs[c.mInterior[i]] = i;
+		for (unsigned long i = 0; i < boundarySize; ++i) localDOFs[c.mBoundary[i]] = interiorSize + i;
+
+		std::vector<element::triplet> interiorTriplets, couplingTriplets;
+		Eigen::MatrixXd Kbb = Eigen::MatrixXd::Zero(boundarySize, boundarySize);
+		for (const auto& i : c.mElements)
+		{
+			for (const auto& j : i->getSMTriplets())
+			{
+				unsigned long row = localDOFs.at(j.row()), col = localDOFs.at(j.col());
+				if (row < interiorSize && col < interiorSize) interiorTriplets.push_back(element::triplet(row, col, j.value()));
+				else if (row < interiorSize) couplingTriplets.push_back(element::triplet(row, col - interiorSize, j.value()));
+				else if (col >= interiorSize) Kbb(row - interiorSize, col - interiorSize) += j.value();
+			}
+		}
+		Eigen::SparseMatrix<double> Kii(interiorSize, interiorSize);
+		Kii.setFromTriplets(interiorTriplets.begin(), interiorTriplets.end());
+		c.mCoupling.resize(interiorSize, boundarySize);
+		c.mCoupling.setFromTriplets(couplingTriplets.begin(), couplingTriplets.end());
+
+		c.mInteriorSolver.setThreads(1); // the components are condensed in parallel
+		c.mInteriorSolver.compute(Kii);
+		if (c.mInteriorSolver.info() != Eigen::Success)
+		{
+			c.mFailed = true;
+			return;
+		}
+		Eigen::MatrixXd W = c.mInteriorSolver.solveLower(Eigen::MatrixXd(c.mCoupling));
+		std::vector<unsigned long> reachedRows;
+		for (unsigned long i = 0; i < interiorSize; ++i)
+		{
+			if (!W.row(i).isZero(0)) reachedRows.push_back(i);
+		}
+		Eigen::MatrixXd WReached(reachedRows.size(), boundarySize);
+		for (unsigned long i = 0; i < reachedRows.size(); ++i) WReached.row(i) = W.row(reachedRows[i]);
+		c.mSchurComplement = Kbb;
+		c.mSchurComplement.selfadjointView<Eigen::Lower>().rankUpdate(WReached.transpose(), -1.0);
+		c.mSchurComplement = c.mSchurComplement.selfadjointView<Eigen::Lower>();
+
+		c.mInteriorLoadResponse.clear();
+		Eigen::VectorXd interiorLoads(interiorSize);
+		for (const auto& i : loads)
+		{
+			for (unsigned long j = 0; j < interiorSize; ++j) interiorLoads(j) = i.second(c.mInterior[j]);
+			c.mInteriorLoadResponse[i.first] = c.mInteriorSolver.solve(interiorLoads);
+		}
+	} // condenseComponent()
+
+	void static_condensation::condense(const std::vector<element::element*>& elements,
+		const unsigned long& DOFCount, const std::map<element::load_case, Eigen::VectorXd>& loads,
+		Eigen::SparseMatrix<double>& reducedGSM, std::map<element::load_case, Eigen::VectorXd>& reducedLoads)
+	{
+		std::map<const element::element*, long> elementGroups;
+		for (unsigned long i = 0; i < mGroups.size(); ++i)
+		{
+			for (const auto& j : mGroups[i]) elementGroups[j] = i;
+		}
+
+		// the group that owns each DOF: -2 if no element connects to it, -1 if it is not interior to a group
+		std::vector<long> owners(DOFCount, -2);
+		std::vector<long> groupOfElement(elements.size(), -1);
+		for (unsigned long i = 0; i < elements.size(); ++i)
+		{
+			auto groupSearch = elementGroups.find(elements[i]);
+			if (groupSearch != elementGroups.end()) groupOfElement[i] = groupSearch->second;
+			for (const auto& j : elements[i]->getEFT())
+			{
+				if (j == element::inactiveDOF) continue;
+				long& owner = owners[j];
+				if (owner == -2) owner = groupOfElement[i];
+				else if (owner != groupOfElement[i]) owner = -1;
+			}
+		}
+
+		std::vector<std::shared_ptr<component> > groupComponents(mGroups.size());
+		for (unsigned long i = 0; i < mGroups.size(); ++i)
+		{
+			groupComponents[i] = std::make_shared<component>();
+			groupComponents[i]->mElements = mGroups[i];
+		}
+		mReducedDOFs.assign(DOFCount, -1);
+		mReducedDOFCount = 0;
+		for (unsigned long i = 0; i < DOFCount; ++i)
+		{
+			if (owners[i] >= 0) groupComponents[owners[i]]->mInterior.push_back(i);
+			else mReducedDOFs[i] = mReducedDOFCount++;
+		}
+		mComponents.clear();
+		std::vector<long> marks(DOFCount, -1);
+		for (unsigned long i = 0; i < mGroups.size(); ++i)
+		{
+			component& c = *groupComponents[i];
+			if (c.mInterior.empty()) continue;
+			for (const auto& j : c.mElements)
+			{
+				for (const auto& k : j->getEFT())
+				{
+					if (k == element::inactiveDOF || owners[k] == (long)i || marks[k] == (long)i) continue;
+					marks[k] = i;
+					c.mBoundary.push_back(k);
+				}
+			}
+			std::sort(c.mBoundary.begin(), c.mBoundary.end());
+			mComponents.push_back(groupComponents[i]);
+		}
+
+		// the components are independent of each other
+		unsigned int threads = (mThreads == 0)? std::thread::hardware_concurrency() : mThreads;
+		if (threads <= 1 || mComponents.size() < 2)
+		{
+			for (const auto& i : mComponents) this->condenseComponent(*i, loads);
+		}
+		else
+		{
+			bso::utilities::thread_pool pool(threads);
+			std::vector<std::future<void> > results;
+			for (const auto& i : mComponents)
+			{
+				component* c = i.get();
+				results.push_back(pool.submit([this, c, &loads]()
+				{
+					this->condenseComponent(*c, loads);
+				}));
+			}
+			for (auto& i : results) i.get();
+		}
+		for (const auto& i : mComponents)
+		{
+			if (!i->mFailed) continue;
+			std::stringstream errorMessage;
+			errorMessage << "\nError, when statically condensing an FEA system,\n"
+									 << "could not decompose the stiffness matrix of the interior of a component.\n"
+									 << "(bso/structural_design/static_condensation.cpp)" << std::endl;
+			throw std::runtime_error(errorMessage.str());
+		}
+
+		// assemble the reduced system from the elements outside the components and the super-elements
+		std::vector<element::triplet> triplets;
+		for (unsigned long i = 0; i < elements.size(); ++i)
+		{
+			if (groupOfElement[i] >= 0 && !groupComponents[groupOfElement[i]]->mInterior.empty()) continue;
+			for (const auto& j : elements[i]->getSMTriplets())
+			{
+				triplets.push_back(element::triplet(mReducedDOFs[j.row()], mReducedDOFs[j.col()], j.value()));
+			}
+		}
+		for (const auto& i : mComponents)
+		{
+			const Eigen::MatrixXd& S = i->mSchurComplement;
+			for (long col = 0; col < S.cols(); ++col)
+			{
+				for (long row = 0; row < S.rows(); ++row)
+				{
+					if (S(row,col) == 0) continue;
+					triplets.push_back(element::triplet(mReducedDOFs[i->mBoundary[row]],
+						mReducedDOFs[i->mBoundary[col]], S(row,col)));
+				}
+			}
+		}
+		reducedGSM.resize(0,0);
+		reducedGSM.resize(mReducedDOFCount, mReducedDOFCount);
+		reducedGSM.setFromTriplets(triplets.begin(), triplets.end());
+
+		reducedLoads.clear();
+		for (const auto& i : loads)
+		{
+			Eigen::VectorXd& reduced = reducedLoads[i.first];
+			reduced.resize(mReducedDOFCount);
+			for (unsigned long j = 0; j < DOFCount; ++j)
+			{
+				if (mReducedDOFs[j] >= 0) reduced(mReducedDOFs[j]) = i.second(j);
+			}
+			for (const auto& j : mComponents)
+			{ // g = f_b - K_bi*K_ii^-1*f_i
+				Eigen::VectorXd correction = j->mCoupling.transpose() * j->mInteriorLoadResponse.at(i.first);
+				for (unsigned long k = 0; k < j->mBoundary.size(); ++k)
+				{
+					reduced(mReducedDOFs[j->mBoundary[k]]) -= correction(k);
+				}
+			}
+		}
+	} // condense()
+
+	void static_condensation::recover(const std::map<element::load_case, Eigen::VectorXd>& reducedDisplacements,
+		std::map<element::load_case, Eigen::VectorXd>& displacements) const
+	{
+		for (const auto& i : reducedDisplacements)
+		{
+			if ((unsigned long)i.second.size() != mReducedDOFCount)
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nError, cannot recover the displacements of a statically condensed\n"
+										 << "FEA system of " << mReducedDOFCount << " DOFs from " << i.second.size() << " displacements.\n"
+										 << "(bso/structural_design/static_condensation.cpp)" << std::endl;
+				throw std::invalid_argument(errorMessage.str());
+			}
+			Eigen::VectorXd& u = displacements[i.first];
+			u = Eigen::VectorXd::Zero(mReducedDOFs.size());
+			for (unsigned long j = 0; j < mReducedDOFs.size(); ++j)
+			{
+				if (mReducedDOFs[j] >= 0) u(j) = i.second(mReducedDOFs[j]);
+			}
+			Eigen::VectorXd boundaryDisplacements, interiorDisplacements;
+			for (const auto& j : mComponents)
+			{ // u_i = K_ii^-1*f_i - K_ii^-1*K_ib*u_b
+				boundaryDisplacements.resize(j->mBoundary.size());
+				for (unsigned long k = 0; k < j->mBoundary.size(); ++k) boundaryDisplacements(k) = u(j->mBoundary[k]);
+				interiorDisplacements = j->mInteriorLoadResponse.at(i.first);
+				interiorDisplacements -= j->mInteriorSolver.solve(j->mCoupling * boundaryDisplacements);
+				for (unsigned long k = 0; k < j->mInterior.size(); ++k) u(j->mInterior[k]) = interiorDisplacements(k);
+			}
+		}
+	} // recover()
+
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_STATIC_CONDENSATION_CPP
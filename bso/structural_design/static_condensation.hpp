@@ -0,0 +1,66 @@
+#ifndef SD_STATIC_CONDENSATION_HPP
+#define SD_STATIC_CONDENSATION_HPP
+
+#include <bso/structural_design/element/elements.hpp>
+#include <bso/structural_design/supernodal_cholesky.hpp>
+#include <bso/utilities/thread_pool.hpp>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace bso { namespace structural_design {
+
+	class static_condensation
+	{ // condenses the interior DOFs of groups of elements, e.g. those of one component, into a
+		// super-element on the boundary DOFs of the group: S = K_bb - K_bi*K_ii^-1*K_ib with the
+		// loads g = f_b - K_bi*K_ii^-1*f_i. A DOF is interior to a group if only elements of that group
+		// connect to it. The groups are condensed in parallel, with K_bi*K_ii^-1*K_ib = W^T*W where
+		// W = L^-1*P*K_ib only needs forward substitutions with the sparse columns of K_ib. After the
+		// reduced system has been solved, the interior displacements are recovered by
+		// u_i = K_ii^-1*(f_i - K_ib*u_b)
+	private:
+		struct component
+		{
+			std::vector<const element::element*> mElements;
+			std::vector<unsigned long> mInterior, mBoundary; // global DOFs
+			Eigen::MatrixXd mSchurComplement; // on the boundary DOFs
+			Eigen::SparseMatrix<double> mCoupling; // K_ib
+			supernodal_cholesky mInteriorSolver; // of K_ii
+			std::map<element::load_case, Eigen::VectorXd> mInteriorLoadResponse; // K_ii^-1*f_i
+			bool mFailed = false; // if K_ii could not be factored
+		};
+		std::vector<std::vector<const element::element*> > mGroups;
+		std::vector<std::shared_ptr<component> > mComponents; // of the last condensation, only those with interior DOFs
+		std::vector<long> mReducedDOFs; // the index of each global DOF in the reduced system, -1 if it is interior
+		unsigned long mReducedDOFCount = 0;
+		unsigned int mThreads = 0;
+
+		void condenseComponent(component& c, const std::map<element::load_case, Eigen::VectorXd>& loads) const;
+	public:
+		static_condensation();
+
+		void setGroups(const std::vector<std::vector<element::element*> >& groups,
+			const unsigned int& threads = 0); // 0 threads is one per hardware thread
+
+		void condense(const std::vector<element::element*>& elements, const unsigned long& DOFCount,
+			const std::map<element::load_case, Eigen::VectorXd>& loads, Eigen::SparseMatrix<double>& reducedGSM,
+			std::map<element::load_case, Eigen::VectorXd>& reducedLoads); // after the freedom tables have been generated
+		void recover(const std::map<element::load_case, Eigen::VectorXd>& reducedDisplacements,
+			std::map<element::load_case, Eigen::VectorXd>& displacements) const;
+
+		bool isEmpty() const {return mGroups.empty();}
+		unsigned long groups() const {return mGroups.size();}
+		unsigned long reducedDOFCount() const {return mReducedDOFCount;} // of the last condensation
+		unsigned long condensedComponents() const {return mComponents.size();} // that had interior DOFs in the last condensation
+	};
+
+} // namespace structural_design
+} // namespace bso
+
+#include <bso/structural_design/static_condensation.cpp>
+
+#endif // SD_STATIC_CONDENSATION_HPP
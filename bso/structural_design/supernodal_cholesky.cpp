@@ -0,0 +1,358 @@
+#ifndef SD_SUPERNODAL_CHOLESKY_CPP
+#define SD_SUPERNODAL_CHOLESKY_CPP
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace bso { namespace structural_design {
+
+	supernodal_cholesky::supernodal_cholesky()
+	:	mFailed(false)
+	{
+
+	} // ctor()
+
+	supernodal_cholesky::supernodal_cholesky(const Eigen::SparseMatrix<double>& mat)
+	:	mFailed(false)
+	{
+		this->compute(mat);
+	} // ctor()
+
+	void supernodal_cholesky::setThreads(const unsigned int& threads)
+	{
+		mThreads = threads;
+	} // setThreads()
+
+	bool supernodal_cholesky::hasAnalyzedPattern(const Eigen::SparseMatrix<double>& mat) const
+	{
+		if (!mIsAnalyzed || mat.rows() != mSize || mat.cols() != mSize ||
+				(long)mInnerPattern.size() != mat.nonZeros() || !mat.isCompressed()) return false;
+		return std::equal(mOuterPattern.begin(), mOuterPattern.end(), mat.outerIndexPtr()) &&
+					 std::equal(mInnerPattern.begin(), mInnerPattern.end(), mat.innerIndexPtr());
+	} // hasAnalyzedPattern()
+
+	supernodal_cholesky& supernodal_cholesky::analyzePattern(const Eigen::SparseMatrix<double>& mat)
+	{
+		if (mat.rows() != mat.cols())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, a Cholesky factorisation requires a square matrix, received one with\n"
+									 << mat.rows() << " rows and " << mat.cols() << " columns.\n"
+									 << "(bso/structural_design/supernodal_cholesky.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		mSize = mat.rows();
+		Eigen::SparseMatrix<double> compressed = mat;
+		compressed.makeCompressed();
+		mOuterPattern.assign(compressed.outerIndexPtr(), compressed.outerIndexPtr() + mSize + 1);
+		mInnerPattern.assign(compressed.innerIndexPtr(), compressed.innerIndexPtr() + compressed.nonZeros());
+
+		// fill reducing ordering, in the same way as Eigen's simplicial factorisations
+		Eigen::AMDOrdering<int> ordering;
+		ordering(compressed, mPinv);
+		mP = mPinv.inverse();
+		Eigen::SparseMatrix<double> C(mSize, mSize), CU;
+		C.selfadjointView<Eigen::Lower>() = compressed.selfadjointView<Eigen::Lower>().twistedBy(mP);
+		CU = C.transpose(); // column k holds row k of the lower triangle
+
+		// elimination tree (Liu, 1986), with path compression
+		std::vector<long> parent(mSize, -1), ancestor(mSize, -1);
+		for (long k = 0; k < mSize; ++k)
+		{
+			for (Eigen::SparseMatrix<double>::InnerIterator it(CU,k); it; ++it)
+			{
+				long r = it.row();
+				if (r >= k) continue;
+				while (ancestor[r] != -1 && ancestor[r] != k)
+				{
+					long next = ancestor[r];
+					ancestor[r] = k;
+					r = next;
+				}
+				if (ancestor[r] == -1)
+				{
+					ancestor[r] = k;
+					parent[r] = k;
+				}
+			}
+		}
+		std::vector<std::vector<long> > children(mSize);
+		for (long j = 0; j < mSize; ++j)
+		{
+			if (parent[j] != -1) children[parent[j]].push_back(j);
+		}
+
+		// the structure of each column of L is its own structure in C merged with those of its children.
+		// A column joins the supernode of the previous column if it is that column's only parent and has
+		// the same structure without the previous column
+		mSupernodeColumns.clear();
+		mSupernodeRows.clear();
+		std::vector<long> columnSupernodes(mSize), columnCounts(mSize), mark(mSize, -1), rows;
+		for (long j = 0; j < mSize; ++j)
+		{
+			rows.assign(1, j);
+			mark[j] = j;
+			for (Eigen::SparseMatrix<double>::InnerIterator it(C,j); it; ++it)
+			{
+				if (it.row() > j && mark[it.row()] != j)
+				{
+					mark[it.row()] = j;
+					rows.push_back(it.row());
+				}
+			}
+			for (const auto& c : children[j])
+			{
+				const long& s = columnSupernodes[c];
+				const std::vector<long>& childRows = mSupernodeRows[s];
+				for (unsigned long i = c - mSupernodeColumns[s] + 1; i < childRows.size(); ++i)
+				{
+					if (mark[childRows[i]] != j)
+					{
+						mark[childRows[i]] = j;
+						rows.push_back(childRows[i]);
+					}
+				}
+			}
+			std::sort(rows.begin(), rows.end());
+			columnCounts[j] = rows.size();
+
+			if (j > 0 && parent[j-1] == j && children[j].size() == 1 &&
+					columnCounts[j-1] == columnCounts[j] + 1)
+			{
+				columnSupernodes[j] = columnSupernodes[j-1];
+			}
+			else
+			{
+				columnSupernodes[j] = mSupernodeRows.size();
+				mSupernodeColumns.push_back(j);
+				mSupernodeRows.push_back(rows);
+			}
+		}
+		mSupernodeColumns.push_back(mSize);
+
+		// the supernodal elimination tree, a parent always has a higher index than its children
+		const long supernodeCount = mSupernodeRows.size();
+		mSupernodeParents.assign(supernodeCount, -1);
+		mSupernodeChildren.assign(supernodeCount, {});
+		mSubtreeWork.assign(supernodeCount, 0.0);
+		for (long s = 0; s < supernodeCount; ++s)
+		{
+			const double k = mSupernodeColumns[s+1] - mSupernodeColumns[s];
+			const double m = mSupernodeRows[s].size();
+			mSubtreeWork[s] += k*m*m;
+			const long lastColumnParent = parent[mSupernodeColumns[s+1] - 1];
+			if (lastColumnParent == -1) continue;
+			mSupernodeParents[s] = columnSupernodes[lastColumnParent];
+			mSupernodeChildren[mSupernodeParents[s]].push_back(s);
+			mSubtreeWork[mSupernodeParents[s]] += mSubtreeWork[s];
+		}
+
+		mIsAnalyzed = true;
+		return *this;
+	} // analyzePattern()
+
+	void supernodal_cholesky::factorSupernode(const long& s, const Eigen::SparseMatrix<double>& C)
+	{
+		if (mFailed) return;
+		const long first = mSupernodeColumns[s];
+		const long k = mSupernodeColumns[s+1] - first;
+		const std::vector<long>& rows = mSupernodeRows[s];
+		const long m = rows.size();
+
+		// assemble the front from the columns of C and the update matrices of the children
+		Eigen::MatrixXd F = Eigen::MatrixXd::Zero(m,m);
+		for (long c = 0; c < k; ++c)
+		{
+			for (Eigen::SparseMatrix<double>::InnerIterator it(C,first + c); it; ++it)
+			{ // the rows of a column of C are a subset of the rows of the supernode
+				F(std::lower_bound(rows.begin(), rows.end(), (long)it.row()) - rows.begin(), c) += it.value();
+			}
+		}
+		std::vector<long> map;
+		for (const auto& child : mSupernodeChildren[s])
+		{
+			const std::vector<long>& childRows = mSupernodeRows[child];
+			const long childColumns = mSupernodeColumns[child+1] - mSupernodeColumns[child];
+			map.resize(childRows.size() - childColumns);
+			auto row = rows.begin();
+			for (unsigned long i = 0; i < map.size(); ++i)
+			{
+				row = std::lower_bound(row, rows.end(), childRows[childColumns + i]);
+				map[i] = row - rows.begin();
+			}
+			Eigen::MatrixXd& U = mUpdates[child];
+			for (long b = 0; b < U.cols(); ++b)
+			{
+				for (long a = b; a < U.rows(); ++a) F(map[a], map[b]) += U(a,b);
+			}
+			U.resize(0,0);
+		}
+
+		// factor the front: L11 = chol(F11), L21 = F21*L11^-T, U = F22 - L21*L21^T
+		Eigen::Ref<Eigen::MatrixXd> F11 = F.topLeftCorner(k,k);
+		Eigen::LLT<Eigen::Ref<Eigen::MatrixXd> > LLT(F11);
+		if (LLT.info() != Eigen::Success)
+		{
+			mFailed = true;
+			return;
+		}
+		if (m > k)
+		{
+			auto F21 = F.bottomLeftCorner(m - k, k);
+			F11.triangularView<Eigen::Lower>().transpose().solveInPlace<Eigen::OnTheRight>(F21);
+			mUpdates[s] = F.bottomRightCorner(m - k, m - k);
+			mUpdates[s].selfadjointView<Eigen::Lower>().rankUpdate(F21, -1.0);
+		}
+		mBlocks[s] = F.leftCols(k);
+	} // factorSupernode()
+
+	supernodal_cholesky& supernodal_cholesky::factorize(const Eigen::SparseMatrix<double>& mat)
+	{
+		if (!mIsAnalyzed || mat.rows() != mSize || mat.cols() != mSize)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, cannot factorize a matrix with " << mat.rows() << " rows with a\n"
+									 << "supernodal Cholesky factorisation that analyzed " << mSize << " rows.\n"
+									 << "(bso/structural_design/supernodal_cholesky.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		Eigen::SparseMatrix<double> C(mSize, mSize);
+		C.selfadjointView<Eigen::Lower>() = mat.selfadjointView<Eigen::Lower>().twistedBy(mP);
+
+		const long supernodeCount = mSupernodeRows.size();
+		mBlocks.assign(supernodeCount, Eigen::MatrixXd());
+		mUpdates.assign(supernodeCount, Eigen::MatrixXd());
+		mFailed = false;
+
+		unsigned int threads = (mThreads == 0)? std::thread::hardware_concurrency() : mThreads;
+		if (threads <= 1 || supernodeCount < 2)
+		{ // children precede their parents
+			for (long s = 0; s < supernodeCount; ++s) this->factorSupernode(s, C);
+		}
+		else
+		{ // subtrees with less work than the threshold are factored by a single task. A task then
+			// continues with the ancestors of its subtree for which it factored the last child
+			double totalWork = 0;
+			for (long s = 0; s < supernodeCount; ++s)
+			{
+				if (mSupernodeParents[s] == -1) totalWork += mSubtreeWork[s];
+			}
+			const double threshold = totalWork / (4.0 * threads);
+			std::unique_ptr<std::atomic<long>[]> pendingChildren(new std::atomic<long>[supernodeCount]);
+			std::vector<std::vector<long> > tasks;
+			for (long s = 0; s < supernodeCount; ++s)
+			{
+				pendingChildren[s] = mSupernodeChildren[s].size();
+				const long& p = mSupernodeParents[s];
+				bool isSubtree = mSubtreeWork[s] <= threshold && (p == -1 || mSubtreeWork[p] > threshold);
+				if (!isSubtree && !(mSubtreeWork[s] > threshold && mSupernodeChildren[s].empty())) continue;
+				std::vector<long> subtree, stack = {s};
+				while (!stack.empty())
+				{
+					long t = stack.back();
+					stack.pop_back();
+					subtree.push_back(t);
+					stack.insert(stack.end(), mSupernodeChildren[t].begin(), mSupernodeChildren[t].end());
+				}
+				std::sort(subtree.begin(), subtree.end());
+				tasks.push_back(subtree);
+			}
+
+			bso::utilities::thread_pool pool(threads);
+			std::vector<std::future<void> > results;
+			for (const auto& i : tasks)
+			{
+				results.push_back(pool.submit([this, &i, &C, &pendingChildren]()
+				{
+					for (const auto& s : i) this->factorSupernode(s, C);
+					long s = i.back();
+					while (mSupernodeParents[s] != -1 && --pendingChildren[mSupernodeParents[s]] == 0)
+					{
+						s = mSupernodeParents[s];
+						this->factorSupernode(s, C);
+					}
+				}));
+			}
+			for (auto& i : results) i.get();
+		}
+		mUpdates.clear();
+		mInfo = mFailed? Eigen::NumericalIssue : Eigen::Success;
+		return *this;
+	} // factorize()
+
+	supernodal_cholesky& supernodal_cholesky::compute(const Eigen::SparseMatrix<double>& mat)
+	{
+		if (!this->hasAnalyzedPattern(mat)) this->analyzePattern(mat);
+		return this->factorize(mat);
+	} // compute()
+
+	template <class RHS>
+	Eigen::MatrixXd supernodal_cholesky::solveLower(const Eigen::MatrixBase<RHS>& b) const
+	{
+		if (b.rows() != mSize)
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, cannot solve a system of " << mSize << " rows with\n"
+									 << "a right hand side of " << b.rows() << " rows.\n"
+									 << "(bso/structural_design/supernodal_cholesky.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		Eigen::MatrixXd x = mP * b;
+		Eigen::MatrixXd xs, xR;
+		const long supernodeCount = mBlocks.size();
+		for (long s = 0; s < supernodeCount; ++s)
+		{ // L*y = P*b
+			const long first = mSupernodeColumns[s], k = mSupernodeColumns[s+1] - first;
+			if (x.middleRows(first, k).isZero(0)) continue; // only the ancestors of the nonzero rows of b are reached
+			const std::vector<long>& rows = mSupernodeRows[s];
+			xs = x.middleRows(first, k);
+			mBlocks[s].topRows(k).triangularView<Eigen::Lower>().solveInPlace(xs);
+			x.middleRows(first, k) = xs;
+			if ((long)rows.size() == k) continue;
+			xR.noalias() = mBlocks[s].bottomRows(rows.size() - k) * xs;
+			for (unsigned long i = k; i < rows.size(); ++i) x.row(rows[i]) -= xR.row(i - k);
+		}
+		return x;
+	} // solveLower()
+
+	template <class RHS>
+	Eigen::MatrixXd supernodal_cholesky::solve(const Eigen::MatrixBase<RHS>& b) const
+	{
+		Eigen::MatrixXd x = this->solveLower(b);
+		Eigen::MatrixXd xs, xR;
+		for (long s = mBlocks.size() - 1; s >= 0; --s)
+		{ // L^T*z = y
+			const long first = mSupernodeColumns[s], k = mSupernodeColumns[s+1] - first;
+			const std::vector<long>& rows = mSupernodeRows[s];
+			xs = x.middleRows(first, k);
+			if ((long)rows.size() > k)
+			{
+				xR.resize(rows.size() - k, x.cols());
+				for (unsigned long i = k; i < rows.size(); ++i) xR.row(i - k) = x.row(rows[i]);
+				xs.noalias() -= mBlocks[s].bottomRows(rows.size() - k).transpose() * xR;
+			}
+			mBlocks[s].topRows(k).triangularView<Eigen::Lower>().transpose().solveInPlace(xs);
+			x.middleRows(first, k) = xs;
+		}
+		return mPinv * x;
+	} // solve()
+
+	unsigned long supernodal_cholesky::nonZeros() const
+	{
+		unsigned long nonZeros = 0;
+		for (unsigned long s = 0; s < mSupernodeRows.size(); ++s)
+		{
+			const unsigned long k = mSupernodeColumns[s+1] - mSupernodeColumns[s];
+			nonZeros += k*mSupernodeRows[s].size() - (k*(k-1))/2;
+		}
+		return nonZeros;
+	} // nonZeros()
+
+} // namespace structural_design
+} // namespace bso
+
+#endif // SD_SUPERNODAL_CHOLESKY_CPP
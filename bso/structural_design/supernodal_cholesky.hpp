@@ -0,0 +1,70 @@
+#ifndef SD_SUPERNODAL_CHOLESKY_HPP
+#define SD_SUPERNODAL_CHOLESKY_HPP
+
+#include <bso/utilities/thread_pool.hpp>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Eigen/OrderingMethods>
+
+#include <atomic>
+#include <vector>
+
+namespace bso { namespace structural_design {
+
+	class supernodal_cholesky
+	{ // multifrontal Cholesky factorisation P*A*P^T = L*L^T of a sparse symmetric positive definite matrix,
+		// of which both triangles are stored. The columns are ordered by AMD, and consecutive columns with
+		// the same structure in L are grouped into supernodes. The front of each supernode is factored with
+		// dense blocked kernels (LLT, triangular solve and rank update), and independent subtrees of the
+		// supernodal elimination tree are factored in parallel. The symbolic analysis is reused as long as
+		// the sparsity pattern does not change
+	private:
+		typedef Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> permutation;
+		permutation mP, mPinv;
+		Eigen::Index mSize = 0;
+		std::vector<int> mOuterPattern, mInnerPattern; // of the analyzed matrix
+
+		std::vector<long> mSupernodeColumns; // the first column of each supernode, the column count as last entry
+		std::vector<std::vector<long> > mSupernodeRows; // the rows of each supernode's columns in L, starting with its own columns
+		std::vector<long> mSupernodeParents; // -1 for the roots of the tree
+		std::vector<std::vector<long> > mSupernodeChildren;
+		std::vector<double> mSubtreeWork; // estimated flops of the subtree of each supernode
+
+		std::vector<Eigen::MatrixXd> mBlocks; // the dense columns of L of each supernode
+		std::vector<Eigen::MatrixXd> mUpdates; // the update matrix of each supernode, until its parent has been assembled
+		std::atomic<bool> mFailed;
+		unsigned int mThreads = 0;
+		Eigen::ComputationInfo mInfo = Eigen::Success;
+		bool mIsAnalyzed = false;
+
+		bool hasAnalyzedPattern(const Eigen::SparseMatrix<double>& mat) const;
+		void factorSupernode(const long& s, const Eigen::SparseMatrix<double>& C);
+	public:
+		supernodal_cholesky();
+		explicit supernodal_cholesky(const Eigen::SparseMatrix<double>& mat);
+
+		void setThreads(const unsigned int& threads); // 0 is one per hardware thread
+
+		supernodal_cholesky& analyzePattern(const Eigen::SparseMatrix<double>& mat);
+		supernodal_cholesky& factorize(const Eigen::SparseMatrix<double>& mat);
+		supernodal_cholesky& compute(const Eigen::SparseMatrix<double>& mat); // analyzes the pattern only if it changed
+
+		template <class RHS>
+		Eigen::MatrixXd solve(const Eigen::MatrixBase<RHS>& b) const;
+		template <class RHS>
+		Eigen::MatrixXd solveLower(const Eigen::MatrixBase<RHS>& b) const; // L^-1*P*b, cheap if b has few nonzero rows
+
+		Eigen::ComputationInfo info() const {return mInfo;}
+		Eigen::Index rows() const {return mSize;}
+		Eigen::Index cols() const {return mSize;}
+		unsigned long supernodes() const {return mSupernodeRows.size();}
+		unsigned long nonZeros() const; // of L
+	};
+
+} // namespace structural_design
+} // namespace bso
+
+#include <bso/structural_design/supernodal_cholesky.cpp>
+
+#endif // SD_SUPERNODAL_CHOLESKY_HPP
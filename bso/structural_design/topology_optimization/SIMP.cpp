@@ -69,12 +69,13 @@ void sd_model::topologyOptimization<topology_optimization::SIMP>(const double& f
 	double change = 1;
 	int loop = 0;
 
-	double loopStart = clock(), iterationStart, timeEnd = 0.0;
+	double loopStart = bso::utilities::wall_time(), iterationStart, timeEnd = 0.0;
 
 	// start iteration
-	while (change > tolerance)
+	while (change > tolerance &&
+		(mTopOptMaxIterations == 0 || loop < (int)mTopOptMaxIterations))
 	{
-			iterationStart = clock();
+			iterationStart = bso::utilities::wall_time();
 			if (loop%20 == 0)
 			{
 					out << std::endl
@@ -90,7 +91,7 @@ void sd_model::topologyOptimization<topology_optimization::SIMP>(const double& f
 
 			// FEA
 			mFEA->generateGSM();
-			mFEA->solve("SimplicialLDLT");
+			mFEA->solve(mTopOptSolver);
 
 			// objective function and sensitivity analysis (retrieve data from FEA)
 			eleIndexI = 0;
@@ -146,17 +147,17 @@ void sd_model::topologyOptimization<topology_optimization::SIMP>(const double& f
 			xChange = xNew - x;
 			change = xChange.cwiseAbs().maxCoeff();
 
-			timeEnd = clock();
+			timeEnd = bso::utilities::wall_time();
 			out << std::setw(5)  << std::left << loop
 					<< std::setw(15) << std::left << c
 					<< std::setw(15) << std::left << (volume * xNew.transpose()).trace()
 					<< std::setw(15) << std::left << change
-					<< std::setw(10) << std::left << (timeEnd - iterationStart)/CLOCKS_PER_SEC << std::endl;
+					<< std::setw(10) << std::left << (timeEnd - iterationStart) << std::endl;
 
 			x = xNew;
 	} // end of iteration
 	out << "Topology optimisation successfully finished after: "
-			<< (timeEnd - loopStart)/CLOCKS_PER_SEC << " seconds."
+			<< (timeEnd - loopStart) << " seconds."
 			<< std::endl << std::endl;
 }
 	
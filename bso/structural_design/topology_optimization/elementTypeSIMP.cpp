@@ -82,12 +82,13 @@ void sd_model::topologyOptimization<topology_optimization::ELE_SIMP>(const doubl
 	double change = 1;
 	int loop = 0;
 
-	double loopStart = clock(), iterationStart, timeEnd = 0.0;
+	double loopStart = bso::utilities::wall_time(), iterationStart, timeEnd = 0.0;
 
 	// start iteration
-	while (change > tolerance)
+	while (change > tolerance &&
+		(mTopOptMaxIterations == 0 || loop < (int)mTopOptMaxIterations))
 	{
-			iterationStart = clock();
+			iterationStart = bso::utilities::wall_time();
 			if (loop%20 == 0)
 			{
 					out << std::endl
@@ -103,7 +104,7 @@ void sd_model::topologyOptimization<topology_optimization::ELE_SIMP>(const doubl
 
 			// FEA
 			mFEA->generateGSM();
-			mFEA->solve("SimplicialLDLT");
+			mFEA->solve(mTopOptSolver);
 
 			double volume = 0;
 			if (fEle.size() > 0)
@@ -170,19 +171,19 @@ void sd_model::topologyOptimization<topology_optimization::ELE_SIMP>(const doubl
 				change = std::max(change, xChangeT.cwiseAbs().maxCoeff());
 			}
 
-			timeEnd = clock();
+			timeEnd = bso::utilities::wall_time();
 			out << std::setw(5)  << std::left << loop
 					<< std::setw(15) << std::left << cF + cB + cT
 					<< std::setw(15) << std::left << volume
 					<< std::setw(15) << std::left << change
-					<< std::setw(10) << std::left << (timeEnd - iterationStart)/CLOCKS_PER_SEC << std::endl;
+					<< std::setw(10) << std::left << (timeEnd - iterationStart) << std::endl;
 
 			xF = xNewF;
 			xB = xNewB;
 			xT = xNewT;
 	} // end of iteration
 	out << "Topology optimisation successfully finished after: "
-			<< (timeEnd - loopStart)/CLOCKS_PER_SEC << " seconds."
+			<< (timeEnd - loopStart) << " seconds."
 			<< std::endl << std::endl;
 }
 
@@ -92,7 +92,7 @@ void sd_model::topologyOptimization<topology_optimization::ROBUST>(const double&
 	int loop = 0;
 	int loopBeta = 0;
 
-	double loopStart = clock(), iterationStart, timeEnd = 0.0;
+	double loopStart = bso::utilities::wall_time(), iterationStart, timeEnd = 0.0;
 	out << std::endl
 			<< std::setw(5)  << std::left << "loop"
 			<< std::setw(10) << std::left << "loop_beta"
@@ -103,9 +103,10 @@ void sd_model::topologyOptimization<topology_optimization::ROBUST>(const double&
 			<< std::setw(10)  << std::left << "Time" << std::endl;
 
 	// start iteration
-	while (change > tolerance)
+	while (change > tolerance &&
+		(mTopOptMaxIterations == 0 || loop < (int)mTopOptMaxIterations))
 	{
-			iterationStart = clock();
+			iterationStart = bso::utilities::wall_time();
 
 			++loop;
 			++loopBeta;
@@ -113,7 +114,7 @@ void sd_model::topologyOptimization<topology_optimization::ROBUST>(const double&
 
 			// FEA
 			mFEA->generateGSM();
-			mFEA->solve("SimplicialLDLT");
+			mFEA->solve(mTopOptSolver);
 
 			// objective function and sensitivity analysis (retrieve data from FEA)
 			eleIndexI = 0;
@@ -196,14 +197,14 @@ void sd_model::topologyOptimization<topology_optimization::ROBUST>(const double&
 			}
 			Mnd *= ((1.0/(f*(1.0-f)))*(100.0/numEle));
 
-			timeEnd = clock();
+			timeEnd = bso::utilities::wall_time();
 			out << std::setw(5)  << std::left << loop
 					<< std::setw(10) << std::left << loopBeta
 					<< std::setw(15) << std::left << c
 					<< std::setw(15) << std::left << (volume * xNew.transpose()).trace()
 					<< std::setw(10) << std::left << change
 					<< std::setw(10) << std::left << Mnd
-					<< std::setw(10) << std::left << (timeEnd - iterationStart)/CLOCKS_PER_SEC << std::endl;
+					<< std::setw(10) << std::left << (timeEnd - iterationStart) << std::endl;
 			// update beta
 			if ((beta < 256) && ((loopBeta >= 50) || (beta < 256 && change <= tolerance)))
 			{
@@ -222,7 +223,7 @@ void sd_model::topologyOptimization<topology_optimization::ROBUST>(const double&
 			}
 	} // end of iteration
 	out << "Topology optimisation successfully finished after: "
-			<< (timeEnd - loopStart)/CLOCKS_PER_SEC << " seconds."
+			<< (timeEnd - loopStart) << " seconds."
 			<< std::endl << std::endl;
 	
 	eleIndexI = 0;
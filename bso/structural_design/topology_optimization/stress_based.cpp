@@ -79,7 +79,7 @@ void sd_model::topologyOptimization<topology_optimization::STRESS_BASED>(
 	double change = 1.0;
 	double changevol = 1.0;
 	int loop = 0;
-	double loopStart = clock(), iterationStart, startMMA, endMMA, timeEnd = 0.0;
+	double loopStart = bso::utilities::wall_time(), iterationStart, startMMA, endMMA, timeEnd = 0.0;
 
 	// define MMA parameters
 	const int n = numEle;	// nr of variables
@@ -98,9 +98,10 @@ void sd_model::topologyOptimization<topology_optimization::STRESS_BASED>(
 	dmma.setZero();
 
 	// start iteration
-	while (changevol > tolerance || s.maxCoeff() > 1e-5)
+	while ((changevol > tolerance || s.maxCoeff() > 1e-5) &&
+		(mTopOptMaxIterations == 0 || loop < (int)mTopOptMaxIterations))
 	{
-			iterationStart = clock();
+			iterationStart = bso::utilities::wall_time();
 			if (loop%20 == 0)
 			{
 					out << std::endl
@@ -177,7 +178,7 @@ void sd_model::topologyOptimization<topology_optimization::STRESS_BASED>(
 			dv = H * dv;
 
 			// update of design variables and physical densities (MMA solver)
-			startMMA = clock();
+			startMMA = bso::utilities::wall_time();
 			topology_optimization::MMA MMA;
 			MMA.MMAsub(m,n,loop,x,xmin,xmax,xold1,xold2,volfrac,dv,s,ds,low,upp,a0,amma,cmma,dmma,move);
 			low = MMA.getLow();
@@ -185,7 +186,7 @@ void sd_model::topologyOptimization<topology_optimization::STRESS_BASED>(
 			xNew = MMA.getxNew();
 			xold2 = xold1;
 			xold1 = x;
-			endMMA = clock();
+			endMMA = bso::utilities::wall_time();
 
 			// density filter
 			xPhys = H * xNew;
@@ -201,20 +202,20 @@ void sd_model::topologyOptimization<topology_optimization::STRESS_BASED>(
 				++eleIndexI;
 			}
 
-			timeEnd = clock();
+			timeEnd = bso::utilities::wall_time();
 			out << std::setw(5)  << std::left << loop
 					<< std::setw(13) << std::left << 2*c
 					<< std::setw(13) << std::left << volfrac
 					<< std::setw(13) << std::left << changevol
 					<< std::setw(13) << std::left << s.maxCoeff()
-					<< std::setw(10) << std::left << (endMMA - startMMA)/CLOCKS_PER_SEC
-					<< std::setw(10) << std::left << (timeEnd - iterationStart)/CLOCKS_PER_SEC << std::endl;
+					<< std::setw(10) << std::left << (endMMA - startMMA)
+					<< std::setw(10) << std::left << (timeEnd - iterationStart) << std::endl;
 
 			x = xNew;
 
 	} // end of iteration
 	out << "Topology optimisation successfully finished after: "
-			<< (timeEnd - loopStart)/CLOCKS_PER_SEC << " seconds."
+			<< (timeEnd - loopStart) << " seconds."
 			<< std::endl << std::endl;
 } // topology_optimization::STRESS_BASED
 
@@ -3,6 +3,8 @@
 
 #include <iomanip>
 
+#include <bso/utilities/instrumentation.hpp>
+
 #include <bso/structural_design/topology_optimization/SIMP.cpp>
 #include <bso/structural_design/topology_optimization/robust.cpp>
 #include <bso/structural_design/topology_optimization/stress_based.cpp>
@@ -3,6 +3,9 @@
 
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 
@@ -10,48 +13,63 @@ namespace bso { namespace utilities {
 
 void clustering::mMakeClustering()
 {
-	// cluster for different values of k
-	std::map<unsigned int, std::vector<cluster>> clusterings;
-	std::map<unsigned int, double> variances; 
-	for (unsigned int i = mKMin-1; i <= mKMax+1; ++i)
+	// cluster for different values of k, each run of k-means is a separate task with its own
+	// random number stream derived from the seed, so that the result does not depend on the
+	// number of threads or on the order in which the tasks finish
+	unsigned int kFirst = mKMin-1, kLast = mKMax+1;
+	std::vector<k_means_result> bestResults(kLast - kFirst + 1);
+	std::vector<unsigned int> bestRuns(bestResults.size(), mRuns);
+	std::vector<unsigned int> successfulKMeansRuns(bestResults.size(), 0);
+	std::mutex resultMutex;
+	auto kMeansTask = [&](const unsigned int& k, const unsigned int& run)
 	{
-		std::vector<cluster> clustering;
-		double variance;
-		unsigned int successfulKMeansRuns = 0;
-		for (unsigned int j = 0; j < mRuns; ++j)
+		std::seed_seq seeds{(std::uint32_t)mRNGSeed, (std::uint32_t)k, (std::uint32_t)run};
+		std::mt19937 rng(seeds);
+		k_means_result result;
+		try
 		{
-			bool success = true;
-			std::vector<cluster> newClustering;
-			try
-			{
-				newClustering = this->mKMeans(i);
-			}
-			catch(std::exception& e)
-			{
-				success = false;
-			}
-			if (success) ++successfulKMeansRuns;
-			else continue;
-				
-			double averageVariance = 0;
-			for (const auto& k : newClustering)
-			{
-				averageVariance += k.calculateVariance();
-			}
-			averageVariance /= newClustering.size();
-			
-			if (j == 0)
-			{
-				clustering = newClustering;
-				variance = averageVariance;
-			}
-			else if (variance > averageVariance)
+			result = this->mKMeans(k, rng);
+		}
+		catch(std::exception& e)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(resultMutex);
+		unsigned int index = k - kFirst;
+		++successfulKMeansRuns[index];
+		if (bestRuns[index] == mRuns ||
+				result.mAverageVariance < bestResults[index].mAverageVariance ||
+				(result.mAverageVariance == bestResults[index].mAverageVariance && run < bestRuns[index]))
+		{ // on equal variances the first run is kept, as when the runs are carried out in order
+			bestResults[index] = std::move(result);
+			bestRuns[index] = run;
+		}
+	};
+	if (mThreads == 1)
+	{
+		for (unsigned int i = kFirst; i <= kLast; ++i)
+		{
+			for (unsigned int j = 0; j < mRuns; ++j) kMeansTask(i, j);
+		}
+	}
+	else
+	{
+		thread_pool pool(mThreads);
+		std::vector<std::future<void> > tasks;
+		for (unsigned int i = kFirst; i <= kLast; ++i)
+		{
+			for (unsigned int j = 0; j < mRuns; ++j)
 			{
-				clustering = newClustering;
-				variance = averageVariance;
+				tasks.push_back(pool.submit([&kMeansTask, i, j](){kMeansTask(i, j);}));
 			}
 		}
-		if (!(successfulKMeansRuns > 0))
+		for (auto& i : tasks) i.get();
+	}
+
+	std::map<unsigned int, double> variances;
+	for (unsigned int i = kFirst; i <= kLast; ++i)
+	{
+		if (!(successfulKMeansRuns[i - kFirst] > 0))
 		{
 			unsigned int oldKMax = mKMax;
 			mKMax = i - 2;
@@ -66,8 +84,7 @@ void clustering::mMakeClustering()
 			std::cerr << "Warning, reduced Kmax from " << oldKMax << " to " << mKMax
 								<< " while clustering.\n(bso/utilities/clustering.cpp)" << std::endl;
 		}
-		clusterings[i] = clustering;
-		variances[i] = variance;
+		variances[i] = bestResults[i - kFirst].mAverageVariance;
 	}
 	
 	// find the best value for k, according to:
@@ -97,7 +114,15 @@ void clustering::mMakeClustering()
 		}
 	}
 	
-	mClusters = clusterings[bestK];
+	const k_means_result& best = bestResults[bestK - kFirst];
+	for (unsigned int i = 0; i < bestK; ++i)
+	{
+		mClusters.push_back(cluster(data_point(Eigen::VectorXd(best.mCentroids.row(i).transpose()))));
+	}
+	for (unsigned int i = 0; i < mData.size(); ++i)
+	{
+		mClusters[best.mAssignments[i]].addDataPoint(mData[i]);
+	}
 	
 	/*
 	std::map<unsigned int, double> varianceSecondDerivatives;
@@ -119,73 +144,157 @@ void clustering::mMakeClustering()
 	
 } // mMakeClustering()
 
-std::vector<cluster> clustering::mKMeans(const unsigned int& kSize)
-{
-	std::vector<cluster> clustering;
-	std::vector<data_point> centroids;
+clustering::k_means_result clustering::mKMeans(const unsigned int& kSize,
+	std::mt19937& rng) const
+{ // k-means++ seeding: D. Arthur and S. Vassilvitskii (2007) k-means++: The Advantages of
+	// Careful Seeding, followed by Lloyd iterations in which distance computations are skipped
+	// with the bounds of: G. Hamerly (2010) Making k-means even faster
+	const long n = mMatrix.rows();
+	k_means_result result;
+	data_matrix& centroids = result.mCentroids;
+	centroids.resize(kSize, mMatrix.cols());
 
-	std::vector<unsigned int> dataIndices(mData.size());
-	for (unsigned int i = 0; i < mData.size(); ++i) dataIndices[i] = i;
-	std::shuffle(dataIndices.begin(), dataIndices.end(), mRNGEngine);
-	
-	unsigned int centroidCount = 0;
-	for (const auto& i : dataIndices)
+	Eigen::VectorXd minSquaredDistance = Eigen::VectorXd::Constant(n,
+		std::numeric_limits<double>::infinity());
+	long chosen = std::uniform_int_distribution<long>(0, n-1)(rng);
+	for (unsigned int j = 0; j < kSize; ++j)
 	{
-		if (std::find(centroids.begin(),centroids.end(),*(mData[i])) == centroids.end())
+		if (j > 0)
+		{ // choose the next centroid with a probability proportional to the squared distance
+			// to the nearest centroid, so data points equal to a centroid are never chosen
+			double total = minSquaredDistance.sum();
+			if (!(total > 0))
+			{
+				std::stringstream errorMessage;
+				errorMessage << "\nError, trying to cluster a set of data into " << kSize
+										 << "\nclusters, but data contains only: " << j
+										 << "uniques data points."
+										 << "(bso/utilities/clustering.cpp)" << std::endl;
+				throw std::invalid_argument(errorMessage.str());
+			}
+			double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+			chosen = -1;
+			for (long i = 0; i < n; ++i)
+			{
+				if (minSquaredDistance(i) <= 0) continue;
+				chosen = i;
+				r -= minSquaredDistance(i);
+				if (r < 0) break;
+			}
+		}
+		centroids.row(j) = mMatrix.row(chosen);
+		for (long i = 0; i < n; ++i)
 		{
-			centroids.push_back(*(mData[i]));
-			++centroidCount;
+			minSquaredDistance(i) = std::min(minSquaredDistance(i),
+				(mMatrix.row(i) - centroids.row(j)).squaredNorm());
 		}
-		if (centroidCount == kSize) break;
-	}
-	if (centroidCount != kSize)
-	{
-		std::stringstream errorMessage;
-		errorMessage << "\nError, trying to cluster a set of data into " << kSize
-								 << "\nclusters, but data contains only: " << centroidCount
-								 << "uniques data points."
-								 << "(bso/utilities/clustering.cpp)" << std::endl;
-		throw std::invalid_argument(errorMessage.str());
 	}
-	
-	bool converged;
-	do
+
+	// upper bound of the distance to the assigned centroid, and lower bound of the distance
+	// to any other centroid of each data point
+	std::vector<unsigned int>& assignments = result.mAssignments;
+	assignments.resize(n);
+	Eigen::VectorXd upper(n), lower(n);
+	auto assignToNearest = [&](const long& i)
+	{ // on equal distances the centroid with the lowest index is chosen
+		double d1 = std::numeric_limits<double>::infinity(), d2 = d1;
+		unsigned int nearest = 0;
+		for (unsigned int j = 0; j < kSize; ++j)
+		{
+			double d = (mMatrix.row(i) - centroids.row(j)).squaredNorm();
+			if (d < d1)
+			{
+				d2 = d1;
+				d1 = d;
+				nearest = j;
+			}
+			else if (d < d2) d2 = d;
+		}
+		upper(i) = std::sqrt(d1);
+		lower(i) = std::sqrt(d2);
+		bool changed = (assignments[i] != nearest);
+		assignments[i] = nearest;
+		return changed;
+	};
+	for (long i = 0; i < n; ++i) assignToNearest(i);
+
+	data_matrix means(kSize, mMatrix.cols());
+	std::vector<unsigned long> counts(kSize);
+	Eigen::VectorXd movement(kSize), halfSeparation(kSize);
+	bool converged = false;
+	while (true)
 	{
-		converged = true;
-		clustering.clear();
-		for (const auto& i : centroids)
+		means.setZero();
+		std::fill(counts.begin(), counts.end(), 0);
+		for (long i = 0; i < n; ++i)
 		{
-			clustering.push_back(cluster(i));
+			means.row(assignments[i]) += mMatrix.row(i);
+			++counts[assignments[i]];
 		}
-		
-		for (const auto& i : mData)
+		for (unsigned int j = 0; j < kSize; ++j)
 		{
-			double minDistance = i->calcDistanceTo(centroids[0]);
-			unsigned int closestCentroidIndex = 0;
-			for (unsigned int j = 1; j < kSize; ++j)
+			if (counts[j] == 0)
 			{
-				double distance = i->calcDistanceTo(centroids[j]);
-				if (minDistance > distance)
-				{
-					minDistance = distance;
-					closestCentroidIndex = j;
-				}
+				std::stringstream errorMessage;
+				errorMessage << "\nError, k means algorithm resulted in an empty cluster.\n"
+										 << "(bso/utilities/clustering.cpp)" << std::endl;
+				throw std::runtime_error(errorMessage.str());
 			}
-			clustering[closestCentroidIndex].addDataPoint(i);
+			means.row(j) /= counts[j];
+			movement(j) = (means.row(j) - centroids.row(j)).norm();
 		}
+		centroids = means;
+		if (converged) break; // the centroids are the means of the final assignment
 
-		for (unsigned int i = 0; i < kSize; ++i)
+		unsigned int mostMoved = 0;
+		double secondMovement = 0;
+		for (unsigned int j = 1; j < kSize; ++j)
 		{
-			data_point newCentroid = clustering[i].calculateMean();
-			if (newCentroid != clustering[i].getCentroid())
+			if (movement(j) > movement(mostMoved))
 			{
-				converged = false;
-				centroids[i] = newCentroid;
+				secondMovement = movement(mostMoved);
+				mostMoved = j;
 			}
+			else if (movement(j) > secondMovement) secondMovement = movement(j);
 		}
-	} while(!converged);
+		for (unsigned int j = 0; j < kSize; ++j)
+		{
+			halfSeparation(j) = std::numeric_limits<double>::infinity();
+			for (unsigned int l = 0; l < kSize; ++l)
+			{
+				if (l == j) continue;
+				halfSeparation(j) = std::min(halfSeparation(j),
+					0.5*(centroids.row(j) - centroids.row(l)).norm());
+			}
+		}
+
+		converged = true;
+		for (long i = 0; i < n; ++i)
+		{
+			unsigned int a = assignments[i];
+			upper(i) += movement(a);
+			lower(i) -= (a == mostMoved)? secondMovement : movement(mostMoved);
+			double bound = std::max(halfSeparation(a), lower(i));
+			if (upper(i) <= bound) continue;
+			upper(i) = (mMatrix.row(i) - centroids.row(a)).norm();
+			if (upper(i) <= bound) continue;
+			if (assignToNearest(i)) converged = false;
+		}
+	}
+
+	result.mAverageVariance = 0;
+	Eigen::VectorXd clusterVariances = Eigen::VectorXd::Zero(kSize);
+	for (long i = 0; i < n; ++i)
+	{
+		clusterVariances(assignments[i]) += (mMatrix.row(i) - centroids.row(assignments[i])).squaredNorm();
+	}
+	for (unsigned int j = 0; j < kSize; ++j)
+	{
+		result.mAverageVariance += clusterVariances(j) / counts[j];
+	}
+	result.mAverageVariance /= kSize;
 
-	return clustering;
+	return result;
 } // mKMeans()
 
 void clustering::mInitialize(const std::vector<data_point>& data)
@@ -220,10 +329,17 @@ void clustering::mInitialize(const std::vector<data_point>& data)
 		throw std::invalid_argument(errorMessage.str());
 	}
 	
-	mRNGEngine.seed(mRNGSeed);
-	for (const auto& i : data)
+	mMatrix.resize(data.size(), data.front().size());
+	for (unsigned int i = 0; i < data.size(); ++i)
 	{
-		mData.push_back(std::make_shared<data_point>(i));
+		if (data[i].size() != mMatrix.cols())
+		{
+			errorMessage << "data points should all have the same dimensions\n"
+									 << "(bso/utilities/clustering.hpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		for (unsigned int j = 0; j < mMatrix.cols(); ++j) mMatrix(i,j) = data[i](j);
+		mData.push_back(std::make_shared<data_point>(data[i]));
 	}
 
 	this->mMakeClustering();
@@ -231,17 +347,18 @@ void clustering::mInitialize(const std::vector<data_point>& data)
 
 clustering::clustering(const std::vector<data_point>& data,
 	const unsigned int& kMin /*= 2*/,	const unsigned int& kMax /*= 10*/,
-	const unsigned int& runs /*= 50*/)
+	const unsigned int& runs /*= 50*/, const unsigned int& threads /*= 0*/)
 : mRNGSeed(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
-	mKMin(kMin), mKMax(kMax), mRuns(runs)
+	mKMin(kMin), mKMax(kMax), mRuns(runs), mThreads(threads)
 {
 	this->mInitialize(data);
 } // ctor()
 
 clustering::clustering( const unsigned long& RNGSeed, 
 	const std::vector<data_point>& data, const unsigned int& kMin /*= 2*/,
-	const unsigned int& kMax /*= 10*/, const unsigned int& runs /*= 50*/)
-: mRNGSeed(RNGSeed), mKMin(kMin), mKMax(kMax), mRuns(runs)
+	const unsigned int& kMax /*= 10*/, const unsigned int& runs /*= 50*/,
+	const unsigned int& threads /*= 0*/)
+: mRNGSeed(RNGSeed), mKMin(kMin), mKMax(kMax), mRuns(runs), mThreads(threads)
 {
 	this->mInitialize(data);
 } // ctor()
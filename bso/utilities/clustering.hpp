@@ -3,6 +3,7 @@
 
 #include <bso/utilities/data_point.hpp>
 #include <bso/utilities/cluster.hpp>
+#include <bso/utilities/thread_pool.hpp>
 #include <vector>
 #include <random>
 
@@ -10,24 +11,35 @@ namespace bso { namespace utilities {
 	
 class clustering
 {
+public:
+	typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> data_matrix;
 private:
-	std::vector<std::shared_ptr<data_point> > mData;
+	struct k_means_result
+	{
+		std::vector<unsigned int> mAssignments; // index of the cluster of each data point
+		data_matrix mCentroids;
+		double mAverageVariance;
+	};
+
+	data_matrix mMatrix; // one row per data point
+	std::vector<std::shared_ptr<data_point> > mData; // the data points referred to by the clusters
 	std::vector<cluster> mClusters;
-	mutable std::mt19937 mRNGEngine;
 	unsigned long mRNGSeed;
 	unsigned int mKMin;
 	unsigned int mKMax;
 	unsigned int mRuns;
+	unsigned int mThreads;
 	
 	void mMakeClustering();
-	std::vector<cluster> mKMeans(const unsigned int& k);
+	k_means_result mKMeans(const unsigned int& k, std::mt19937& rng) const;
 	void mInitialize(const std::vector<data_point>& data);
 public:
 	clustering(const std::vector<data_point>& data, const unsigned int& kMin = 2,
-		const unsigned int& kMax = 10, const unsigned int& runs = 50);
+		const unsigned int& kMax = 10, const unsigned int& runs = 50,
+		const unsigned int& threads = 0);
 	clustering(const unsigned long& RNGSeed, const std::vector<data_point>& data,
 		const unsigned int& kMin = 2, const unsigned int& kMax = 10,
-		const unsigned int& runs = 50);
+		const unsigned int& runs = 50, const unsigned int& threads = 0); // 0 threads is one per hardware thread
 	~clustering();
 	
 	const std::vector<cluster>& getClusters() const {return mClusters;}
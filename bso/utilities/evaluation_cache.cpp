@@ -0,0 +1,233 @@
+#ifndef BSO_EVALUATION_CACHE_CPP
+#define BSO_EVALUATION_CACHE_CPP
+
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <iterator>
+
+namespace bso { namespace utilities {
+
+fingerprint fingerprint_files(const std::vector<std::string>& fileNames)
+{ // hashes the contents of e.g. settings files
+	fingerprint f;
+	for (const auto& i : fileNames)
+	{
+		std::ifstream input(i.c_str(), std::ios::binary);
+		if (!input.is_open())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nCould not open the following file to compute its fingerprint:\n"
+									 << i << "\n(bso/utilities/evaluation_cache.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+		f.combine(content);
+	}
+	return f;
+} // fingerprint_files()
+
+template <class RESULTS>
+evaluation_cache<RESULTS>::evaluation_cache(const std::size_t& capacity /*= 10000*/,
+	const std::string& storeFileName /*= ""*/)
+:	mCapacity(capacity), mStoreFileName(storeFileName), mHits(0), mMisses(0)
+{
+	static_assert(std::is_trivially_copyable<RESULTS>::value,
+		"evaluation_cache can only store trivially copyable results");
+	if (mCapacity == 0)
+	{
+		std::stringstream errorMessage;
+		errorMessage << "\nCannot initialize an evaluation cache with a capacity of zero.\n"
+								 << "(bso/utilities/evaluation_cache.cpp)" << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+	if (!mStoreFileName.empty()) this->mReadStore();
+} // ctor()
+
+template <class RESULTS>
+evaluation_cache<RESULTS>::~evaluation_cache()
+{
+	
+} // dtor()
+
+namespace evaluation_cache_detail {
+	const uint64_t recordMarker = 0x62736f5f72656301ULL; // marks the start of each record in a store
+} // namespace evaluation_cache_detail
+
+template <class RESULTS>
+void evaluation_cache<RESULTS>::mReadStore()
+{ // the store holds a header with the size of the results, followed by records: marker, key, results
+	uint64_t resultsSize = sizeof(RESULTS);
+	const std::streamoff recordSize = 3*sizeof(uint64_t) + sizeof(RESULTS);
+	{ // create the store if it does not exist yet, and write its header
+		std::ifstream check(mStoreFileName.c_str(), std::ios::binary);
+		bool isNew = !check.is_open() || check.peek() == std::ifstream::traits_type::eof();
+		check.close();
+		if (isNew)
+		{
+			std::ofstream header(mStoreFileName.c_str(), std::ios::binary | std::ios::trunc);
+			header.write(reinterpret_cast<const char*>(&resultsSize), sizeof(resultsSize));
+		}
+	}
+	
+	mStoreIn.open(mStoreFileName.c_str(), std::ios::binary);
+	uint64_t storedSize = 0;
+	mStoreIn.read(reinterpret_cast<char*>(&storedSize), sizeof(storedSize));
+	if (!mStoreIn || storedSize != resultsSize)
+	{
+		std::stringstream errorMessage;
+		errorMessage << "\nCould not use the following file as evaluation store:\n"
+								 << mStoreFileName << "\nIt could not be read or it holds results of another type.\n"
+								 << "(bso/utilities/evaluation_cache.cpp)" << std::endl;
+		throw std::invalid_argument(errorMessage.str());
+	}
+	
+	// index all complete records
+	mStoreIn.seekg(0, std::ios::end);
+	std::streamoff fileSize = mStoreIn.tellg();
+	std::streamoff offset = sizeof(storedSize);
+	for (; offset + recordSize <= fileSize; offset += recordSize)
+	{
+		uint64_t record[3];
+		mStoreIn.seekg(offset);
+		mStoreIn.read(reinterpret_cast<char*>(record), sizeof(record));
+		if (record[0] != evaluation_cache_detail::recordMarker) continue;
+		mStoreIndex[fingerprint(record[1],record[2])] = offset + sizeof(record);
+	}
+	mStoreIn.clear();
+	
+	mStoreOut.open(mStoreFileName.c_str(), std::ios::binary | std::ios::app);
+	if (offset < fileSize)
+	{ // an interrupted write left a partial record, pad it so that new records stay aligned
+		std::vector<char> padding(offset + recordSize - fileSize, 0);
+		mStoreOut.write(padding.data(), padding.size());
+		mStoreOut.flush();
+	}
+} // mReadStore()
+
+template <class RESULTS>
+bool evaluation_cache<RESULTS>::mFind(const fingerprint& key, RESULTS& results)
+{
+	auto entry = mEntries.find(key);
+	if (entry != mEntries.end())
+	{ // move the entry to the front of the LRU list
+		mLRU.splice(mLRU.begin(), mLRU, entry->second);
+		results = entry->second->second;
+		return true;
+	}
+	
+	auto stored = mStoreIndex.find(key);
+	if (stored != mStoreIndex.end())
+	{
+		mStoreIn.seekg(stored->second);
+		if (mStoreIn.read(reinterpret_cast<char*>(&results), sizeof(RESULTS)))
+		{
+			mLRU.emplace_front(key, results);
+			mEntries[key] = mLRU.begin();
+			if (mLRU.size() > mCapacity)
+			{
+				mEntries.erase(mLRU.back().first);
+				mLRU.pop_back();
+			}
+			return true;
+		}
+		mStoreIn.clear();
+	}
+	return false;
+} // mFind()
+
+template <class RESULTS>
+void evaluation_cache<RESULTS>::mInsert(const fingerprint& key, const RESULTS& results)
+{
+	auto entry = mEntries.find(key);
+	if (entry != mEntries.end())
+	{
+		entry->second->second = results;
+		mLRU.splice(mLRU.begin(), mLRU, entry->second);
+	}
+	else
+	{
+		mLRU.emplace_front(key, results);
+		mEntries[key] = mLRU.begin();
+		if (mLRU.size() > mCapacity)
+		{
+			mEntries.erase(mLRU.back().first);
+			mLRU.pop_back();
+		}
+	}
+	
+	if (mStoreOut.is_open() && mStoreIndex.find(key) == mStoreIndex.end())
+	{ // append the record, and flush so that other processes can use it after they (re)open the store
+		uint64_t record[3] = {evaluation_cache_detail::recordMarker, key.getFirst(), key.getSecond()};
+		mStoreOut.seekp(0, std::ios::end);
+		std::streamoff offset = mStoreOut.tellp();
+		mStoreOut.write(reinterpret_cast<const char*>(record), sizeof(record));
+		mStoreOut.write(reinterpret_cast<const char*>(&results), sizeof(RESULTS));
+		mStoreOut.flush();
+		mStoreIndex[key] = offset + sizeof(record);
+	}
+} // mInsert()
+
+template <class RESULTS>
+bool evaluation_cache<RESULTS>::find(const fingerprint& key, RESULTS& results)
+{ // returns true and assigns results on a hit
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (this->mFind(key, results))
+	{
+		++mHits;
+		return true;
+	}
+	++mMisses;
+	return false;
+} // find()
+
+template <class RESULTS>
+void evaluation_cache<RESULTS>::insert(const fingerprint& key, const RESULTS& results)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	this->mInsert(key, results);
+} // insert()
+
+template <class RESULTS>
+template <class FUNCTION>
+RESULTS evaluation_cache<RESULTS>::evaluate(const fingerprint& key, FUNCTION evaluation)
+{ // returns the cached results, or evaluates and stores them
+	RESULTS results;
+	if (this->find(key, results)) return results;
+	results = evaluation(); // evaluated without holding the lock, so that other threads can proceed
+	this->insert(key, results);
+	return results;
+} // evaluate()
+
+template <class RESULTS>
+unsigned long evaluation_cache<RESULTS>::getHits() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mHits;
+} // getHits()
+
+template <class RESULTS>
+unsigned long evaluation_cache<RESULTS>::getMisses() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mMisses;
+} // getMisses()
+
+template <class RESULTS>
+std::size_t evaluation_cache<RESULTS>::size() const
+{ // number of entries held in memory
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mLRU.size();
+} // size()
+
+template <class RESULTS>
+std::size_t evaluation_cache<RESULTS>::storeSize() const
+{ // number of entries in the store
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mStoreIndex.size();
+} // storeSize()
+
+} // namespace utilities
+} // namespace bso
+
+#endif // BSO_EVALUATION_CACHE_CPP
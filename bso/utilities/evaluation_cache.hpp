@@ -0,0 +1,56 @@
+#ifndef BSO_EVALUATION_CACHE_HPP
+#define BSO_EVALUATION_CACHE_HPP
+
+#include <bso/utilities/fingerprint.hpp>
+#include <list>
+#include <unordered_map>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace bso { namespace utilities {
+
+fingerprint fingerprint_files(const std::vector<std::string>& fileNames); // hashes the contents of e.g. settings files
+
+template <class RESULTS>
+class evaluation_cache
+{ // thread-safe LRU cache of evaluation results, optionally backed by an append-only file
+private:
+	typedef std::list<std::pair<fingerprint, RESULTS> > lru_list;
+	lru_list mLRU; // most recently used entry in front
+	std::unordered_map<fingerprint, typename lru_list::iterator, fingerprint_hash> mEntries;
+	std::unordered_map<fingerprint, std::streamoff, fingerprint_hash> mStoreIndex; // record offsets in the store
+	std::size_t mCapacity;
+	std::string mStoreFileName;
+	std::ifstream mStoreIn;
+	std::ofstream mStoreOut;
+	unsigned long mHits;
+	unsigned long mMisses;
+	mutable std::mutex mMutex;
+	
+	void mReadStore();
+	bool mFind(const fingerprint& key, RESULTS& results);
+	void mInsert(const fingerprint& key, const RESULTS& results);
+public:
+	evaluation_cache(const std::size_t& capacity = 10000, const std::string& storeFileName = "");
+	~evaluation_cache();
+	
+	bool find(const fingerprint& key, RESULTS& results); // returns true and assigns results on a hit
+	void insert(const fingerprint& key, const RESULTS& results);
+	template <class FUNCTION>
+	RESULTS evaluate(const fingerprint& key, FUNCTION evaluation); // returns the cached results, or evaluates and stores them
+	
+	unsigned long getHits() const;
+	unsigned long getMisses() const;
+	std::size_t size() const; // number of entries held in memory
+	std::size_t storeSize() const; // number of entries in the store
+};
+
+} // namespace utilities
+} // namespace bso
+
+#include <bso/utilities/evaluation_cache.cpp>
+
+#endif // BSO_EVALUATION_CACHE_HPP
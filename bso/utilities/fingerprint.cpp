@@ -0,0 +1,95 @@
+#ifndef BSO_FINGERPRINT_CPP
+#define BSO_FINGERPRINT_CPP
+
+#include <cmath>
+#include <iomanip>
+
+namespace bso { namespace utilities {
+
+namespace fingerprint_detail {
+	inline uint64_t mix(uint64_t x)
+	{ // splitmix64 finalizer
+		x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+		x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+		x ^= x >> 31;
+		return x;
+	}
+} // namespace fingerprint_detail
+
+fingerprint::fingerprint()
+:	mFirst(0), mSecond(0)
+{
+	
+} // fingerprint()
+
+fingerprint::fingerprint(const uint64_t& first, const uint64_t& second)
+:	mFirst(first), mSecond(second)
+{
+	
+} // fingerprint()
+
+fingerprint::~fingerprint()
+{
+	
+} // ~fingerprint()
+
+void fingerprint::combine(const uint64_t& value)
+{ // order dependent, each half uses its own seed so that they are independent
+	mFirst = fingerprint_detail::mix(mFirst ^ fingerprint_detail::mix(value + 0x9e3779b97f4a7c15ULL));
+	mSecond = fingerprint_detail::mix(mSecond + fingerprint_detail::mix(value ^ 0xc2b2ae3d27d4eb4fULL));
+} // combine()
+
+void fingerprint::combine(const double& value, const double& tol)
+{ // quantises the value to multiples of tol
+	double q = std::round(value / tol);
+	if (q == 0) q = 0; // no distinction between -0 and 0
+	this->combine(uint64_t(int64_t(q)));
+} // combine()
+
+void fingerprint::combine(const std::string& value)
+{
+	this->combine(uint64_t(value.size()));
+	for (const auto& i : value) this->combine(uint64_t((unsigned char)i));
+} // combine()
+
+void fingerprint::add(const fingerprint& rhs)
+{ // addition modulo 2^64 is commutative, so the order in which fingerprints are added is irrelevant
+	mFirst += fingerprint_detail::mix(rhs.mFirst);
+	mSecond += fingerprint_detail::mix(rhs.mSecond);
+} // add()
+
+void fingerprint::remove(const fingerprint& rhs)
+{
+	mFirst -= fingerprint_detail::mix(rhs.mFirst);
+	mSecond -= fingerprint_detail::mix(rhs.mSecond);
+} // remove()
+
+bool fingerprint::operator == (const fingerprint& rhs) const
+{
+	return (mFirst == rhs.mFirst && mSecond == rhs.mSecond);
+} // operator ==
+
+bool fingerprint::operator != (const fingerprint& rhs) const
+{
+	return !(*this == rhs);
+} // operator !=
+
+bool fingerprint::operator < (const fingerprint& rhs) const
+{
+	return (mFirst < rhs.mFirst || (mFirst == rhs.mFirst && mSecond < rhs.mSecond));
+} // operator <
+
+std::ostream& operator << (std::ostream& stream, const fingerprint& f)
+{
+	std::ios_base::fmtflags flags = stream.flags();
+	char fill = stream.fill();
+	stream << std::hex << std::setfill('0') << std::setw(16) << f.mFirst << std::setw(16) << f.mSecond;
+	stream.flags(flags);
+	stream.fill(fill);
+	return stream;
+} // << operator
+
+} // namespace utilities
+} // namespace bso
+
+#endif // BSO_FINGERPRINT_CPP
@@ -0,0 +1,47 @@
+#ifndef BSO_FINGERPRINT_HPP
+#define BSO_FINGERPRINT_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <iostream>
+
+namespace bso { namespace utilities {
+
+class fingerprint
+{ // 128-bit hash, values are combined in order, fingerprints are added order independently
+private:
+	uint64_t mFirst;
+	uint64_t mSecond;
+public:
+	fingerprint();
+	fingerprint(const uint64_t& first, const uint64_t& second);
+	~fingerprint();
+	
+	void combine(const uint64_t& value); // order dependent
+	void combine(const double& value, const double& tol); // quantises the value to multiples of tol
+	void combine(const std::string& value);
+	void add(const fingerprint& rhs); // order independent, can be undone by remove()
+	void remove(const fingerprint& rhs);
+	
+	uint64_t getFirst() const {return mFirst;}
+	uint64_t getSecond() const {return mSecond;}
+	
+	bool operator == (const fingerprint& rhs) const;
+	bool operator != (const fingerprint& rhs) const;
+	bool operator < (const fingerprint& rhs) const;
+	
+	friend std::ostream& operator << (std::ostream& stream, const fingerprint& f);
+};
+
+struct fingerprint_hash
+{ // allows a fingerprint to be used as key in unordered containers
+	std::size_t operator()(const fingerprint& f) const {return f.getFirst() ^ (f.getSecond() << 1);}
+};
+
+} // namespace utilities
+} // namespace bso
+
+#include <bso/utilities/fingerprint.cpp>
+
+#endif // BSO_FINGERPRINT_HPP
@@ -0,0 +1,206 @@
+#ifndef BSO_INSTRUMENTATION_CPP
+#define BSO_INSTRUMENTATION_CPP
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace bso { namespace utilities {
+
+double wall_time()
+{ // seconds since an arbitrary moment, unlike clock() it is not summed over the threads of a process
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+} // wall_time()
+
+namespace instrumentation {
+
+namespace detail {
+	struct record
+	{
+		unsigned long mCount = 0;
+		double mTotal = 0.0;
+		double mMin = 0.0;
+		double mMax = 0.0;
+
+		void add(const double& value)
+		{
+			if (mCount == 0 || value < mMin) mMin = value;
+			if (mCount == 0 || value > mMax) mMax = value;
+			mTotal += value;
+			++mCount;
+		}
+		void add(const record& rhs)
+		{
+			if (rhs.mCount == 0) return;
+			if (mCount == 0 || rhs.mMin < mMin) mMin = rhs.mMin;
+			if (mCount == 0 || rhs.mMax > mMax) mMax = rhs.mMax;
+			mTotal += rhs.mTotal;
+			mCount += rhs.mCount;
+		}
+	};
+
+	struct thread_records
+	{ // written by one thread only, the mutex is only contended while the records are written out
+		unsigned long mThreadIndex;
+		std::map<std::string, record> mTimers;
+		std::map<std::string, record> mCounters;
+		std::mutex mMutex;
+	};
+
+	struct registry
+	{ // records of threads that have finished are kept, so that e.g. the workers of a pool are reported
+		std::vector<std::shared_ptr<thread_records> > mThreads;
+		std::mutex mMutex;
+	};
+
+	registry& getRegistry()
+	{
+		static registry r;
+		return r;
+	}
+
+	thread_records& getThreadRecords()
+	{
+		thread_local std::shared_ptr<thread_records> records;
+		if (records == nullptr)
+		{
+			records = std::make_shared<thread_records>();
+			registry& r = getRegistry();
+			std::lock_guard<std::mutex> lock(r.mMutex);
+			records->mThreadIndex = r.mThreads.size();
+			r.mThreads.push_back(records);
+		}
+		return *records;
+	}
+
+	void writeJSONRecords(std::ostream& out, const std::map<std::string, record>& records,
+		const std::string& indentation)
+	{
+		out << "{";
+		bool first = true;
+		for (const auto& i : records)
+		{
+			out << (first? "\n" : ",\n") << indentation << "\t\"" << i.first << "\": {"
+					<< "\"count\": " << i.second.mCount << ", \"total\": " << i.second.mTotal
+					<< ", \"min\": " << i.second.mMin << ", \"max\": " << i.second.mMax << "}";
+			first = false;
+		}
+		if (!first) out << "\n" << indentation;
+		out << "}";
+	}
+
+	void writeCSVRecords(std::ostream& out, const std::string& thread, const std::string& type,
+		const std::map<std::string, record>& records)
+	{
+		for (const auto& i : records)
+		{
+			out << thread << "," << type << "," << i.first << "," << i.second.mCount << ","
+					<< i.second.mTotal << "," << i.second.mMin << "," << i.second.mMax << "\n";
+		}
+	}
+
+	void collect(std::vector<std::pair<unsigned long, std::pair<std::map<std::string, record>,
+		std::map<std::string, record> > > >& perThread, std::map<std::string, record>& timers,
+		std::map<std::string, record>& counters)
+	{ // copies the records of each thread, and sums them
+		registry& r = getRegistry();
+		std::lock_guard<std::mutex> registryLock(r.mMutex);
+		for (const auto& i : r.mThreads)
+		{
+			std::lock_guard<std::mutex> lock(i->mMutex);
+			perThread.push_back({i->mThreadIndex, {i->mTimers, i->mCounters}});
+			for (const auto& j : i->mTimers) timers[j.first].add(j.second);
+			for (const auto& j : i->mCounters) counters[j.first].add(j.second);
+		}
+	}
+} // namespace detail
+
+scoped_timer::scoped_timer(const char* name)
+:	mName(name), mStart(wall_time())
+{
+
+} // ctor()
+
+scoped_timer::~scoped_timer()
+{
+	add_time(mName, wall_time() - mStart);
+} // dtor()
+
+void add_time(const char* name, const double& seconds)
+{
+	detail::thread_records& records = detail::getThreadRecords();
+	std::lock_guard<std::mutex> lock(records.mMutex);
+	records.mTimers[name].add(seconds);
+} // add_time()
+
+void count(const char* name, const double& value /*= 1.0*/)
+{
+	detail::thread_records& records = detail::getThreadRecords();
+	std::lock_guard<std::mutex> lock(records.mMutex);
+	records.mCounters[name].add(value);
+} // count()
+
+void reset()
+{ // clears the timers and counters of all threads
+	detail::registry& r = detail::getRegistry();
+	std::lock_guard<std::mutex> registryLock(r.mMutex);
+	for (auto& i : r.mThreads)
+	{
+		std::lock_guard<std::mutex> lock(i->mMutex);
+		i->mTimers.clear();
+		i->mCounters.clear();
+	}
+} // reset()
+
+void write_json(std::ostream& out)
+{ // per thread and summed over all threads, times are in seconds
+	std::vector<std::pair<unsigned long, std::pair<std::map<std::string, detail::record>,
+		std::map<std::string, detail::record> > > > perThread;
+	std::map<std::string, detail::record> timers, counters;
+	detail::collect(perThread, timers, counters);
+
+	out << "{\n\t\"threads\": [";
+	bool first = true;
+	for (const auto& i : perThread)
+	{
+		out << (first? "\n" : ",\n") << "\t\t{\"thread\": " << i.first << ",\n\t\t\"timers\": ";
+		detail::writeJSONRecords(out, i.second.first, "\t\t");
+		out << ",\n\t\t\"counters\": ";
+		detail::writeJSONRecords(out, i.second.second, "\t\t");
+		out << "}";
+		first = false;
+	}
+	out << "\n\t],\n\t\"total\": {\n\t\t\"timers\": ";
+	detail::writeJSONRecords(out, timers, "\t\t");
+	out << ",\n\t\t\"counters\": ";
+	detail::writeJSONRecords(out, counters, "\t\t");
+	out << "\n\t}\n}" << std::endl;
+} // write_json()
+
+void write_csv(std::ostream& out)
+{ // columns: thread,type,name,count,total,min,max
+	std::vector<std::pair<unsigned long, std::pair<std::map<std::string, detail::record>,
+		std::map<std::string, detail::record> > > > perThread;
+	std::map<std::string, detail::record> timers, counters;
+	detail::collect(perThread, timers, counters);
+
+	out << "thread,type,name,count,total,min,max\n";
+	for (const auto& i : perThread)
+	{
+		detail::writeCSVRecords(out, std::to_string(i.first), "timer", i.second.first);
+		detail::writeCSVRecords(out, std::to_string(i.first), "counter", i.second.second);
+	}
+	detail::writeCSVRecords(out, "total", "timer", timers);
+	detail::writeCSVRecords(out, "total", "counter", counters);
+	out.flush();
+} // write_csv()
+
+} // namespace instrumentation
+} // namespace utilities
+} // namespace bso
+
+#endif // BSO_INSTRUMENTATION_CPP
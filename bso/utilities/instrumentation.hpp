@@ -0,0 +1,47 @@
+#ifndef BSO_INSTRUMENTATION_HPP
+#define BSO_INSTRUMENTATION_HPP
+
+#include <ostream>
+#include <string>
+
+namespace bso { namespace utilities {
+
+double wall_time(); // seconds since an arbitrary moment, unlike clock() it is not summed over the threads of a process
+
+namespace instrumentation {
+
+class scoped_timer
+{ // adds the wall-clock time between construction and destruction to the named timer of the calling thread
+private:
+	const char* mName;
+	double mStart;
+public:
+	scoped_timer(const char* name);
+	~scoped_timer();
+};
+
+void add_time(const char* name, const double& seconds);
+void count(const char* name, const double& value = 1.0);
+void reset(); // clears the timers and counters of all threads
+void write_json(std::ostream& out); // per thread and summed over all threads
+void write_csv(std::ostream& out); // columns: thread,type,name,count,total,min,max
+
+} // namespace instrumentation
+} // namespace utilities
+} // namespace bso
+
+// the instrumentation of the toolbox is only compiled in if BSO_INSTRUMENTATION is defined
+#define BSO_INSTRUMENTATION_CONCAT_IMPL(a,b) a##b
+#define BSO_INSTRUMENTATION_CONCAT(a,b) BSO_INSTRUMENTATION_CONCAT_IMPL(a,b)
+#ifdef BSO_INSTRUMENTATION
+#define BSO_SCOPED_TIMER(name) bso::utilities::instrumentation::scoped_timer \
+	BSO_INSTRUMENTATION_CONCAT(bsoScopedTimer,__LINE__)(name)
+#define BSO_COUNT(name,value) bso::utilities::instrumentation::count(name,value)
+#else
+#define BSO_SCOPED_TIMER(name)
+#define BSO_COUNT(name,value)
+#endif
+
+#include <bso/utilities/instrumentation.cpp>
+
+#endif // BSO_INSTRUMENTATION_HPP
@@ -2,50 +2,172 @@
 #define BSO_NON_DOMINATED_SEARCH_CPP
 
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
 
 namespace bso { namespace utilities {
-	
-std::vector<data_point> non_dominated_search(const std::vector<data_point>& data)
+
+namespace non_dominated_detail {
+
+bool dominates(const double* a, const double* b, const unsigned int& d)
+{ // true if a is nowhere worse and somewhere better than b
+	bool better = false;
+	for (unsigned int i = 0; i < d; ++i)
+	{
+		if (a[i] > b[i]) return false;
+		if (a[i] < b[i]) better = true;
+	}
+	return better;
+} // dominates()
+
+std::vector<unsigned long> lexicographicOrder(const objective_matrix& objectives)
+{ // a point can only be dominated by points that precede it in this order
+	const unsigned int d = objectives.cols();
+	std::vector<unsigned long> order(objectives.rows());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&objectives, d](const unsigned long& a,
+		const unsigned long& b)
+	{
+		const double* pA = objectives.data() + a*d;
+		const double* pB = objectives.data() + b*d;
+		for (unsigned int i = 0; i < d; ++i)
+		{
+			if (pA[i] < pB[i]) return true;
+			if (pA[i] > pB[i]) return false;
+		}
+		return a < b;
+	});
+	return order;
+} // lexicographicOrder()
+
+bool dominatedByFront(const objective_matrix& objectives,
+	const std::vector<unsigned long>& front, const unsigned long& p)
+{ // the most recently added points of a front are the most likely to dominate p
+	const unsigned int d = objectives.cols();
+	const double* pData = objectives.data() + p*d;
+	for (auto i = front.rbegin(); i != front.rend(); ++i)
+	{
+		if (dominates(objectives.data() + (*i)*d, pData, d)) return true;
+	}
+	return false;
+} // dominatedByFront()
+
+} // namespace non_dominated_detail
+
+objective_matrix toObjectiveMatrix(const std::vector<data_point>& data)
 {
-	std::vector<data_point> dataCopy = data;
-	return non_dominated_search(dataCopy);
-}
-std::vector<data_point> non_dominated_search(std::vector<data_point>& data)
+	objective_matrix objectives(data.size(), data.empty()? 0 : data.front().size());
+	for (unsigned long i = 0; i < data.size(); ++i)
+	{
+		if (data[i].size() != objectives.cols())
+		{
+			std::stringstream errorMessage;
+			errorMessage << "\nError, when filtering data for non-dominated points\n"
+									 << "point " << i << " has " << data[i].size() << " dimensions instead of "
+									 << objectives.cols() << ":\n" << data[i]
+									 << "\n(bso/utilities/non_dominated_search.cpp)" << std::endl;
+			throw std::invalid_argument(errorMessage.str());
+		}
+		for (unsigned int j = 0; j < objectives.cols(); ++j) objectives(i,j) = data[i](j);
+	}
+	return objectives;
+} // toObjectiveMatrix()
+
+std::vector<unsigned long> non_dominated_front(const objective_matrix& objectives)
 {
-	std::vector<data_point> sorted;
-	std::stable_sort(data.begin(), data.end());
-	for (const auto& i : data)
+	using namespace non_dominated_detail;
+	std::vector<unsigned long> order = lexicographicOrder(objectives);
+	std::vector<unsigned long> front;
+	if (objectives.cols() == 2)
+	{ // sweep over the first objective, keeping the lowest second objective found so far
+		const double* minPoint = nullptr;
+		for (const auto& i : order)
+		{
+			const double* p = objectives.data() + 2*i;
+			if (minPoint == nullptr || p[1] < minPoint[1]) minPoint = p;
+			else if (p[1] > minPoint[1] || p[0] > minPoint[0]) continue;
+			front.push_back(i); // p is new or equal to the first point with the lowest second objective
+		}
+	}
+	else
+	{ // dominated points are not needed in the first front, so only compare to the front itself
+		for (const auto& i : order)
+		{
+			if (!dominatedByFront(objectives, front, i)) front.push_back(i);
+		}
+	}
+	return front;
+} // non_dominated_front()
+
+std::vector<std::vector<unsigned long> > non_dominated_sort(const objective_matrix& objectives)
+{ // Zhang et al. (2015) An efficient approach to nondominated sorting for evolutionary
+	// multiobjective optimization, https://doi.org/10.1109/TEVC.2014.2308305
+	using namespace non_dominated_detail;
+	std::vector<std::vector<unsigned long> > fronts;
+	for (const auto& i : lexicographicOrder(objectives))
+	{ // if a front dominates i, so do all fronts before it, so the front of i can be found by bisection
+		unsigned long low = 0, high = fronts.size();
+		while (low < high)
+		{
+			unsigned long mid = (low + high)/2;
+			if (dominatedByFront(objectives, fronts[mid], i)) low = mid + 1;
+			else high = mid;
+		}
+		if (low == fronts.size()) fronts.push_back({});
+		fronts[low].push_back(i);
+	}
+	return fronts;
+} // non_dominated_sort()
+
+Eigen::VectorXd crowding_distance(const objective_matrix& objectives,
+	const std::vector<unsigned long>& front)
+{ // Deb et al. (2002) A fast and elitist multiobjective genetic algorithm: NSGA-II,
+	// the extreme points of each objective get an infinite distance
+	Eigen::VectorXd distance = Eigen::VectorXd::Zero(front.size());
+	if (front.size() < 3)
+	{
+		distance.setConstant(std::numeric_limits<double>::infinity());
+		return distance;
+	}
+	std::vector<unsigned long> order(front.size());
+	for (unsigned int j = 0; j < objectives.cols(); ++j)
 	{
-		bool nonDominated = true;
-		auto j = sorted.begin();
-		while (j != sorted.end())
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](const unsigned long& a, const unsigned long& b)
+		{
+			return objectives(front[a],j) < objectives(front[b],j);
+		});
+		double range = objectives(front[order.back()],j) - objectives(front[order.front()],j);
+		distance(order.front()) = std::numeric_limits<double>::infinity();
+		distance(order.back()) = std::numeric_limits<double>::infinity();
+		if (range <= 0) continue;
+		for (unsigned long k = 1; k < order.size() - 1; ++k)
 		{
-			try
-			{
-				if (j->dominates(i))
-				{
-					nonDominated = false;
-					++j;
-					break;
-				}
-				else if (j->isDominatedBy(i)) j = sorted.erase(j);
-				else ++j;
-			}
-			catch (std::exception& e)
-			{
-				std::stringstream errorMessage;
-				errorMessage << "\nError, when filtering data for non-dominated points\n"
-										 << "Could not compare the following points to each other:\n"
-										 << i << "vs" << *j << "\n(bso/utilities/non_dominated_search.cpp)" << std::endl;
-				throw std::invalid_argument(errorMessage.str());
-			}
+			distance(order[k]) += (objectives(front[order[k+1]],j) -
+				objectives(front[order[k-1]],j)) / range;
 		}
-		if (nonDominated) sorted.push_back(i);
 	}
-	return sorted;
+	return distance;
+} // crowding_distance()
+
+std::vector<data_point> non_dominated_search(const std::vector<data_point>& data)
+{
+	std::vector<data_point> nonDominated;
+	for (const auto& i : non_dominated_front(toObjectiveMatrix(data)))
+	{
+		nonDominated.push_back(data[i]);
+	}
+	return nonDominated;
 }
-	
+std::vector<data_point> non_dominated_search(std::vector<data_point>& data)
+{
+	const std::vector<data_point>& constData = data;
+	return non_dominated_search(constData);
+}
+
 } // namespace utilities
 } // namespace bso
 
-#endif // BSO_NON_DOMINATED_SEARCH_CPP
\ No newline at end of file
+#endif // BSO_NON_DOMINATED_SEARCH_CPP
@@ -4,13 +4,26 @@
 #include <bso/utilities/data_point.hpp>
 
 namespace bso { namespace utilities {
-	
+
+// one row of objectives per point, stored contiguously, all objectives are minimized
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> objective_matrix;
+
+objective_matrix toObjectiveMatrix(const std::vector<data_point>& data);
+
+// indices of the points in the first front, in lexicographic order of their objectives
+std::vector<unsigned long> non_dominated_front(const objective_matrix& objectives);
+// indices of the points in each front (efficient non-dominated sort with binary search)
+std::vector<std::vector<unsigned long> > non_dominated_sort(const objective_matrix& objectives);
+// crowding distance of each point in a front, ordered as the front
+Eigen::VectorXd crowding_distance(const objective_matrix& objectives,
+	const std::vector<unsigned long>& front);
+
 std::vector<data_point> non_dominated_search(const std::vector<data_point>& data);
 std::vector<data_point> non_dominated_search(std::vector<data_point>& data);
-	
+
 } // namespace utilities
 } // namespace bso
 
 #include <bso/utilities/non_dominated_search.cpp>
 
-#endif // BSO_NON_DOMINATED_SEARCH_HPP
\ No newline at end of file
+#endif // BSO_NON_DOMINATED_SEARCH_HPP
@@ -0,0 +1,172 @@
+#ifndef BSO_THREAD_POOL_CPP
+#define BSO_THREAD_POOL_CPP
+
+#include <chrono>
+#include <utility>
+
+namespace bso { namespace utilities {
+
+namespace thread_pool_detail {
+	thread_local const thread_pool* currentPool = nullptr; // pool of which the calling thread is a worker
+	thread_local int currentWorker = -1;
+} // namespace thread_pool_detail
+
+thread_pool::thread_pool(unsigned int threads /*= 0*/, std::size_t capacity /*= 0*/)
+:	mWorkerTaskCount(0)
+{ // 0 threads is one per hardware thread, 0 capacity of the shared queue is twice the number of threads
+	if (threads == 0) threads = std::thread::hardware_concurrency();
+	if (threads == 0) threads = 1;
+	if (capacity == 0) capacity = 2*threads;
+	mCapacity = capacity;
+
+	for (unsigned int i = 0; i < threads; ++i)
+	{
+		mWorkerQueues.push_back(std::unique_ptr<worker_queue>(new worker_queue));
+	}
+	for (unsigned int i = 0; i < threads; ++i)
+	{
+		mThreads.push_back(std::thread(&thread_pool::mWork, this, (int)i));
+	}
+} // ctor()
+
+thread_pool::~thread_pool()
+{ // finishes all submitted tasks
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mTaskAvailable.notify_all();
+	for (auto& i : mThreads) i.join();
+} // dtor()
+
+int thread_pool::mWorkerIndex() const
+{ // index of the calling thread in this pool, -1 if it is not one of its workers
+	if (thread_pool_detail::currentPool != this) return -1;
+	return thread_pool_detail::currentWorker;
+} // mWorkerIndex()
+
+void thread_pool::mPush(std::function<void()> task)
+{
+	int workerIndex = this->mWorkerIndex();
+	if (workerIndex >= 0)
+	{ // a worker never blocks on the shared queue, it would wait for itself if all workers do
+		{ // counted first, so that the count never drops below the number of queued tasks
+			std::lock_guard<std::mutex> lock(mMutex);
+			++mWorkerTaskCount;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mWorkerQueues[workerIndex]->mMutex);
+			mWorkerQueues[workerIndex]->mTasks.push_back(std::move(task));
+		}
+	}
+	else
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mSpaceAvailable.wait(lock, [this](){return mSharedQueue.size() < mCapacity;});
+		mSharedQueue.push_back(std::move(task));
+	}
+	mTaskAvailable.notify_one();
+} // mPush()
+
+bool thread_pool::mPopWorkerTask(const int& workerIndex, std::function<void()>& task)
+{ // takes the newest task of the own queue, or else steals the oldest task of another worker
+	if (workerIndex >= 0)
+	{
+		worker_queue& own = *mWorkerQueues[workerIndex];
+		std::lock_guard<std::mutex> lock(own.mMutex);
+		if (!own.mTasks.empty())
+		{
+			task = std::move(own.mTasks.back());
+			own.mTasks.pop_back();
+			--mWorkerTaskCount;
+			return true;
+		}
+	}
+	if (mWorkerTaskCount == 0) return false;
+
+	std::size_t start = (workerIndex >= 0)? workerIndex + 1 : 0;
+	for (std::size_t i = 0; i < mWorkerQueues.size(); ++i)
+	{
+		worker_queue& victim = *mWorkerQueues[(start + i) % mWorkerQueues.size()];
+		std::lock_guard<std::mutex> lock(victim.mMutex);
+		if (!victim.mTasks.empty())
+		{
+			task = std::move(victim.mTasks.front());
+			victim.mTasks.pop_front();
+			--mWorkerTaskCount;
+			return true;
+		}
+	}
+	return false;
+} // mPopWorkerTask()
+
+bool thread_pool::mPopSharedTask(std::function<void()>& task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mSharedQueue.empty()) return false;
+		task = std::move(mSharedQueue.front());
+		mSharedQueue.pop_front();
+	}
+	mSpaceAvailable.notify_one();
+	return true;
+} // mPopSharedTask()
+
+void thread_pool::mWork(const int& workerIndex)
+{ // tasks that were spawned by workers are finished before new tasks are taken from the shared queue
+	thread_pool_detail::currentPool = this;
+	thread_pool_detail::currentWorker = workerIndex;
+
+	std::function<void()> task;
+	while (true)
+	{
+		if (this->mPopWorkerTask(workerIndex, task) || this->mPopSharedTask(task))
+		{
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		mTaskAvailable.wait(lock, [this](){
+			return mStopping || !mSharedQueue.empty() || mWorkerTaskCount > 0;});
+		if (mStopping && mSharedQueue.empty() && mWorkerTaskCount == 0) break;
+	}
+} // mWork()
+
+template <class FUNCTION>
+std::future<typename std::result_of<FUNCTION()>::type> thread_pool::submit(FUNCTION task)
+{ // blocks while the shared queue is full
+	typedef typename std::result_of<FUNCTION()>::type result_type;
+	auto packagedTask = std::make_shared<std::packaged_task<result_type()> >(std::move(task));
+	std::future<result_type> result = packagedTask->get_future();
+	this->mPush([packagedTask](){(*packagedTask)();});
+	return result;
+} // submit()
+
+template <class T>
+void thread_pool::wait(const std::future<T>& result)
+{ // a worker runs queued tasks of other workers while it waits
+	int workerIndex = this->mWorkerIndex();
+	if (workerIndex < 0)
+	{
+		result.wait();
+		return;
+	}
+
+	std::function<void()> task;
+	while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{ // tasks of the shared queue are not taken, they may take much longer than the awaited one
+		if (this->mPopWorkerTask(workerIndex, task))
+		{
+			task();
+			task = nullptr;
+		}
+		else result.wait_for(std::chrono::microseconds(100));
+	}
+} // wait()
+
+} // namespace utilities
+} // namespace bso
+
+#endif // BSO_THREAD_POOL_CPP
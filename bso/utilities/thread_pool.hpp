@@ -0,0 +1,62 @@
+#ifndef BSO_THREAD_POOL_HPP
+#define BSO_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bso { namespace utilities {
+
+class thread_pool
+{ // work-stealing pool, tasks submitted from outside the pool go into a bounded shared queue,
+	// tasks submitted by a worker go into that worker's own queue, from which idle workers steal
+private:
+	struct worker_queue
+	{
+		std::deque<std::function<void()> > mTasks; // the owner takes from the back, thieves from the front
+		std::mutex mMutex;
+	};
+
+	std::vector<std::unique_ptr<worker_queue> > mWorkerQueues;
+	std::deque<std::function<void()> > mSharedQueue;
+	std::size_t mCapacity;
+	std::atomic<unsigned long> mWorkerTaskCount; // tasks in the worker queues
+	bool mStopping = false;
+	std::mutex mMutex;
+	std::condition_variable mTaskAvailable;
+	std::condition_variable mSpaceAvailable;
+	std::vector<std::thread> mThreads;
+
+	int mWorkerIndex() const; // index of the calling thread in this pool, -1 if it is not one of its workers
+	void mPush(std::function<void()> task);
+	bool mPopWorkerTask(const int& workerIndex, std::function<void()>& task);
+	bool mPopSharedTask(std::function<void()>& task);
+	void mWork(const int& workerIndex);
+public:
+	thread_pool(unsigned int threads = 0, std::size_t capacity = 0); // 0 threads is one per hardware thread,
+		// 0 capacity of the shared queue is twice the number of threads
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+	~thread_pool(); // finishes all submitted tasks
+
+	template <class FUNCTION>
+	std::future<typename std::result_of<FUNCTION()>::type> submit(FUNCTION task); // blocks while the shared queue is full
+	template <class T>
+	void wait(const std::future<T>& result); // a worker runs queued tasks of other workers while it waits
+
+	std::size_t size() const {return mThreads.size();}
+	std::size_t getCapacity() const {return mCapacity;}
+};
+
+} // namespace utilities
+} // namespace bso
+
+#include <bso/utilities/thread_pool.cpp>
+
+#endif // BSO_THREAD_POOL_HPP
@@ -34,7 +34,6 @@ void simulation(string inputsFile, string transformation, string geometry, vecto
     // Read BSD origin and dimensions file
     string InputsLine;
     ifstream Inputs(inputsFile);                // = "origin_dimensions_BSDs_ML.txt"                                
-    ofstream msinput("ms_input_file.txt");                                   
     ofstream inputBSDf("inputBSD_ML.txt", ios::trunc);    
     ofstream inputBSDf_OneHotEncoded("inputBSD_OneHotEncoded_ML.txt", ios::trunc); 
     ofstream inputBSDf_NumberEncoded("inputBSD_NumberEncoded_ML.txt", ios::trunc);    
@@ -60,19 +59,18 @@ void simulation(string inputsFile, string transformation, string geometry, vecto
     {
         while ( !Inputs.eof() )
         {
-            ofstream msinput("ms_input_file.txt", ofstream::trunc);                                              
+            stringstream msinput;                                              
             while ( getline(Inputs,InputsLine) && InputsLine != ""  )
             {
                 msinput << InputsLine << endl;
             }
             nlines++;
-            bso::spatial_design::ms_building MS("ms_input_file.txt");
+            bso::spatial_design::ms_building MS(msinput);
 
             // write BSD input to "inputBSD.txt" file, so it can be used as features
             string line;
             string dna;
-            ifstream input("ms_input_file.txt");                
-            if (input.is_open())                                                  
+            istringstream input(msinput.str());                
             {
                 while ( getline (input, line) )
                 {
@@ -199,7 +197,6 @@ void simulation(string inputsFile, string transformation, string geometry, vecto
                 }                           
                 inputBSDf_OneHotEncoded.close();
                 inputBSDf_NumberEncoded.close();
-                input.close();
             }
             bso::spatial_design::cf_building CF(MS);
 
@@ -37,6 +37,27 @@ BOOST_AUTO_TEST_SUITE( grammar_default_bp_test )
 		BOOST_REQUIRE(bp.getFloors().size() == 2);
 		BOOST_REQUIRE(bp.getWindows().size() == 1);
 	}
+	
+	BOOST_AUTO_TEST_CASE( default_bp_grammar_shared_settings )
+	{
+		bso::spatial_design::ms_building ms({bso::spatial_design::ms_space(1,{0,0,0},
+			{1000,2000,3000},"",{"T","B","T","F","F","F"})}); // same as grammar/ms_test_1.txt
+		bso::spatial_design::cf_building cf(ms);
+
+		auto settings = bp_grammar_settings::read("grammar/bp_settings_1.txt");
+		BOOST_REQUIRE(settings == bp_grammar_settings::read("grammar/bp_settings_1.txt"));
+
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			bso::grammar::grammar gram(cf);
+			bso::building_physics::bp_model bp = gram.bp_grammar<>(*settings,true);
+			BOOST_REQUIRE(bp.getStates().size() == 9);
+			BOOST_REQUIRE(bp.getSpaces().size() == 1);
+			BOOST_REQUIRE(bp.getWalls().size() == 3);
+			BOOST_REQUIRE(bp.getFloors().size() == 2);
+			BOOST_REQUIRE(bp.getWindows().size() == 1);
+		}
+	}
 
 
 BOOST_AUTO_TEST_SUITE_END()
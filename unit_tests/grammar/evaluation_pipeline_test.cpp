@@ -0,0 +1,82 @@
+#ifndef BOOST_TEST_MODULE
+#define BOOST_TEST_MODULE "evaluation_pipeline_test"
+#endif
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <bso/spatial_design/ms_building.hpp>
+#include <bso/spatial_design/cf_building.hpp>
+#include <bso/structural_design/sd_model.hpp>
+#include <bso/building_physics/bp_model.hpp>
+#include <bso/grammar/grammar.hpp>
+#include <bso/grammar/evaluation_pipeline.hpp>
+
+/*
+BOOST_TEST()
+BOOST_REQUIRE_THROW(function, std::domain_error)
+BOOST_REQUIRE(!s[8].dominates(s[9]) && !s[9].dominates(s[8]))
+BOOST_CHECK_EQUAL_COLLECTIONS(a.begin(), a.end(), b.begin(), b.end());
+*/
+
+namespace grammar_test {
+using namespace bso::grammar;
+
+BOOST_AUTO_TEST_SUITE( grammar_evaluation_pipeline_test )
+
+	BOOST_AUTO_TEST_CASE( ordered_evaluation )
+	{
+		std::vector<bso::spatial_design::ms_building> designs;
+		for (unsigned int i = 0; i < 6; ++i)
+		{
+			designs.push_back(bso::spatial_design::ms_building({
+				bso::spatial_design::ms_space(1,{0,0,0},{3000,3000,3000}),
+				bso::spatial_design::ms_space(2,{3000,0,0},{3000.0 + 1000*i,3000,3000})}));
+		}
+		auto settings = sd_grammar_settings::read("grammar/sd_settings_1.txt");
+
+		evaluation_pipeline pipeline(3, 2);
+		pipeline.setSDGrammar([&settings](grammar& g){return g.sd_grammar<>(*settings);});
+		std::vector<unsigned long> reported;
+		pipeline.setCallback([&reported](const design_evaluation& e){reported.push_back(e.mIndex);});
+		std::vector<design_evaluation> evaluations = pipeline.evaluate(designs);
+
+		BOOST_REQUIRE(evaluations.size() == designs.size());
+		BOOST_REQUIRE(reported.size() == designs.size());
+		for (unsigned int i = 0; i < designs.size(); ++i)
+		{ // each design must give the same results as a sequential evaluation
+			BOOST_REQUIRE(evaluations[i].mIndex == i);
+			BOOST_REQUIRE(reported[i] == i);
+			BOOST_REQUIRE(evaluations[i].mSucceeded);
+			BOOST_REQUIRE(evaluations[i].mSDEvaluated);
+			BOOST_REQUIRE(!evaluations[i].mBPEvaluated);
+
+			bso::spatial_design::cf_building cf(designs[i]);
+			bso::grammar::grammar gram(cf);
+			bso::structural_design::sd_model sd = gram.sd_grammar<>(*settings);
+			sd.analyze();
+			BOOST_REQUIRE_CLOSE(evaluations[i].mSDResults.mTotalStrainEnergy,
+				sd.getTotalResults().mTotalStrainEnergy, 1e-6);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( failing_stage )
+	{ // a failing stage is reported, while the other stage is still evaluated
+		bso::spatial_design::ms_building ms({
+			bso::spatial_design::ms_space(1,{0,0,0},{3000,3000,3000})});
+		auto settings = sd_grammar_settings::read("grammar/sd_settings_1.txt");
+
+		evaluation_pipeline pipeline(2);
+		pipeline.setSDGrammar([&settings](grammar& g){return g.sd_grammar<>(*settings);});
+		pipeline.setBPGrammar([](grammar& g) -> bso::building_physics::bp_model
+			{throw std::runtime_error("bp stage failed");});
+		design_evaluation e = pipeline.submit(ms).get();
+
+		BOOST_REQUIRE(!e.mSucceeded);
+		BOOST_REQUIRE(e.mErrorMessage == "bp stage failed");
+		BOOST_REQUIRE(e.mSDEvaluated);
+		BOOST_REQUIRE(!e.mBPEvaluated);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace grammar_test
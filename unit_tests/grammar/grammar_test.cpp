@@ -9,6 +9,11 @@
 #include <bso/structural_design/sd_model.hpp>
 #include <bso/building_physics/bp_model.hpp>
 #include <bso/grammar/grammar.hpp>
+#include <bso/grammar/sd_grammars/optimizer_assignment.cpp>
+#include <bso/grammar/evaluation_pipeline.hpp>
+
+#include <memory>
+#include <thread>
 
 #include <unit_tests/grammar/rule_set/vertex_property_test.cpp>
 #include <unit_tests/grammar/rule_set/line_property_test.cpp>
@@ -47,8 +52,38 @@ BOOST_AUTO_TEST_SUITE( grammar_test )
 		bso::grammar::grammar gram(cf);
 	}
 
+	BOOST_AUTO_TEST_CASE( concurrent_sd_and_bp_grammar )
+	{
+		bso::spatial_design::ms_building ms("grammar/ms_test_1.txt");
+		bso::spatial_design::cf_building cf(ms);
+		auto sdSettings = sd_grammar_settings::read("grammar/sd_settings_1.txt");
+		auto bpSettings = bp_grammar_settings::read("grammar/bp_settings_1.txt");
+
+		// one grammar produces both models at the same time
+		bso::grammar::grammar gram(cf);
+		std::unique_ptr<bso::structural_design::sd_model> sd;
+		std::unique_ptr<bso::building_physics::bp_model> bp;
+		std::thread sdThread([&](){
+			sd.reset(new bso::structural_design::sd_model(gram.sd_grammar<>(*sdSettings)));});
+		std::thread bpThread([&](){
+			bp.reset(new bso::building_physics::bp_model(gram.bp_grammar<>(*bpSettings,true)));});
+		sdThread.join();
+		bpThread.join();
+
+		bso::grammar::grammar sequentialGram(cf);
+		bso::structural_design::sd_model sdSequential = sequentialGram.sd_grammar<>(*sdSettings);
+		bso::building_physics::bp_model bpSequential = sequentialGram.bp_grammar<>(*bpSettings,true);
+		BOOST_REQUIRE(sd->getGeometries().size() == sdSequential.getGeometries().size());
+		BOOST_REQUIRE(sd->getPoints().size() == sdSequential.getPoints().size());
+		BOOST_REQUIRE(bp->getStates().size() == bpSequential.getStates().size());
+		BOOST_REQUIRE(bp->getWalls().size() == bpSequential.getWalls().size());
+		BOOST_REQUIRE(bp->getFloors().size() == bpSequential.getFloors().size());
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #include <unit_tests/grammar/sd_grammars/default_sd_grammar_test.cpp>
+#include <unit_tests/grammar/sd_grammars/optimizer_assignment_test.cpp>
 #include <unit_tests/grammar/bp_grammars/default_bp_grammar_test.cpp>
+#include <unit_tests/grammar/evaluation_pipeline_test.cpp>
 } // namespace grammar_test
\ No newline at end of file
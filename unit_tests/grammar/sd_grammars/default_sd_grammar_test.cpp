@@ -75,6 +75,55 @@ BOOST_AUTO_TEST_SUITE( grammar_default_sd_test )
 		BOOST_REQUIRE(constraintCount == 12);
 		BOOST_REQUIRE(uncounted == 0);
 	}
+	
+	BOOST_AUTO_TEST_CASE( default_sd_grammar_shared_settings )
+	{
+		bso::spatial_design::ms_building ms({bso::spatial_design::ms_space(1,{0,0,0},
+			{1000,2000,3000},"",{"T","B","T","F","F","F"})}); // same as grammar/ms_test_1.txt
+		bso::spatial_design::cf_building cf(ms);
+
+		// settings are parsed once and reused until the file is modified
+		auto settings = sd_grammar_settings::read("grammar/sd_settings_1.txt");
+		BOOST_REQUIRE(settings == sd_grammar_settings::read("grammar/sd_settings_1.txt"));
+		BOOST_REQUIRE(settings->getFileName() == "grammar/sd_settings_1.txt");
+		BOOST_REQUIRE(settings->getLoads().size() > 0);
+
+		std::ifstream input("grammar/sd_settings_1.txt");
+		std::stringstream content;
+		content << input.rdbuf();
+		sd_grammar_settings streamSettings(content);
+		BOOST_REQUIRE(streamSettings.getFileName().empty());
+		BOOST_REQUIRE(streamSettings.getWallProperties().size() == settings->getWallProperties().size());
+		BOOST_REQUIRE(streamSettings.getFloorProperties().size() == settings->getFloorProperties().size());
+		BOOST_REQUIRE(streamSettings.getLoads().size() == settings->getLoads().size());
+
+		bso::grammar::grammar gram1(cf);
+		bso::grammar::grammar gram2(cf);
+		bso::grammar::grammar gram3(cf);
+		std::vector<bso::structural_design::sd_model> models;
+		models.push_back(gram1.sd_grammar<>(std::string("grammar/sd_settings_1.txt"),true));
+		models.push_back(gram2.sd_grammar<>(*settings,true));
+		models.push_back(gram3.sd_grammar<>(streamSettings,true));
+
+		std::vector<std::pair<unsigned int, unsigned int> > counts;
+		for (const auto& sd : models)
+		{
+			unsigned int structureCount = 0;
+			unsigned int loadCount = 0;
+			for (const auto& i : sd.getGeometries())
+			{
+				structureCount += i->getStructures().size();
+				loadCount += i->getLoads().size();
+			}
+			counts.push_back({structureCount, loadCount});
+		}
+		BOOST_REQUIRE(counts[0].first == 12);
+		BOOST_REQUIRE(counts[0].second == 22);
+		BOOST_REQUIRE(counts[1] == counts[0]);
+		BOOST_REQUIRE(counts[2] == counts[0]);
+
+		BOOST_REQUIRE_THROW(sd_grammar_settings::read("grammar/no_such_file.txt"), std::invalid_argument);
+	}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,77 @@
+#ifndef BOOST_TEST_MODULE
+#define BOOST_TEST_MODULE "optimizer_assignment_test"
+#endif
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <bso/spatial_design/ms_building.hpp>
+#include <bso/spatial_design/cf_building.hpp>
+#include <bso/structural_design/sd_model.hpp>
+#include <bso/grammar/grammar.hpp>
+#include <bso/grammar/sd_grammars/optimizer_assignment.cpp>
+
+/*
+BOOST_TEST()
+BOOST_REQUIRE_THROW(function, std::domain_error)
+BOOST_REQUIRE(!s[8].dominates(s[9]) && !s[9].dominates(s[8]))
+BOOST_CHECK_EQUAL_COLLECTIONS(a.begin(), a.end(), b.begin(), b.end());
+*/
+
+namespace grammar_test {
+using namespace bso::grammar;
+
+BOOST_AUTO_TEST_SUITE( grammar_optimizer_assignment_test )
+
+	BOOST_AUTO_TEST_CASE( repeated_assignments )
+	{
+		bso::spatial_design::ms_building ms({
+			bso::spatial_design::ms_space(1,{0,0,0},{3000,3000,3000}),
+			bso::spatial_design::ms_space(2,{3000,0,0},{3000,3000,3000})});
+		bso::spatial_design::cf_building cf(ms);
+
+		bso::structural_design::component::structure truss("truss",{{"A",22500},{"E",3e4}});
+		bso::structural_design::component::structure beam("beam",
+			{{"width",150},{"height",150},{"poisson",0.3},{"E",3e4}});
+		bso::structural_design::component::structure flatShell("flat_shell",
+			{{"thickness",150},{"poisson",0.3},{"E",3e4}});
+		auto settings = sd_grammar_settings::read("grammar/sd_settings_1.txt");
+
+		unsigned int varCount = 0;
+		for (const auto& i : cf.cfRectangles())
+		{
+			if (i->cfSurfaces().size() == 1 || i->cfSurfaces().size() == 2) ++varCount;
+		}
+		std::vector<std::string> designs = {std::string(varCount,'4'),
+			std::string(varCount,'2'), std::string(varCount,'3'), std::string(varCount,'4')};
+
+		// one grammar evaluates all designs, each must match a grammar that is used once
+		bso::grammar::grammar reusedGrammar(cf);
+		for (const auto& i : designs)
+		{
+			bso::grammar::grammar freshGrammar(cf);
+			bso::structural_design::sd_model sdReused = reusedGrammar.sd_grammar<OPTIMIZER_ASSIGNMENT>(
+				*settings, i, truss, beam, flatShell);
+			bso::structural_design::sd_model sdFresh = freshGrammar.sd_grammar<OPTIMIZER_ASSIGNMENT>(
+				*settings, i, truss, beam, flatShell);
+			BOOST_REQUIRE(sdReused.getGeometries().size() == sdFresh.getGeometries().size());
+			BOOST_REQUIRE(sdReused.getPoints().size() == sdFresh.getPoints().size());
+
+			sdReused.analyze();
+			sdFresh.analyze();
+			BOOST_REQUIRE_CLOSE(sdReused.getTotalResults().mTotalStrainEnergy,
+				sdFresh.getTotalResults().mTotalStrainEnergy, 1e-6);
+		}
+
+		BOOST_REQUIRE_THROW(reusedGrammar.sd_grammar<OPTIMIZER_ASSIGNMENT>(*settings,
+			std::string(varCount+1,'4'), truss, beam, flatShell), std::invalid_argument);
+		
+		// other grammars do not use the kept rules
+		bso::structural_design::sd_model sdDefault = reusedGrammar.sd_grammar<>(*settings);
+		bso::grammar::grammar freshGrammar(cf);
+		BOOST_REQUIRE(sdDefault.getGeometries().size() ==
+			freshGrammar.sd_grammar<>(*settings).getGeometries().size());
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace grammar_test
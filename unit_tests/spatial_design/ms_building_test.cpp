@@ -3,10 +3,12 @@
 #endif
 
 #include <bso/spatial_design/ms_building.hpp>
+#include <bso/spatial_design/ms_building_reader.hpp>
 
 #include <vector>
 #include <stdexcept>
 #include <sstream>
+#include <unordered_set>
 
 #include <boost/test/included/unit_test.hpp>
 
@@ -80,6 +82,70 @@ BOOST_AUTO_TEST_SUITE( building_initialization )
 
 		BOOST_REQUIRE_THROW(b1 = ms_building("non_existent_file.txt"), std::invalid_argument);
 	}
+	
+	BOOST_AUTO_TEST_CASE( initialize_from_stream )
+	{
+		std::stringstream input, sstr, check;
+		input << "R,1,3000,3000,3000,0,0,0" << std::endl
+					<< "R,2,3000,3000,3000,3000,0,0" << std::endl;
+		check << "R,1,3000,3000,3000,0,0,0" << std::endl
+					<< "R,2,3000,3000,3000,3000,0,0";
+		
+		ms_building b1(input);
+		sstr << b1;
+		BOOST_REQUIRE(sstr.str() == check.str());
+		BOOST_REQUIRE(b1.getLastSpaceID() == 2);
+		
+		sstr.str(std::string());
+		ms_building b2(check.str()); // string holding the space definitions
+		sstr << b2;
+		BOOST_REQUIRE(sstr.str() == check.str());
+		BOOST_REQUIRE(b2.getInsertFileName() == "");
+		
+		sstr.str(std::string());
+		ms_building b3({ms_space("R,1,3000,3000,3000,0,0,0"), ms_space("R,2,3000,3000,3000,3000,0,0")});
+		sstr << b3;
+		BOOST_REQUIRE(sstr.str() == check.str());
+		BOOST_REQUIRE(b3.getLastSpaceID() == 2);
+		
+		std::stringstream invalidInput("R,a,3000,3000,3000,0,0,0\n");
+		BOOST_REQUIRE_THROW(ms_building b4(invalidInput), std::invalid_argument);
+	}
+	
+	BOOST_AUTO_TEST_CASE( read_multiple_designs )
+	{
+		std::stringstream input;
+		input << "R,1,3000,3000,3000,0,0,0" << std::endl
+					<< "R,2,3000,3000,3000,3000,0,0" << std::endl
+					<< std::endl << std::endl
+					<< "R,1,1000,2000,3000,0,0,0" << std::endl
+					<< std::endl
+					<< "R,4,1000,1000,1000,0,0,0" << std::endl
+					<< "R,7,1000,1000,1000,0,0,1000" << std::endl
+					<< "R,9,1000,1000,1000,0,0,2000" << std::endl << std::endl;
+		
+		ms_building_reader reader(input);
+		ms_building b1;
+		std::vector<unsigned int> nSpaces, lastIDs;
+		while (reader.next(b1))
+		{
+			nSpaces.push_back(b1.getSpacePtrs().size());
+			lastIDs.push_back(b1.getLastSpaceID());
+		}
+		std::vector<unsigned int> nSpacesCheck = {2,1,3}, lastIDsCheck = {2,1,9};
+		
+		BOOST_REQUIRE(reader.getDesignCount() == 3);
+		BOOST_CHECK_EQUAL_COLLECTIONS(nSpaces.begin(), nSpaces.end(), nSpacesCheck.begin(), nSpacesCheck.end());
+		BOOST_CHECK_EQUAL_COLLECTIONS(lastIDs.begin(), lastIDs.end(), lastIDsCheck.begin(), lastIDsCheck.end());
+		BOOST_REQUIRE(b1.getSpacePtrs().empty());
+		
+		ms_building b2("spatial_design/ms_test_2.txt");
+		b1 = b2; // copy assignment
+		b2.deleteSpace(b2.getSpacePtrs()[0]);
+		BOOST_REQUIRE(b1.getSpacePtrs().size() == 4);
+		
+		BOOST_REQUIRE_THROW(ms_building_reader("non_existent_file.txt"), std::invalid_argument);
+	}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -188,6 +254,49 @@ BOOST_AUTO_TEST_SUITE( building_functions )
 		BOOST_REQUIRE(b2 == b1);
 	}
 	
+	BOOST_AUTO_TEST_CASE( fingerprint_and_comparison )
+	{
+		ms_building b1("spatial_design/ms_test_2.txt");
+		ms_building b2;
+		b2.addSpace(ms_space("R,4,3000,3000,3000,3000,3000,0"));
+		b2.addSpace(ms_space("R,2,3000,3000,3000,3000,0,0"));
+		b2.addSpace(ms_space("R,3,3000,3000,3000,0,3000,0"));
+		b2.addSpace(ms_space("R,1,3000,3000,3000,0,0,0"));
+		
+		BOOST_REQUIRE(b1.getFingerprint() == b2.getFingerprint());
+		BOOST_REQUIRE(b1 == b2);
+		
+		ms_building b3 = b2;
+		b3.getSpacePtrs()[0]->setID(5); // the fingerprint excludes space IDs, comparison does not
+		BOOST_REQUIRE(b3.getFingerprint() == b2.getFingerprint());
+		BOOST_REQUIRE(b3 != b2);
+		
+		// the fingerprint is kept up to date by each modification
+		b1.sweep({3000,1500,0.0},{{0,300},{1,500},{2,1000}});
+		b1.scale({{0,1.5},{1,2}});
+		b1.splitSpace(b1.getSpacePtrs()[0]);
+		b1.snapOn({{0,100},{1,100}});
+		b1.deleteSpace(b1.getSpacePtrs()[1]);
+		b1.cutOff({0,0,2000},{0,0,1});
+		BOOST_REQUIRE(b1.getFingerprint() != b2.getFingerprint());
+		std::stringstream sstr;
+		sstr << b1;
+		ms_building b4(sstr.str());
+		BOOST_REQUIRE(b1.getFingerprint() == b4.getFingerprint());
+		BOOST_REQUIRE(b1 == b4);
+		
+		std::unordered_set<bso::utilities::fingerprint, bso::utilities::fingerprint_hash> evaluated;
+		evaluated.insert(b1.getFingerprint());
+		evaluated.insert(b2.getFingerprint());
+		evaluated.insert(b3.getFingerprint());
+		evaluated.insert(b4.getFingerprint());
+		BOOST_REQUIRE(evaluated.size() == 2);
+		
+		sc_building sc1 = b2, sc2 = b3;
+		BOOST_REQUIRE(sc1.getFingerprint() == sc2.getFingerprint());
+		BOOST_REQUIRE(sc1.getFingerprint() != sc_building(b1).getFingerprint());
+	}
+	
 	BOOST_AUTO_TEST_CASE( deleteSpace )
 	{
 		ms_building b1("spatial_design/ms_test_1.txt");
@@ -359,7 +468,46 @@ BOOST_AUTO_TEST_SUITE( building_functions )
 		ms5.addSpace(ms_space("2,1000,1000,1000,0,0,1000"));
 		BOOST_REQUIRE(!ms5.hasFloatingSpaces(floatingSpaces));
 	}
-	
+
+	BOOST_AUTO_TEST_CASE( overlapping_and_floating_spaces_in_grid )
+	{
+		// a grid of 4x4x2 touching spaces, none overlapping and none floating
+		ms_building ms1;
+		unsigned int id = 0;
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			for (unsigned int j = 0; j < 4; ++j)
+			{
+				for (unsigned int k = 0; k < 2; ++k)
+				{
+					std::stringstream line;
+					line << "R," << ++id << ",1000,1000,1000," << i*1000 << "," << j*1000 << "," << k*1000;
+					ms1.addSpace(ms_space(line.str()));
+				}
+			}
+		}
+		std::multimap<ms_space*, ms_space*> overlaps;
+		std::vector<ms_space*> floatingSpaces;
+		BOOST_REQUIRE(!ms1.hasOverlappingSpaces(overlaps));
+		BOOST_REQUIRE(!ms1.hasFloatingSpaces(floatingSpaces));
+
+		// a space that is only connected to the grid via another floating space
+		ms1.addSpace(ms_space("R,33,1000,1000,1000,5000,0,1000"));
+		ms1.addSpace(ms_space("R,34,1000,1000,1000,6000,0,1000"));
+		BOOST_REQUIRE(ms1.hasFloatingSpaces(floatingSpaces));
+		BOOST_REQUIRE(floatingSpaces.size() == 2);
+
+		// a space chaining the floating spaces to the grid
+		ms1.addSpace(ms_space("R,35,1000,1000,1000,4000,0,1000"));
+		BOOST_REQUIRE(!ms1.hasFloatingSpaces(floatingSpaces));
+		BOOST_REQUIRE(floatingSpaces.empty());
+
+		// a space that overlaps with four spaces of the grid
+		ms1.addSpace(ms_space("R,36,1000,1000,1000,500,500,0"));
+		BOOST_REQUIRE(ms1.hasOverlappingSpaces(overlaps));
+		BOOST_REQUIRE(overlaps.size() == 8);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE( ms_sc_conversion )
@@ -380,6 +528,43 @@ BOOST_AUTO_TEST_SUITE( ms_sc_conversion )
 		sc_building sc2 = sc1;
 		BOOST_REQUIRE(sc1 == sc2);
 	}
+	
+	BOOST_AUTO_TEST_CASE( ms_sc_round_trip )
+	{ // a supercube of 5x5x4 cells, so that the bitmasks span two words
+		ms_building ms1;
+		unsigned int id = 0;
+		for (unsigned int i = 0; i < 5; ++i)
+		{
+			for (unsigned int j = 0; j < 5; ++j)
+			{
+				std::stringstream line;
+				line << "R," << ++id << ",1000,1000," << 1000*(j%2+1) << "," << i*1000 << "," << j*1000 << ",0";
+				ms1.addSpace(ms_space(line.str()));
+			}
+		}
+		ms1.addSpace(ms_space("R,26,5000,5000,1000,0,0,2000"));
+		ms1.addSpace(ms_space("R,27,3000,2000,1000,1000,2000,3000"));
+		
+		sc_building sc1 = ms1;
+		BOOST_REQUIRE(sc1.getBRowSize() == 100);
+		BOOST_REQUIRE(sc1.getCellCount(0) == 1);
+		BOOST_REQUIRE(sc1.getCellCount(1) == 2);
+		BOOST_REQUIRE(sc1.getCellCount(25) == 25);
+		BOOST_REQUIRE(sc1.getCellCount(26) == 6);
+		BOOST_REQUIRE(sc1.getBValue(26,sc1.getCellIndex(1,2,3)) == 1);
+		BOOST_REQUIRE(sc1.getBValue(26,sc1.getCellIndex(4,2,3)) == 0);
+		BOOST_REQUIRE(!sc1.hasOverlappingCells());
+		
+		ms_building ms2 = sc1;
+		BOOST_REQUIRE(ms1 == ms2);
+		
+		ms1.addSpace(ms_space("R,28,1000,1000,1000,4000,4000,3000"));
+		ms1.addSpace(ms_space("R,29,1000,1000,1000,4000,4000,0"));
+		sc_building sc2 = ms1;
+		BOOST_REQUIRE(sc2.hasOverlappingCells());
+		ms_building ms3 = sc2;
+		BOOST_REQUIRE(ms1 == ms3);
+	}
 
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace spatial_design_test
\ No newline at end of file
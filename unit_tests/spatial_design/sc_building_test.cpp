@@ -152,6 +152,43 @@ BOOST_AUTO_TEST_SUITE( sc_building_initialization )
 		BOOST_REQUIRE(sc1.getBValue(4,5) == 1);
 		BOOST_REQUIRE_THROW(sc1.getBValue(5,1), std::invalid_argument);
 	}
+	
+	BOOST_AUTO_TEST_CASE( cell_counts_and_coordinates )
+	{
+		sc_building sc1("spatial_design/sc_test_3.txt");
+		BOOST_REQUIRE(sc1.getCellCount(0) == 1);
+		BOOST_REQUIRE(sc1.getCellCount(4) == 2);
+		BOOST_REQUIRE_THROW(sc1.getCellCount(5), std::invalid_argument);
+		BOOST_REQUIRE(!sc1.hasOverlappingCells());
+		BOOST_REQUIRE(sc1.getWCoordinate(0) == 0);
+		BOOST_REQUIRE(sc1.getWCoordinate(1) == 1000);
+		BOOST_REQUIRE(sc1.getDCoordinate(2) == 3000);
+		BOOST_REQUIRE(sc1.getHCoordinate(2) == 3000);
+		BOOST_REQUIRE(sc1.getHCoordinate(3) == 6000);
+		BOOST_REQUIRE_THROW(sc1.getHCoordinate(4), std::invalid_argument);
+		
+		sc_building sc2("1,2,3,2,1,1,2,1,2,3,1,1,0,0,0,0,0,1,0,0,0,0");
+		BOOST_REQUIRE(sc2.hasOverlappingCells());
+	}
+	
+	BOOST_AUTO_TEST_CASE( initialize_from_stream )
+	{
+		std::ifstream file("spatial_design/sc_test_3.txt");
+		sc_building sc1(file);
+		sc_building sc2("spatial_design/sc_test_3.txt");
+		BOOST_REQUIRE(sc1 == sc2);
+		
+		std::stringstream input;
+		input << "w,1000" << std::endl
+					<< "d,2000" << std::endl
+					<< "h,3000" << std::endl
+					<< "b,1,1" << std::endl;
+		sc_building sc3(input);
+		BOOST_REQUIRE(sc3.writeToString() == "1,1,1,1,1,2,3,1");
+		
+		std::stringstream invalidInput("w,1000\nd,2000\nh,3000\nb,1,2\n");
+		BOOST_REQUIRE_THROW(sc_building sc4(invalidInput), std::logic_error);
+	}
 
 BOOST_AUTO_TEST_SUITE_END()
 
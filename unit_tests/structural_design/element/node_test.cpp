@@ -102,6 +102,15 @@ BOOST_AUTO_TEST_SUITE( sd_node_test )
 		BOOST_REQUIRE(n.getLoads(lc1)(2) == 3.5);
 		BOOST_REQUIRE(n.getLoads(lc2)(3) == 0.5);
 		BOOST_REQUIRE_THROW(n.getLoads(lc3), std::runtime_error);
+		
+		n.addLoad(load(lc1, 1.0, 0));
+		BOOST_REQUIRE(n.getLoads(lc1)(0) == 2.5);
+		BOOST_REQUIRE(n.getLoadCases().size() == 2);
+		BOOST_REQUIRE(n.getLoadCases()[0] == lc1 && n.getLoadCases()[1] == lc2);
+		BOOST_REQUIRE(n.getLoadTable().cols() == 2);
+		BOOST_REQUIRE(n.getLoadTable()(2,0) == 3.5);
+		BOOST_REQUIRE(n.getLoadTable()(3,1) == 0.5);
+		BOOST_REQUIRE(n.getLoadTable()(0,1) == 0);
 	}
 	
 	BOOST_AUTO_TEST_CASE( add_displacements )
@@ -142,6 +151,11 @@ BOOST_AUTO_TEST_SUITE( sd_node_test )
 		BOOST_REQUIRE(n.getGlobalDOF(4) == 6);
 		BOOST_REQUIRE_THROW(n.getGlobalDOF(0), std::invalid_argument);
 		BOOST_REQUIRE_THROW(n.getGlobalDOF(7), std::runtime_error);
+		std::vector<unsigned long> check = {inactiveDOF,5,inactiveDOF,inactiveDOF,6,inactiveDOF};
+		for (unsigned int i = 0; i < 6; ++i)
+		{
+			BOOST_REQUIRE(n.getNFT()[i] == check[i]);
+		}
 	}
 
 BOOST_AUTO_TEST_SUITE_END()
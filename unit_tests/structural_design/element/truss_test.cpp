@@ -112,6 +112,8 @@ BOOST_AUTO_TEST_SUITE( sd_truss_test )
 		n1.generateNFT(DOFCount);
 		n2.generateNFT(DOFCount);
 		t1.generateEFT();
+		std::vector<unsigned long> checkEFT = {3,4,5,6,7,8};
+		BOOST_REQUIRE(t1.getEFT() == checkEFT);
 		
 		std::vector<triplet> triplets;
 		auto t1Triplets = t1.getSMTriplets();
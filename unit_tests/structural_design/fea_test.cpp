@@ -105,6 +105,17 @@ BOOST_AUTO_TEST_SUITE( sd_fea_test )
 		BOOST_REQUIRE(abs(n1->getDisplacements(lc1)(2)) < 1e-9);
 		BOOST_REQUIRE(abs(n2->getDisplacements(lc1)(0)/10-1) < 1e-9);
 		
+		Eigen::MatrixXd ae = Eigen::MatrixXd::Ones(testFEA.getDOFCount(),2);
+		Eigen::MatrixXd lambda = testFEA.solveAdjoint(ae);
+		
+		testFEA.clearResponse();
+		testFEA.solve("Supernodal");
+
+		BOOST_REQUIRE(abs(n1->getDisplacements(lc1)(1)) < 1e-9);
+		BOOST_REQUIRE(abs(n1->getDisplacements(lc1)(2)) < 1e-9);
+		BOOST_REQUIRE(abs(n2->getDisplacements(lc1)(0)/10-1) < 1e-9);
+		BOOST_REQUIRE((testFEA.solveAdjoint(ae) - lambda).norm() < 1e-9 * lambda.norm());
+		
 		testFEA.clearResponse();
 		testFEA.solve("BiCGSTAB");
 
@@ -119,9 +130,89 @@ BOOST_AUTO_TEST_SUITE( sd_fea_test )
 		BOOST_REQUIRE(abs(n1->getDisplacements(lc1)(2)) < 1e-3);
 		BOOST_REQUIRE(abs(n2->getDisplacements(lc1)(0)/10-1) < 1e-3);
 		
+		for (const std::string preconditioner : {"IncompleteCholesky", "BlockJacobi"})
+		{
+			testFEA.clearResponse();
+			pcg_settings settings;
+			settings.mPreconditioner = preconditioner;
+			testFEA.setPCGSettings(settings);
+			testFEA.solve("PCG");
+
+			BOOST_REQUIRE(abs(n1->getDisplacements(lc1)(1)) < 1e-9);
+			BOOST_REQUIRE(abs(n2->getDisplacements(lc1)(0)/10-1) < 1e-6);
+			BOOST_REQUIRE(testFEA.getSolverStatistics().at(lc1).mRelativeResidual < 1e-8);
+		}
+
+		pcg_settings settings;
+		settings.mPreconditioner = "notAPreconditioner";
+		testFEA.setPCGSettings(settings);
+		BOOST_REQUIRE_THROW(testFEA.solve("PCG"), std::invalid_argument);
+		settings.mTolerance = 0;
+		BOOST_REQUIRE_THROW(testFEA.setPCGSettings(settings), std::invalid_argument);
+		
 		testFEA.clearResponse();
 		BOOST_REQUIRE_THROW(testFEA.solve("notASolver"), std::invalid_argument);
 	}
 
+	BOOST_AUTO_TEST_CASE( supernodal_cholesky_factorisation )
+	{ // a 3D grid Laplacian with three DOFs per grid point and a diagonal shift
+		const int n = 8;
+		std::vector<Eigen::Triplet<double> > triplets;
+		auto index = [n](int i, int j, int k, int d) {return 3*(i + n*(j + n*k)) + d;};
+		for (int i = 0; i < n; ++i)
+		{
+			for (int j = 0; j < n; ++j)
+			{
+				for (int k = 0; k < n; ++k)
+				{
+					for (int d = 0; d < 3; ++d)
+					{
+						triplets.push_back({index(i,j,k,d), index(i,j,k,d), 6.1});
+						for (int e = 0; e < 3; ++e)
+						{
+							if (e != d) triplets.push_back({index(i,j,k,d), index(i,j,k,e), 0.1});
+						}
+						if (i + 1 < n) triplets.push_back({index(i,j,k,d), index(i+1,j,k,d), -1.0});
+						if (i > 0) triplets.push_back({index(i,j,k,d), index(i-1,j,k,d), -1.0});
+						if (j + 1 < n) triplets.push_back({index(i,j,k,d), index(i,j+1,k,d), -1.0});
+						if (j > 0) triplets.push_back({index(i,j,k,d), index(i,j-1,k,d), -1.0});
+						if (k + 1 < n) triplets.push_back({index(i,j,k,d), index(i,j,k+1,d), -1.0});
+						if (k > 0) triplets.push_back({index(i,j,k,d), index(i,j,k-1,d), -1.0});
+					}
+				}
+			}
+		}
+		Eigen::SparseMatrix<double> A(3*n*n*n, 3*n*n*n);
+		A.setFromTriplets(triplets.begin(), triplets.end());
+		Eigen::MatrixXd b = Eigen::MatrixXd::Random(A.rows(), 2);
+
+		Eigen::SimplicialLLT<Eigen::SparseMatrix<double> > reference(A);
+		Eigen::MatrixXd xReference = reference.solve(b);
+		for (const unsigned int threads : {1, 4})
+		{
+			supernodal_cholesky solver;
+			solver.setThreads(threads);
+			solver.compute(A);
+			BOOST_REQUIRE(solver.info() == Eigen::Success);
+			// the same ordering as Eigen's factorisation gives the same fill-in, and the
+			// DOFs of a grid point, which have the same structure, share supernodes
+			BOOST_REQUIRE(solver.nonZeros() == (unsigned long)reference.matrixL().nestedExpression().nonZeros());
+			BOOST_REQUIRE(solver.supernodes() < (unsigned long)(2*A.rows())/3);
+			Eigen::MatrixXd x = solver.solve(b);
+			BOOST_REQUIRE((x - xReference).norm() < 1e-10 * xReference.norm());
+			BOOST_REQUIRE((A*x - b).norm() < 1e-10 * b.norm());
+
+			// the symbolic analysis is reused for a matrix with the same pattern
+			Eigen::SparseMatrix<double> A2 = 2.0 * A;
+			solver.compute(A2);
+			BOOST_REQUIRE((solver.solve(b) - 0.5*xReference).norm() < 1e-10 * xReference.norm());
+		}
+
+		// a matrix that is not positive definite
+		Eigen::SparseMatrix<double> negative = -A;
+		supernodal_cholesky solver(negative);
+		BOOST_REQUIRE(solver.info() != Eigen::Success);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace structural_design_test
\ No newline at end of file
@@ -240,7 +240,576 @@ BOOST_AUTO_TEST_SUITE( sd_analysis_test )
 		}
 		BOOST_REQUIRE(abs(compliance/101.5963 - 1) < 1e-5);
 	}
+
+	BOOST_AUTO_TEST_CASE( topopt_max_iterations )
+	{
+		sd_model sd1;
+		namespace geom = bso::utilities::geometry;
+
+		component::constraint c0(0);
+		component::constraint c1(1);
+		component::constraint c2(2);
+		component::constraint c3(3);
+		component::constraint c4(4);
+
+		component::load_case lc1("vertical load");
+		component::load l1(lc1, 1,1);
+
+		component::structure str1("flat_shell",{{"E",1},{"thickness",1},{"poisson",0.3}});
+
+		auto p1 = sd1.addPoint({0,20,0});
+		auto p2 = sd1.addPoint({60,0,0});
+		p2->addConstraint(c1);
+		p1->addLoad(l1);
+
+		auto line1 = sd1.addGeometry(geom::line_segment({{0,0,0},{0,20,0}}));
+		line1->addConstraint(c0);
+
+		auto quad1 = sd1.addGeometry(geom::quadrilateral({{0,0,0},{0,20,0},{60,20,0},{60,0,0}}));
+		quad1->addStructure(str1);
+		quad1->addConstraint(c2); quad1->addConstraint(c3); quad1->addConstraint(c4);
+
+		std::stringstream out;
+		sd1.setTopOptOutputStream(out);
+		sd1.setTopOptMaxIterations(3);
+		sd1.mesh(10);
+		sd1.topologyOptimization<topology_optimization::SIMP>(0.5,1.5,3.0,0.2,1e-6);
+
+		std::string line, lastIteration;
+		while (std::getline(out, line))
+		{
+			if (!line.empty() && std::isdigit(line[0])) lastIteration = line;
+		}
+		BOOST_REQUIRE(lastIteration.substr(0,2) == "3 ");
+	}
+
 	
-	
+	BOOST_AUTO_TEST_CASE( pcg_warm_start )
+	{
+		sd_model sd1;
+		namespace geom = bso::utilities::geometry;
+
+		component::constraint c0(0);
+		component::constraint c1(1);
+		component::constraint c2(2);
+		component::constraint c3(3);
+		component::constraint c4(4);
+
+		component::load_case lc1("vertical load");
+		component::load l1(lc1, 1,1);
+
+		component::structure str1("flat_shell",{{"E",1},{"thickness",1},{"poisson",0.3}});
+
+		auto p1 = sd1.addPoint({0,20,0});
+		auto p2 = sd1.addPoint({60,0,0});
+		p2->addConstraint(c1);
+		p1->addLoad(l1);
+
+		auto line1 = sd1.addGeometry(geom::line_segment({{0,0,0},{0,20,0}}));
+		line1->addConstraint(c0);
+
+		auto quad1 = sd1.addGeometry(geom::quadrilateral({{0,0,0},{0,20,0},{60,20,0},{60,0,0}}));
+		quad1->addStructure(str1);
+		quad1->addConstraint(c2); quad1->addConstraint(c3); quad1->addConstraint(c4);
+
+		sd1.mesh(12);
+		sd1.analyze("SimplicialLDLT");
+		double compliance = sd1.getTotalResults().mTotalStrainEnergy;
+
+		for (const std::string preconditioner : {"IncompleteCholesky", "BlockJacobi", "Multigrid"})
+		{
+			pcg_settings settings;
+			settings.mPreconditioner = preconditioner;
+			settings.mTolerance = 1e-10;
+			settings.mWarmStart = false;
+			sd1.getFEA()->setPCGSettings(settings);
+			sd1.analyze("PCG");
+			BOOST_REQUIRE_CLOSE(sd1.getTotalResults().mTotalStrainEnergy, compliance, 1e-6);
+			unsigned long coldIterations = sd1.getFEA()->getSolverStatistics().begin()->second.mIterations;
+			BOOST_REQUIRE(coldIterations > 0);
+
+			// a small change of the stiffness needs fewer iterations when starting from the last solution
+			sd1.setElementDensities(0.99,1.0);
+			settings.mWarmStart = true;
+			sd1.getFEA()->setPCGSettings(settings);
+			sd1.analyze("PCG");
+			BOOST_REQUIRE(sd1.getFEA()->getSolverStatistics().begin()->second.mIterations < coldIterations);
+			sd1.setElementDensities(1.0,1.0);
+			sd1.analyze("SimplicialLDLT");
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( pcg_multigrid )
+	{
+		sd_model sd1;
+		namespace geom = bso::utilities::geometry;
+
+		component::load_case lc1("vertical load");
+		component::load l1(lc1, -1, 2);
+		component::structure str1("quad_hexahedron",{{"E",1e5},{"poisson",0.3}});
+
+		auto support = sd1.addGeometry(geom::quadrilateral({{0,0,0},{0,2,0},{0,2,2},{0,0,2}}));
+		support->addConstraint(component::constraint(0));
+		support->addConstraint(component::constraint(1));
+		support->addConstraint(component::constraint(2));
+		auto p1 = sd1.addPoint({8,2,2});
+		p1->addLoad(l1);
+
+		auto hex1 = sd1.addGeometry(geom::quad_hexahedron(
+			{{0,0,0},{4,0,0},{4,2,0},{0,2,0},{0,0,2},{4,0,2},{4,2,2},{0,2,2}}));
+		auto hex2 = sd1.addGeometry(geom::quad_hexahedron(
+			{{4,0,0},{8,0,0},{8,2,0},{4,2,0},{4,0,2},{8,0,2},{8,2,2},{4,2,2}}));
+		hex1->addStructure(str1);
+		hex2->addStructure(str1);
+
+		// the meshes at 4, 2 and 1 provide two coarse levels
+		sd1.mesh(4);
+		BOOST_REQUIRE(sd1.getFEA()->getMultigridLevels().size() == 2);
+		sd1.analyze("SimplicialLDLT");
+		double compliance = sd1.getTotalResults().mTotalStrainEnergy;
+
+		pcg_settings settings;
+		settings.mTolerance = 1e-10;
+		settings.mWarmStart = false;
+		settings.mPreconditioner = "BlockJacobi";
+		sd1.getFEA()->setPCGSettings(settings);
+		sd1.analyze("PCG");
+		unsigned long blockJacobiIterations = sd1.getFEA()->getSolverStatistics().begin()->second.mIterations;
+
+		for (const unsigned int levels : {0, 1})
+		{
+			settings.mPreconditioner = "Multigrid";
+			settings.mMultigridLevels = levels;
+			sd1.getFEA()->setPCGSettings(settings);
+			sd1.analyze("PCG");
+			BOOST_REQUIRE_CLOSE(sd1.getTotalResults().mTotalStrainEnergy, compliance, 1e-6);
+			BOOST_REQUIRE(sd1.getFEA()->getSolverStatistics().begin()->second.mIterations < blockJacobiIterations);
+		}
+
+		settings.mSmoothingSteps = 0;
+		BOOST_REQUIRE_THROW(sd1.getFEA()->setPCGSettings(settings), std::invalid_argument);
+
+		// an odd mesh size has no coarser grids
+		sd1.mesh(3);
+		BOOST_REQUIRE(sd1.getFEA()->getMultigridLevels().empty());
+		settings.mSmoothingSteps = 2;
+		sd1.getFEA()->setPCGSettings(settings);
+		BOOST_REQUIRE_THROW(sd1.analyze("PCG"), std::runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE( matrix_free )
+	{
+		sd_model sd1;
+		namespace geom = bso::utilities::geometry;
+
+		component::load_case lc1("vertical load");
+		component::load l1(lc1, -1, 2);
+		component::structure str1("quad_hexahedron",{{"E",1e5},{"poisson",0.3}});
+
+		auto support = sd1.addGeometry(geom::quadrilateral({{0,0,0},{0,2,0},{0,2,2},{0,0,2}}));
+		support->addConstraint(component::constraint(0));
+		support->addConstraint(component::constraint(1));
+		support->addConstraint(component::constraint(2));
+		auto p1 = sd1.addPoint({8,2,2});
+		p1->addLoad(l1);
+
+		auto hex1 = sd1.addGeometry(geom::quad_hexahedron(
+			{{0,0,0},{4,0,0},{4,2,0},{0,2,0},{0,0,2},{4,0,2},{4,2,2},{0,2,2}}));
+		auto hex2 = sd1.addGeometry(geom::quad_hexahedron(
+			{{4,0,0},{8,0,0},{8,2,0},{4,2,0},{4,0,2},{8,0,2},{8,2,2},{4,2,2}}));
+		hex1->addStructure(str1);
+		hex2->addStructure(str1);
+
+		std::stringstream out;
+		sd1.setTopOptOutputStream(out);
+		sd1.setTopOptMaxIterations(3);
+		sd1.setTopOptSolver("PCG");
+		pcg_settings settings;
+		settings.mPreconditioner = "BlockJacobi";
+		settings.mTolerance = 1e-10;
+
+		sd1.mesh(4);
+		sd1.analyze("SimplicialLDLT");
+		double compliance = sd1.getTotalResults().mTotalStrainEnergy;
+		sd1.getFEA()->setPCGSettings(settings);
+		sd1.topologyOptimization<topology_optimization::SIMP>(0.5,1.5,3.0,0.2,1e-6);
+		double optimizedCompliance = sd1.getTotalResults().mTotalStrainEnergy;
+
+		for (const unsigned int threads : {1, 2})
+		{
+			sd1.setMatrixFree(true, threads);
+			BOOST_REQUIRE(sd1.isStable());
+			sd1.mesh(4);
+			BOOST_REQUIRE(sd1.getFEA()->isMatrixFree());
+			// all elements of the structured grids are congruent, and each node joins at most eight elements
+			BOOST_REQUIRE(sd1.getFEA()->getEBEOperator().referenceStiffnesses() == 1);
+			BOOST_REQUIRE(sd1.getFEA()->getEBEOperator().colours() == 8);
+
+			sd1.getFEA()->setPCGSettings(settings);
+			sd1.analyze("PCG");
+			BOOST_REQUIRE_CLOSE(sd1.getTotalResults().mTotalStrainEnergy, compliance, 1e-6);
+			BOOST_REQUIRE_THROW(sd1.analyze("SimplicialLDLT"), std::runtime_error);
+
+			sd1.topologyOptimization<topology_optimization::SIMP>(0.5,1.5,3.0,0.2,1e-6);
+			BOOST_REQUIRE_CLOSE(sd1.getTotalResults().mTotalStrainEnergy, optimizedCompliance, 1e-4);
+		}
+
+		// a matrix-free system cannot be preconditioned with an incomplete factorisation
+		settings.mPreconditioner = "IncompleteCholesky";
+		sd1.getFEA()->setPCGSettings(settings);
+		BOOST_REQUIRE_THROW(sd1.analyze("PCG"), std::runtime_error);
+		sd1.setMatrixFree(false);
+		BOOST_REQUIRE(!sd1.getFEA()->isMatrixFree());
+		sd1.analyze("SimplicialLDLT");
+		BOOST_REQUIRE(sd1.getTotalResults().mTotalStrainEnergy > 0);
+	}
+
+	BOOST_AUTO_TEST_CASE( reanalysis )
+	{
+		namespace geom = bso::utilities::geometry;
+		component::load_case lc1("wind and snow");
+
+		// two walls and a roof, the roof and a third wall vary between the models
+		auto buildModel = [&lc1](const double& roofThickness, const bool& hasRoof, const bool& hasWall,
+			sd_model& sd)
+		{
+			component::structure wall("flat_shell",{{"E",3e4},{"thickness",150},{"poisson",0.3}});
+			component::structure roof("flat_shell",{{"E",3e4},{"thickness",roofThickness},{"poisson",0.3}});
+			std::vector<geom::line_segment> supports = {geom::line_segment({{0,0,0},{4000,0,0}}),
+				geom::line_segment({{4000,0,0},{4000,4000,0}})};
+			if (hasWall) supports.push_back(geom::line_segment({{0,0,0},{0,4000,0}}));
+			for (const auto& i : supports)
+			{
+				auto support = sd.addGeometry(i);
+				for (unsigned int j = 0; j < 6; ++j) support->addConstraint(component::constraint(j));
+			}
+			sd.addPoint({0,0,3000})->addLoad(component::load(lc1, 5, 1));
+			sd.addPoint({4000,4000,3000})->addLoad(component::load(lc1, -10, 2));
+
+			sd.addGeometry(geom::quadrilateral({{0,0,0},{4000,0,0},{4000,0,3000},{0,0,3000}}))->addStructure(wall);
+			sd.addGeometry(geom::quadrilateral({{4000,0,0},{4000,4000,0},{4000,4000,3000},{4000,0,3000}}))->addStructure(wall);
+			if (hasRoof)
+			{
+				sd.addGeometry(geom::quadrilateral({{0,0,3000},{4000,0,3000},{4000,4000,3000},{0,4000,3000}}))->addStructure(roof);
+			}
+			if (hasWall)
+			{
+				sd.addGeometry(geom::quadrilateral({{0,0,0},{0,4000,0},{0,4000,3000},{0,0,3000}}))->addStructure(wall);
+			}
+			sd.mesh(2);
+		};
+
+		auto reanalysis = std::make_shared<low_rank_reanalysis>();
+		struct design {double mRoofThickness; bool mHasRoof, mHasWall; unsigned long mFactorisations, mReanalyses;};
+		std::vector<design> designs = {
+			{100, true, false, 1, 0}, // the first system is factored
+			{200, true, false, 1, 1}, // only the stiffness of the roof changes
+			{200, false, false, 1, 2}, // the nodes of the roof disappear
+			{100, true, true, 2, 2}, // the nodes of the wall are new, the system is factored
+			{100, true, false, 2, 3}}; // the wall is decoupled from the reference
+		unsigned long reanalyses = 0;
+		for (const auto& i : designs)
+		{
+			sd_model sd1, check;
+			buildModel(i.mRoofThickness, i.mHasRoof, i.mHasWall, sd1);
+			buildModel(i.mRoofThickness, i.mHasRoof, i.mHasWall, check);
+			sd1.setReanalysis(reanalysis);
+			sd1.analyze("Reanalysis");
+			check.analyze("SimplicialLDLT");
+			BOOST_REQUIRE(reanalysis->factorisations() == i.mFactorisations);
+			BOOST_REQUIRE(reanalysis->reanalyses() == i.mReanalyses);
+			BOOST_REQUIRE(sd1.getFEA()->getReanalysisRank() <= reanalysis->getMaxRank());
+			BOOST_REQUIRE((sd1.getFEA()->getReanalysisRank() > 0) == (i.mReanalyses > reanalyses));
+			reanalyses = i.mReanalyses;
+			BOOST_REQUIRE_CLOSE(sd1.getTotalResults().mTotalStrainEnergy,
+				check.getTotalResults().mTotalStrainEnergy, 1e-6);
+			BOOST_REQUIRE(sd1.getFEA()->getDisplacements(lc1).isApprox(check.getFEA()->getDisplacements(lc1), 1e-8));
+
+			Eigen::MatrixXd ae = Eigen::MatrixXd::Random(sd1.getFEA()->getDOFCount(), 2);
+			BOOST_REQUIRE(sd1.getFEA()->solveAdjoint(ae).isApprox(check.getFEA()->solveAdjoint(ae), 1e-8));
+		}
+
+		// without low rank updates every system is factored
+		reanalysis->setMaxRank(0);
+		sd_model sd1;
+		buildModel(200, true, false, sd1);
+		sd1.setReanalysis(reanalysis);
+		sd1.analyze("Reanalysis");
+		BOOST_REQUIRE(reanalysis->factorisations() == 3);
+		BOOST_REQUIRE(sd1.getFEA()->getReanalysisRank() == 0);
+	}
+
+	BOOST_AUTO_TEST_CASE( condensed_analysis )
+	{
+		namespace geom = bso::utilities::geometry;
+		component::load_case lc1("wind"), lc2("snow");
+
+		// two walls and a roof, one of the loads is on an interior node of the roof
+		auto buildModel = [&lc1, &lc2](sd_model& sd)
+		{
+			component::structure shell("flat_shell",{{"E",3e4},{"thickness",150},{"poisson",0.3}});
+			component::structure beam("beam",{{"E",3e4},{"width",200},{"height",300},{"poisson",0.3}});
+			for (const auto& i : {geom::line_segment({{0,0,0},{4000,0,0}}),
+				geom::line_segment({{4000,0,0},{4000,4000,0}})})
+			{
+				auto support = sd.addGeometry(i);
+				for (unsigned int j = 0; j < 6; ++j) support->addConstraint(component::constraint(j));
+			}
+			sd.addPoint({0,0,3000})->addLoad(component::load(lc1, 5, 1));
+			sd.addPoint({2000,2000,3000})->addLoad(component::load(lc2, -10, 2));
+
+			sd.addGeometry(geom::quadrilateral({{0,0,0},{4000,0,0},{4000,0,3000},{0,0,3000}}))->addStructure(shell);
+			sd.addGeometry(geom::quadrilateral({{4000,0,0},{4000,4000,0},{4000,4000,3000},{4000,0,3000}}))->addStructure(shell);
+			sd.addGeometry(geom::quadrilateral({{0,0,3000},{4000,0,3000},{4000,4000,3000},{0,4000,3000}}))->addStructure(shell);
+			sd.addGeometry(geom::line_segment({{0,4000,3000},{4000,4000,3000}}))->addStructure(beam);
+		};
+
+		sd_model check;
+		buildModel(check);
+		check.mesh(6);
+		check.analyze("SimplicialLDLT");
+
+		for (const std::string solver : {"SimplicialLLT", "SimplicialLDLT", "Supernodal"})
+		{
+			for (const unsigned int threads : {1, 2})
+			{
+				sd_model sd1;
+				buildModel(sd1);
+				sd1.setStaticCondensation(true, threads);
+				sd1.mesh(6);
+				sd1.analyze(solver);
+
+				// the 25 interior nodes of each quadrilateral are condensed, and so are the 5 nodes on the free
+				// edge of each (the beam shares its nodes with the roof)
+				const static_condensation& condensation = sd1.getFEA()->getStaticCondensation();
+				BOOST_REQUIRE(condensation.condensedComponents() == 3);
+				BOOST_REQUIRE(sd1.getFEA()->getDOFCount() - condensation.reducedDOFCount() == 3*(25+5)*6);
+
+				BOOST_REQUIRE_CLOSE(sd1.getTotalResults().mTotalStrainEnergy,
+					check.getTotalResults().mTotalStrainEnergy, 1e-6);
+				for (const auto& lc : {lc1, lc2})
+				{
+					BOOST_REQUIRE(sd1.getFEA()->getDisplacements(lc).isApprox(check.getFEA()->getDisplacements(lc), 1e-8));
+				}
+			}
+		}
+
+		sd_model sd1;
+		buildModel(sd1);
+		sd1.mesh(6);
+		sd1.setStaticCondensation(true);
+		BOOST_REQUIRE_THROW(sd1.analyze("PCG"), std::runtime_error);
+		sd1.analyze("SimplicialLDLT");
+		Eigen::MatrixXd ae = Eigen::MatrixXd::Ones(sd1.getFEA()->getDOFCount(), 1);
+		BOOST_REQUIRE_THROW(sd1.getFEA()->solveAdjoint(ae), std::runtime_error);
+		sd1.setStaticCondensation(false);
+		sd1.analyze("SimplicialLDLT");
+		BOOST_REQUIRE(sd1.getFEA()->getStaticCondensation().isEmpty());
+		BOOST_REQUIRE_CLOSE(sd1.getTotalResults().mTotalStrainEnergy,
+			check.getTotalResults().mTotalStrainEnergy, 1e-6);
+	}
+
+	BOOST_AUTO_TEST_CASE( response_buffer )
+	{
+		namespace geom = bso::utilities::geometry;
+		component::load_case lc1("wind"), lc2("snow");
+		component::structure shell("flat_shell",{{"E",3e4},{"thickness",150},{"poisson",0.3}});
+		component::structure beam("beam",{{"E",3e4},{"width",200},{"height",300},{"poisson",0.3}});
+
+		sd_model sd1;
+		auto support = sd1.addGeometry(geom::line_segment({{0,0,0},{4000,0,0}}));
+		for (unsigned int j = 0; j < 6; ++j) support->addConstraint(component::constraint(j));
+		sd1.addPoint({0,0,3000})->addLoad(component::load(lc1, 5, 1));
+		sd1.addPoint({4000,0,3000})->addLoad(component::load(lc2, -10, 2));
+		sd1.addGeometry(geom::quadrilateral({{0,0,0},{4000,0,0},{4000,0,3000},{0,0,3000}}))->addStructure(shell);
+		sd1.addGeometry(geom::line_segment({{0,0,3000},{4000,0,3000}}))->addStructure(beam);
+		sd1.mesh(4);
+		sd1.analyze("SimplicialLDLT");
+		for (auto& i : sd1.getFEA()->getElements()) i->updateDensity(0.5, 3);
+		sd1.getFEA()->generateGSM();
+		sd1.getFEA()->solve("SimplicialLDLT");
+
+		const fea& FEA = *sd1.getFEA();
+		const element::response_buffer& responses = FEA.getResponses();
+		BOOST_REQUIRE(responses.mLoadCases.size() == 2);
+		BOOST_REQUIRE(responses.mEnergies.rows() == (long)FEA.getElements().size());
+		BOOST_REQUIRE(responses.mDisplacements.rows() == (long)FEA.getDOFCount());
+
+		// the energies of the sweep equal those of each element's own stiffness matrix
+		for (const auto& i : FEA.getElements())
+		{
+			double totalEnergy = 0;
+			for (const auto& lc : {lc1, lc2})
+			{
+				Eigen::VectorXd u = i->getDisplacements(lc);
+				double energy = 0.5 * i->getStiffnessFactor() * u.dot(i->getOriginalSM() * u);
+				BOOST_REQUIRE_SMALL(i->getEnergy(lc) - energy, 1e-9 * (1 + std::abs(energy)));
+				totalEnergy += energy;
+				if (i->isFlatShell())
+				{
+					double bendingEnergy = 0.5 * u.dot(*i->getSeparatedSMs()[2] * u);
+					BOOST_REQUIRE_SMALL(i->getEnergy(lc, "bending") - bendingEnergy, 1e-9 * (1 + std::abs(bendingEnergy)));
+				}
+			}
+			BOOST_REQUIRE_SMALL(i->getTotalEnergy() - totalEnergy, 1e-9 * (1 + std::abs(totalEnergy)));
+		}
+		for (const auto& i : FEA.getNodes())
+		{
+			for (unsigned int j = 0; j < 6; ++j)
+			{
+				if (i->getNFT()[j] == element::inactiveDOF) continue;
+				BOOST_REQUIRE(i->getDisplacements(lc2)(j) == FEA.getDisplacements(lc2)(i->getNFT()[j]));
+			}
+		}
+
+		// an element that computes its own response reads the displacements of its nodes
+		element::element* e = sd1.getFEA()->getElements().front();
+		double energy = e->getEnergy(lc1);
+		e->clearResponse();
+		e->computeResponse(lc1);
+		BOOST_REQUIRE_CLOSE(e->getEnergy(lc1), energy, 1e-9);
+		BOOST_REQUIRE_THROW(e->getEnergy(lc2), std::runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE( partial_results )
+	{
+		namespace geom = bso::utilities::geometry;
+		component::load_case lc("wind");
+		component::structure shell("flat_shell",{{"E",3e4},{"thickness",150},{"poisson",0.3}});
+		component::structure beam("beam",{{"E",3e4},{"width",200},{"height",300},{"poisson",0.3}});
+
+		sd_model sd1;
+		auto support = sd1.addGeometry(geom::line_segment({{0,0,0},{4000,0,0}}));
+		for (unsigned int j = 0; j < 6; ++j) support->addConstraint(component::constraint(j));
+		sd1.addPoint({0,3000,3000})->addLoad(component::load(lc, 5, 0));
+		sd1.addPoint({4000,3000,3000})->addLoad(component::load(lc, -10, 2));
+		auto wallComponent = sd1.addGeometry(geom::quadrilateral({{0,0,0},{4000,0,0},{4000,0,3000},{0,0,3000}}));
+		wallComponent->addStructure(shell);
+		auto wall = dynamic_cast<geom::polygon*>(wallComponent);
+		sd1.addGeometry(geom::quadrilateral({{0,0,3000},{4000,0,3000},{4000,3000,3000},{0,3000,3000}}))->addStructure(shell);
+		sd1.addGeometry(geom::line_segment({{0,3000,3000},{4000,3000,3000}}))->addStructure(beam);
+		sd1.mesh(4);
+		sd1.analyze("SimplicialLDLT");
+
+		// the results of the elements of which all nodes are inside the geometry
+		auto bruteForce = [&sd1](const auto& g)
+		{
+			sd_results results;
+			for (const auto& i : sd1.getFEA()->getElements())
+			{
+				bool allPointsInsideOrOn = true;
+				for (const auto& j : i->getNodes()) allPointsInsideOrOn &= g.isInsideOrOn(*j);
+				if (!allPointsInsideOrOn) continue;
+				results.mTotalStrainEnergy += i->getTotalEnergy();
+				results.mTotalStructuralVolume += i->getVolume();
+			}
+			return results;
+		};
+
+		geom::quadrilateral part({{1000,0,0},{4000,0,0},{4000,0,2000},{1000,0,2000}});
+		geom::quad_hexahedron roof({{4000,3000,3100},{0,3000,3100},{0,-100,3100},{0,3000,2900},
+			{0,-100,2900},{4000,-100,3100},{4000,-100,2900},{4000,3000,2900}});
+		for (unsigned int i = 0; i < 2; ++i)
+		{ // the second queries are answered from the index and the cached elements of the wall
+			sd_results result = sd1.getPartialResults(&part), expected = bruteForce(part);
+			BOOST_REQUIRE(expected.mTotalStructuralVolume > 0);
+			BOOST_REQUIRE(result.mTotalStrainEnergy == expected.mTotalStrainEnergy);
+			BOOST_REQUIRE(result.mTotalStructuralVolume == expected.mTotalStructuralVolume);
+
+			result = sd1.getPartialResults(wall);
+			expected = bruteForce(*wall);
+			BOOST_REQUIRE_CLOSE(expected.mTotalStructuralVolume, 4000.0 * 3000 * 150, 1e-9);
+			BOOST_REQUIRE(result.mTotalStrainEnergy == expected.mTotalStrainEnergy);
+			BOOST_REQUIRE(result.mTotalStructuralVolume == expected.mTotalStructuralVolume);
+
+			result = sd1.getPartialResults(&roof);
+			expected = bruteForce(roof);
+			BOOST_REQUIRE(expected.mTotalStructuralVolume > 4000.0 * 3000 * 150);
+			BOOST_REQUIRE(result.mTotalStrainEnergy == expected.mTotalStrainEnergy);
+			BOOST_REQUIRE(result.mTotalStructuralVolume == expected.mTotalStructuralVolume);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE( stability )
+	{
+		namespace geom = bso::utilities::geometry;
+		component::load_case lc("wind");
+		component::structure beam("beam",{{"E",3e4},{"width",200},{"height",300},{"poisson",0.3}});
+		component::structure truss("truss",{{"E",3e4},{"A",1e4}});
+
+		sd_model sd1;
+		auto support = sd1.addPoint({0,0,0});
+		sd1.addPoint({1000,0,0})->addLoad(component::load(lc, -10, 2));
+		sd1.addGeometry(geom::line_segment({{0,0,0},{1000,0,0}}))->addStructure(beam);
+		BOOST_REQUIRE(!sd1.isStable());
+		for (unsigned int j = 0; j < 6; ++j) support->addConstraint(component::constraint(j));
+		BOOST_REQUIRE(sd1.isStable());
+
+		// the stability check leaves the mesh of the model intact
+		sd1.mesh(4);
+		sd1.analyze("SimplicialLDLT");
+		double compliance = sd1.getTotalResults().mTotalStrainEnergy;
+		BOOST_REQUIRE(sd1.isStable());
+		BOOST_REQUIRE(sd1.getFEA()->getElements().size() == 4);
+		BOOST_REQUIRE(sd1.getTotalResults().mTotalStrainEnergy == compliance);
+
+		// a truss that is hinged to the tip of the cantilever is a mechanism
+		sd_model sd2 = sd1;
+		BOOST_REQUIRE(sd2.isStable());
+		sd2.addGeometry(geom::line_segment({{1000,0,0},{1000,1000,0}}))->addStructure(truss);
+		BOOST_REQUIRE(!sd2.isStable());
+		BOOST_REQUIRE(sd1.isStable());
+	}
+
+	BOOST_AUTO_TEST_CASE( topopt_SIMP_PCG )
+	{
+		sd_model sd1;
+		namespace geom = bso::utilities::geometry;
+
+		component::constraint c0(0);
+		component::constraint c1(1);
+		component::constraint c2(2);
+		component::constraint c3(3);
+		component::constraint c4(4);
+
+		component::load_case lc1("vertical load");
+		component::load l1(lc1, 1,1);
+
+		component::structure str1("flat_shell",{{"E",1},{"thickness",1},{"poisson",0.3}});
+
+		auto p1 = sd1.addPoint({0,20,0});
+		auto p2 = sd1.addPoint({60,0,0});
+		p2->addConstraint(c1);
+		p1->addLoad(l1);
+
+		auto line1 = sd1.addGeometry(geom::line_segment({{0,0,0},{0,20,0}}));
+		line1->addConstraint(c0);
+
+		auto quad1 = sd1.addGeometry(geom::quadrilateral({{0,0,0},{0,20,0},{20,20,0},{20,0,0}}));
+		auto quad2 = sd1.addGeometry(geom::quadrilateral({{20,0,0},{20,20,0},{40,20,0},{40,0,0}}));
+		auto quad3 = sd1.addGeometry(geom::quadrilateral({{40,0,0},{40,20,0},{60,20,0},{60,0,0}}));
+
+		quad1->addStructure(str1);
+		quad2->addStructure(str1);
+		quad3->addStructure(str1);
+		quad1->addConstraint(c2); quad1->addConstraint(c3); quad1->addConstraint(c4);
+		quad2->addConstraint(c2); quad2->addConstraint(c3); quad2->addConstraint(c4);
+		quad3->addConstraint(c2); quad3->addConstraint(c3); quad3->addConstraint(c4);
+
+		sd1.mesh(20);
+		pcg_settings settings;
+		settings.mTolerance = 1e-10;
+		sd1.getFEA()->setPCGSettings(settings);
+		sd1.setTopOptSolver("PCG");
+		sd1.topologyOptimization<topology_optimization::SIMP>(0.5,1.5,3.0,0.2,1e-2);
+
+		double compliance = 0;
+		for (const auto& i : sd1.getFEA()->getElements())
+		{
+			compliance += i->getTotalEnergy();
+		}
+		BOOST_REQUIRE(abs(compliance/101.5963 - 1) < 1e-4);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace structural_design_test
\ No newline at end of file
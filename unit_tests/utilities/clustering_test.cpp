@@ -128,5 +128,46 @@ BOOST_AUTO_TEST_SUITE( clustering_tests )
 		}
 	}
 
+	BOOST_AUTO_TEST_CASE( thread_count_independence )
+	{ // the result only depends on the seed, and each cluster is a fixed point of k-means
+		std::vector<data_point> data;
+		std::mt19937 RNGEngine(5);
+		std::normal_distribution<double> noise(0.0, 0.6);
+		for (unsigned int i = 0; i < 300; ++i)
+		{
+			double center = (i%5)*2.0;
+			data.push_back({center + noise(RNGEngine), center*center/4 + noise(RNGEngine),
+				noise(RNGEngine)});
+		}
+
+		clustering c1(11, data, 2, 8, 20, 1);
+		clustering c2(11, data, 2, 8, 20, 4);
+		BOOST_REQUIRE(c1.getClusters().size() == c2.getClusters().size());
+		for (unsigned int i = 0; i < c1.getClusters().size(); ++i)
+		{
+			BOOST_REQUIRE(c1.getClusters()[i].getCentroid() == c2.getClusters()[i].getCentroid());
+			const auto& data1 = c1.getClusters()[i].getData();
+			const auto& data2 = c2.getClusters()[i].getData();
+			BOOST_REQUIRE(data1.size() == data2.size());
+			for (unsigned int j = 0; j < data1.size(); ++j) BOOST_REQUIRE(*data1[j] == *data2[j]);
+		}
+
+		unsigned long count = 0;
+		for (const auto& i : c1.getClusters())
+		{
+			BOOST_REQUIRE(i.calculateMean().isApproximately(i.getCentroid(),1e-9));
+			for (const auto& j : i.getData())
+			{
+				for (const auto& k : c1.getClusters())
+				{
+					BOOST_REQUIRE(i.calculateDistanceToCentroid(*j) <=
+						k.calculateDistanceToCentroid(*j) + 1e-9);
+				}
+			}
+			count += i.getData().size();
+		}
+		BOOST_REQUIRE(count == data.size());
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace utilities_test
\ No newline at end of file
@@ -7,4 +7,7 @@
 #include <unit_tests/utilities/data_point_test.cpp>
 #include <unit_tests/utilities/cluster_test.cpp>
 #include <unit_tests/utilities/clustering_test.cpp>
-#include <unit_tests/utilities/non_dominated_search_test.cpp>
\ No newline at end of file
+#include <unit_tests/utilities/non_dominated_search_test.cpp>
+#include <unit_tests/utilities/evaluation_cache_test.cpp>
+#include <unit_tests/utilities/thread_pool_test.cpp>
+#include <unit_tests/utilities/instrumentation_test.cpp>
\ No newline at end of file
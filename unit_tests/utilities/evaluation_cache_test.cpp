@@ -0,0 +1,135 @@
+#ifndef BOOST_TEST_MODULE
+#define BOOST_TEST_MODULE evaluation_cache_test
+#endif
+
+#include <bso/utilities/evaluation_cache.hpp>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+/*
+BOOST_TEST()
+BOOST_REQUIRE_THROW(function, std::domain_error)
+BOOST_REQUIRE(!s[8].dominates(s[9]) && !s[9].dominates(s[8]))
+BOOST_CHECK_EQUAL_COLLECTIONS(a.begin(), a.end(), b.begin(), b.end());
+*/
+
+namespace utilities_test {
+using namespace bso::utilities;
+
+struct test_results
+{
+	double mValue = 0.0;
+	double mVolume = 0.0;
+};
+
+BOOST_AUTO_TEST_SUITE( evaluation_cache_test )
+
+	BOOST_AUTO_TEST_CASE( least_recently_used )
+	{
+		evaluation_cache<test_results> cache(2);
+		test_results r;
+		r.mValue = 1.0;
+		cache.insert(fingerprint(1,1), r);
+		r.mValue = 2.0;
+		cache.insert(fingerprint(2,2), r);
+		
+		BOOST_REQUIRE(cache.find(fingerprint(1,1), r)); // 1 becomes most recently used
+		BOOST_REQUIRE(r.mValue == 1.0);
+		r.mValue = 3.0;
+		cache.insert(fingerprint(3,3), r); // evicts 2
+		
+		BOOST_REQUIRE(cache.size() == 2);
+		BOOST_REQUIRE(!cache.find(fingerprint(2,2), r));
+		BOOST_REQUIRE(cache.find(fingerprint(3,3), r));
+		BOOST_REQUIRE(r.mValue == 3.0);
+		BOOST_REQUIRE(cache.getHits() == 2);
+		BOOST_REQUIRE(cache.getMisses() == 1);
+		BOOST_REQUIRE_THROW(evaluation_cache<test_results> c(0), std::invalid_argument);
+	}
+	
+	BOOST_AUTO_TEST_CASE( append_only_store )
+	{
+		std::string fileName = "utilities/evaluation_cache_test_store";
+		std::remove(fileName.c_str());
+		{
+			evaluation_cache<test_results> cache(1, fileName);
+			test_results r;
+			for (unsigned int i = 0; i < 5; ++i)
+			{
+				r.mValue = i;
+				cache.insert(fingerprint(i,0), r);
+			}
+			BOOST_REQUIRE(cache.size() == 1);
+			BOOST_REQUIRE(cache.storeSize() == 5);
+			BOOST_REQUIRE(cache.find(fingerprint(2,0), r)); // read back from the store
+			BOOST_REQUIRE(r.mValue == 2.0);
+		}
+		{ // simulate an interrupted write
+			std::ofstream out(fileName.c_str(), std::ios::binary | std::ios::app);
+			out.write("partial", 7);
+		}
+		{
+			evaluation_cache<test_results> cache(10, fileName);
+			BOOST_REQUIRE(cache.storeSize() == 5);
+			test_results r;
+			r.mValue = 5.0;
+			cache.insert(fingerprint(5,0), r);
+		}
+		evaluation_cache<test_results> cache(10, fileName);
+		BOOST_REQUIRE(cache.storeSize() == 6);
+		test_results r;
+		BOOST_REQUIRE(cache.find(fingerprint(4,0), r));
+		BOOST_REQUIRE(r.mValue == 4.0);
+		BOOST_REQUIRE(cache.find(fingerprint(5,0), r));
+		BOOST_REQUIRE(r.mValue == 5.0);
+		BOOST_REQUIRE_THROW(evaluation_cache<double> c(10, fileName), std::invalid_argument);
+		std::remove(fileName.c_str());
+	}
+	
+	BOOST_AUTO_TEST_CASE( concurrent_evaluation )
+	{
+		evaluation_cache<test_results> cache(100);
+		std::atomic<bool> correct(true);
+		std::vector<std::thread> threads;
+		for (unsigned int t = 0; t < 4; ++t)
+		{
+			threads.emplace_back([&cache, &correct]()
+			{
+				for (unsigned int i = 0; i < 1000; ++i)
+				{
+					test_results r = cache.evaluate(fingerprint(i%50,0), [i]()
+					{
+						test_results r;
+						r.mValue = i%50;
+						return r;
+					});
+					if (r.mValue != i%50) correct = false;
+				}
+			});
+		}
+		for (auto& i : threads) i.join();
+		BOOST_REQUIRE(correct);
+		BOOST_REQUIRE(cache.getHits() + cache.getMisses() == 4000);
+		BOOST_REQUIRE(cache.getMisses() >= 50);
+		BOOST_REQUIRE(cache.size() == 50);
+	}
+	
+	BOOST_AUTO_TEST_CASE( file_fingerprints )
+	{
+		fingerprint f1 = fingerprint_files({"utilities/evaluation_cache_test.cpp"});
+		fingerprint f2 = fingerprint_files({"utilities/evaluation_cache_test.cpp"});
+		fingerprint f3 = fingerprint_files({"utilities/clustering_test.cpp"});
+		BOOST_REQUIRE(f1 == f2);
+		BOOST_REQUIRE(f1 != f3);
+		BOOST_REQUIRE_THROW(fingerprint_files({"non_existent_file.txt"}), std::invalid_argument);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace utilities_test
@@ -0,0 +1,72 @@
+#ifndef BOOST_TEST_MODULE
+#define BOOST_TEST_MODULE instrumentation_test
+#endif
+
+#include <bso/utilities/instrumentation.hpp>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/*
+BOOST_TEST()
+BOOST_REQUIRE_THROW(function, std::domain_error)
+BOOST_REQUIRE(!s[8].dominates(s[9]) && !s[9].dominates(s[8]))
+BOOST_CHECK_EQUAL_COLLECTIONS(a.begin(), a.end(), b.begin(), b.end());
+*/
+
+namespace utilities_test {
+using namespace bso::utilities;
+
+BOOST_AUTO_TEST_SUITE( instrumentation_test )
+
+	BOOST_AUTO_TEST_CASE( timers_and_counters )
+	{
+		instrumentation::reset();
+		double start = wall_time();
+		{
+			instrumentation::scoped_timer timer("test_timer");
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+		BOOST_REQUIRE(wall_time() - start >= 0.02);
+
+		std::thread other([](){
+			instrumentation::add_time("test_timer", 1.0);
+			instrumentation::count("test_counter", 3);
+		});
+		other.join();
+		instrumentation::count("test_counter");
+
+		std::stringstream csv;
+		instrumentation::write_csv(csv);
+		std::string line, totalTimer, totalCounter;
+		unsigned int threadRows = 0;
+		std::getline(csv, line);
+		BOOST_REQUIRE(line == "thread,type,name,count,total,min,max");
+		while (std::getline(csv, line))
+		{
+			if (line.find("total,timer,test_timer,") == 0) totalTimer = line;
+			else if (line.find("total,counter,test_counter,") == 0) totalCounter = line;
+			else if (line.find(",timer,test_timer,") != std::string::npos) ++threadRows;
+		}
+		BOOST_REQUIRE(threadRows == 2); // aggregated per thread
+		BOOST_REQUIRE(totalCounter == "total,counter,test_counter,2,4,1,3");
+		BOOST_REQUIRE(totalTimer.find("total,timer,test_timer,2,") == 0);
+
+		std::stringstream json;
+		instrumentation::write_json(json);
+		BOOST_REQUIRE(json.str().find("\"test_counter\": {\"count\": 2, \"total\": 4, \"min\": 1, \"max\": 3}")
+			!= std::string::npos);
+
+		instrumentation::reset();
+		std::stringstream empty;
+		instrumentation::write_csv(empty);
+		BOOST_REQUIRE(empty.str().find("test_") == std::string::npos);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace utilities_test
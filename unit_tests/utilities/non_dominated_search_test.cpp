@@ -6,6 +6,8 @@
 
 #include <boost/test/included/unit_test.hpp>
 
+#include <random>
+
 /*
 BOOST_TEST()
 BOOST_REQUIRE_THROW(function, std::domain_error)
@@ -59,5 +61,75 @@ BOOST_AUTO_TEST_SUITE( non_dominated_search_test )
 		BOOST_REQUIRE(allPFAPointsFound);
 	}
 
+	BOOST_AUTO_TEST_CASE( non_dominated_sort_fronts )
+	{
+		std::vector<data_point> data;
+		data.push_back({1.5,0.8} ); data.push_back({1.6,1.6} );
+		data.push_back({1.3,1.5} ); data.push_back({2,2}     );
+		data.push_back({0.4,2}   ); data.push_back({1.75,1}  );
+		data.push_back({1.25,1}  ); data.push_back({1.9,1.4} );
+		data.push_back({1,2}     ); data.push_back({2,0.5}   );
+		data.push_back({1,1}     ); data.push_back({0.75,1.6});
+		data.push_back({0.5,1.5} ); data.push_back({1,1}     );
+		objective_matrix objectives = toObjectiveMatrix(data);
+
+		auto fronts = non_dominated_sort(objectives);
+		std::vector<std::vector<unsigned long> > expectedFronts =
+			{{4,12,10,13,0,9},{11,6},{8,2,5},{1,7},{3}};
+		BOOST_REQUIRE(fronts == expectedFronts);
+		BOOST_REQUIRE(non_dominated_front(objectives) == expectedFronts.front());
+
+		Eigen::VectorXd distance = crowding_distance(objectives, fronts[2]);
+		BOOST_REQUIRE(std::isinf(distance(0)) && std::isinf(distance(2)));
+		BOOST_REQUIRE_CLOSE(distance(1), 0.75/0.75 + 1.0/1.0, 1e-9);
+		BOOST_REQUIRE(std::isinf(crowding_distance(objectives, fronts[1])(0)));
+
+		data.push_back({1,1,1});
+		BOOST_REQUIRE_THROW(toObjectiveMatrix(data), std::invalid_argument);
+	}
+
+	BOOST_AUTO_TEST_CASE( non_dominated_sort_random )
+	{ // compare to pairwise comparison of all points, with few distinct values so that there are ties
+		std::mt19937 rng(3);
+		std::uniform_int_distribution<int> dist(0,9);
+		for (unsigned int d = 1; d < 5; ++d)
+		{
+			objective_matrix objectives(300, d);
+			for (unsigned int i = 0; i < objectives.rows(); ++i)
+			{
+				for (unsigned int j = 0; j < d; ++j) objectives(i,j) = dist(rng);
+			}
+
+			std::vector<unsigned int> rank(objectives.rows(), 0);
+			auto fronts = non_dominated_sort(objectives);
+			unsigned long count = 0;
+			for (unsigned int i = 0; i < fronts.size(); ++i)
+			{
+				for (const auto& j : fronts[i]) rank[j] = i;
+				count += fronts[i].size();
+			}
+			BOOST_REQUIRE(count == (unsigned long)objectives.rows());
+
+			for (unsigned int i = 0; i < objectives.rows(); ++i)
+			{
+				data_point pI(Eigen::VectorXd(objectives.row(i).transpose()));
+				bool dominatedByPreviousFront = (rank[i] == 0);
+				for (unsigned int j = 0; j < objectives.rows(); ++j)
+				{
+					data_point pJ(Eigen::VectorXd(objectives.row(j).transpose()));
+					if (pJ.dominates(pI))
+					{
+						BOOST_REQUIRE(rank[j] < rank[i]);
+						if (rank[j] + 1 == rank[i]) dominatedByPreviousFront = true;
+					}
+				}
+				BOOST_REQUIRE(dominatedByPreviousFront);
+			}
+
+			std::vector<unsigned long> front = non_dominated_front(objectives);
+			BOOST_REQUIRE(front == fronts.front());
+		}
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace utilities_test
\ No newline at end of file
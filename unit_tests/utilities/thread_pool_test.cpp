@@ -0,0 +1,97 @@
+#ifndef BOOST_TEST_MODULE
+#define BOOST_TEST_MODULE thread_pool_test
+#endif
+
+#include <bso/utilities/thread_pool.hpp>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+/*
+BOOST_TEST()
+BOOST_REQUIRE_THROW(function, std::domain_error)
+BOOST_REQUIRE(!s[8].dominates(s[9]) && !s[9].dominates(s[8]))
+BOOST_CHECK_EQUAL_COLLECTIONS(a.begin(), a.end(), b.begin(), b.end());
+*/
+
+namespace utilities_test {
+using namespace bso::utilities;
+
+BOOST_AUTO_TEST_SUITE( thread_pool_test )
+
+	BOOST_AUTO_TEST_CASE( submit_tasks )
+	{
+		thread_pool pool(4);
+		BOOST_REQUIRE(pool.size() == 4);
+		BOOST_REQUIRE(pool.getCapacity() == 8);
+
+		std::vector<std::future<unsigned int> > results;
+		for (unsigned int i = 0; i < 100; ++i)
+		{ // the shared queue holds 8 tasks, submit blocks until there is space
+			results.push_back(pool.submit([i](){return i*i;}));
+		}
+		for (unsigned int i = 0; i < 100; ++i)
+		{
+			BOOST_REQUIRE(results[i].get() == i*i);
+		}
+
+		auto failing = pool.submit([]() -> int {throw std::runtime_error("failed");});
+		BOOST_REQUIRE_THROW(failing.get(), std::runtime_error);
+	}
+
+	BOOST_AUTO_TEST_CASE( nested_tasks )
+	{ // every worker waits for tasks that it spawned itself, which must not deadlock
+		thread_pool pool(2, 1);
+		std::atomic<unsigned int> count(0);
+		std::vector<std::future<unsigned int> > results;
+		for (unsigned int i = 0; i < 10; ++i)
+		{
+			results.push_back(pool.submit([&pool, &count]()
+			{
+				std::vector<std::future<unsigned int> > subResults;
+				for (unsigned int j = 0; j < 10; ++j)
+				{
+					subResults.push_back(pool.submit([&count, j]()
+					{
+						++count;
+						return j;
+					}));
+				}
+				unsigned int sum = 0;
+				for (auto& j : subResults)
+				{
+					pool.wait(j);
+					sum += j.get();
+				}
+				return sum;
+			}));
+		}
+		for (auto& i : results) BOOST_REQUIRE(i.get() == 45);
+		BOOST_REQUIRE(count == 100);
+	}
+
+	BOOST_AUTO_TEST_CASE( finish_on_destruction )
+	{
+		std::atomic<unsigned int> count(0);
+		{
+			thread_pool pool(3);
+			for (unsigned int i = 0; i < 20; ++i)
+			{
+				pool.submit([&count]()
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					++count;
+				});
+			}
+		}
+		BOOST_REQUIRE(count == 20);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace utilities_test